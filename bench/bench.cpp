@@ -0,0 +1,96 @@
+
+#include "benchCommon.h"
+
+#include <stdio.h>
+#include <string.h>
+
+using namespace Frontier;
+using namespace std;
+
+struct BenchSuite
+{
+    const char* name;
+    void (*run)(BenchApp* app, BenchReporter* reporter);
+};
+
+static BenchSuite g_suites[] =
+{
+    {"style", benchStyleEngine},
+    {"layout", benchLayout},
+    {"draw", benchDraw},
+    {"events", benchEvents},
+    {"list", benchList},
+    {"window", benchWindow},
+    {NULL, NULL}
+};
+
+static void usage(const char* argv0)
+{
+    fprintf(stderr, "Usage: %s [--json <file>] [suite...]\n", argv0);
+    fprintf(stderr, "Suites:");
+    BenchSuite* suite;
+    for (suite = g_suites; suite->name != NULL; suite++)
+    {
+        fprintf(stderr, " %s", suite->name);
+    }
+    fprintf(stderr, "\n");
+}
+
+int main(int argc, char** argv)
+{
+    string jsonPath = "";
+    vector<string> selected;
+
+    int i;
+    for (i = 1; i < argc; i++)
+    {
+        if (!strcmp(argv[i], "--json") && i + 1 < argc)
+        {
+            jsonPath = argv[++i];
+        }
+        else if (argv[i][0] == '-')
+        {
+            usage(argv[0]);
+            return 1;
+        }
+        else
+        {
+            selected.push_back(argv[i]);
+        }
+    }
+
+    BenchApp* app = new BenchApp();
+    if (!app->init())
+    {
+        fprintf(stderr, "Failed to initialise app\n");
+        return 1;
+    }
+
+    BenchReporter reporter;
+
+    BenchSuite* suite;
+    for (suite = g_suites; suite->name != NULL; suite++)
+    {
+        bool run = selected.empty();
+        for (const string& name : selected)
+        {
+            if (name == suite->name)
+            {
+                run = true;
+            }
+        }
+
+        if (run)
+        {
+            suite->run(app, &reporter);
+        }
+    }
+
+    if (!jsonPath.empty() && !reporter.writeJSON(jsonPath))
+    {
+        fprintf(stderr, "Failed to write results to %s\n", jsonPath.c_str());
+        return 1;
+    }
+
+    return 0;
+}
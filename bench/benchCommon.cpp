@@ -0,0 +1,87 @@
+
+#include "benchCommon.h"
+
+#include <stdio.h>
+#include <time.h>
+
+using namespace std;
+using namespace Frontier;
+
+BenchApp::BenchApp() : FrontierApp(L"Bench App")
+{
+    m_offscreenEngine = new OffscreenEngine(this);
+    setEngine(m_offscreenEngine);
+}
+
+BenchApp::~BenchApp()
+{
+}
+
+BenchReporter::BenchReporter()
+{
+    printf("%-36s %-36s %12s %14s\n", "benchmark", "params", "operations", "ns/op");
+}
+
+void BenchReporter::add(string name, BenchParams params, uint64_t operations, uint64_t elapsed)
+{
+    BenchResult result;
+    result.name = name;
+    result.params = params;
+    result.operations = operations;
+    result.elapsed = elapsed;
+    m_results.push_back(result);
+
+    string paramStr;
+    for (auto param : params)
+    {
+        if (!paramStr.empty())
+        {
+            paramStr += " ";
+        }
+        paramStr += param.first + "=" + to_string(param.second);
+    }
+
+    printf(
+        "%-36s %-36s %12llu %14.1f\n",
+        name.c_str(),
+        paramStr.c_str(),
+        (unsigned long long)operations,
+        result.nsPerOp());
+    fflush(stdout);
+}
+
+bool BenchReporter::writeJSON(string path)
+{
+    FILE* fp = fopen(path.c_str(), "w");
+    if (fp == NULL)
+    {
+        return false;
+    }
+
+    fprintf(fp, "{\n");
+    fprintf(fp, "  \"timestamp\": %llu,\n", (unsigned long long)time(NULL));
+    fprintf(fp, "  \"benchmarks\": [\n");
+    unsigned int i;
+    for (i = 0; i < m_results.size(); i++)
+    {
+        const BenchResult& result = m_results.at(i);
+        fprintf(fp, "    {\"name\": \"%s\", \"params\": {", result.name.c_str());
+        unsigned int p;
+        for (p = 0; p < result.params.size(); p++)
+        {
+            fprintf(fp, "%s\"%s\": %ld", (p > 0) ? ", " : "", result.params[p].first.c_str(), result.params[p].second);
+        }
+        fprintf(
+            fp,
+            "}, \"operations\": %llu, \"elapsed_ns\": %llu, \"ns_per_op\": %.1f}%s\n",
+            (unsigned long long)result.operations,
+            (unsigned long long)result.elapsed,
+            result.nsPerOp(),
+            (i + 1 < m_results.size()) ? "," : "");
+    }
+    fprintf(fp, "  ]\n");
+    fprintf(fp, "}\n");
+
+    fclose(fp);
+    return true;
+}
@@ -0,0 +1,82 @@
+#ifndef __FRONTIER_BENCH_BENCH_COMMON_H_
+#define __FRONTIER_BENCH_BENCH_COMMON_H_
+
+#include <frontier/frontier.h>
+#include <frontier/engines/offscreen.h>
+
+#include <chrono>
+#include <string>
+#include <utility>
+#include <vector>
+
+class BenchApp : public Frontier::FrontierApp
+{
+ private:
+    Frontier::OffscreenEngine* m_offscreenEngine;
+
+ public:
+    BenchApp();
+    virtual ~BenchApp();
+
+    Frontier::OffscreenEngine* getOffscreenEngine() { return m_offscreenEngine; }
+};
+
+/**
+ * \brief Simple wall clock timer for benchmarks
+ */
+class BenchTimer
+{
+ private:
+    std::chrono::steady_clock::time_point m_start;
+
+ public:
+    BenchTimer() { start(); }
+
+    void start() { m_start = std::chrono::steady_clock::now(); }
+
+    /// Return the nanoseconds elapsed since start() was called
+    uint64_t elapsed() const
+    {
+        auto diff = std::chrono::steady_clock::now() - m_start;
+        return std::chrono::duration_cast<std::chrono::nanoseconds>(diff).count();
+    }
+};
+
+typedef std::vector<std::pair<std::string, long>> BenchParams;
+
+struct BenchResult
+{
+    std::string name;
+    BenchParams params;
+    uint64_t operations;
+    uint64_t elapsed;
+
+    double nsPerOp() const { return (double)elapsed / (double)operations; }
+};
+
+/**
+ * \brief Collects benchmark results, printing them as they arrive
+ */
+class BenchReporter
+{
+ private:
+    std::vector<BenchResult> m_results;
+
+ public:
+    BenchReporter();
+
+    /// Record that operations operations took elapsed nanoseconds
+    void add(std::string name, BenchParams params, uint64_t operations, uint64_t elapsed);
+
+    /// Write all of the results as JSON
+    bool writeJSON(std::string path);
+};
+
+void benchStyleEngine(BenchApp* app, BenchReporter* reporter);
+void benchLayout(BenchApp* app, BenchReporter* reporter);
+void benchDraw(BenchApp* app, BenchReporter* reporter);
+void benchEvents(BenchApp* app, BenchReporter* reporter);
+void benchList(BenchApp* app, BenchReporter* reporter);
+void benchWindow(BenchApp* app, BenchReporter* reporter);
+
+#endif
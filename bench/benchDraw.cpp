@@ -0,0 +1,128 @@
+
+#include "benchCommon.h"
+
+#include <frontier/widgets/label.h>
+#include <frontier/widgets/textinput.h>
+#include <frontier/widgets/terminal.h>
+
+#include <stdio.h>
+#include <string.h>
+
+using namespace Frontier;
+using namespace Geek::Gfx;
+using namespace std;
+
+#define BENCH_ITERATIONS 1000
+
+static void prepare(Widget* widget, Size size)
+{
+    widget->measure();
+    widget->setSize(size);
+    widget->layout();
+}
+
+static void benchLabel(BenchApp* app, BenchReporter* reporter)
+{
+    Label* label = new Label(app, L"The quick brown fox jumps over the lazy dog");
+    prepare(label, Size(400, 30));
+    Surface* surface = new Surface(400, 30, 4);
+
+    BenchTimer timer;
+    int i;
+    for (i = 0; i < BENCH_ITERATIONS; i++)
+    {
+        label->setDirty(DIRTY_CONTENT);
+        label->draw(surface);
+    }
+    reporter->add("Label::draw", {{"chars", 43}}, BENCH_ITERATIONS, timer.elapsed());
+
+    // Changing text, like a counter
+    timer.start();
+    for (i = 0; i < BENCH_ITERATIONS; i++)
+    {
+        label->setText(L"Value: " + to_wstring(i));
+        label->measure();
+        label->draw(surface);
+    }
+    reporter->add("Label::setText+draw", {}, BENCH_ITERATIONS, timer.elapsed());
+
+    delete surface;
+}
+
+static void benchTextInput(BenchApp* app, BenchReporter* reporter)
+{
+    TextInput* textInput = new TextInput(app, L"The quick brown fox jumps over the lazy dog");
+    prepare(textInput, Size(400, 30));
+    Surface* surface = new Surface(400, 30, 4);
+
+    BenchTimer timer;
+    int i;
+    for (i = 0; i < BENCH_ITERATIONS; i++)
+    {
+        textInput->setDirty(DIRTY_CONTENT);
+        textInput->draw(surface);
+    }
+    reporter->add("TextInput::draw", {{"chars", 43}}, BENCH_ITERATIONS, timer.elapsed());
+
+    delete surface;
+}
+
+static void benchTerminal(BenchApp* app, BenchReporter* reporter)
+{
+    Terminal* terminal = new Terminal(app);
+    prepare(terminal, Size(640, 480));
+    Surface* surface = new Surface(640, 480, 4);
+
+    char line[128];
+    int i;
+    for (i = 0; i < 1000; i++)
+    {
+        snprintf(line, sizeof(line), "%06d: The quick brown fox jumps over the lazy dog\r\n", i);
+        terminal->receiveChars(line, strlen(line));
+    }
+    terminal->draw(surface);
+    terminal->clearDirty();
+
+    int iterations = BENCH_ITERATIONS / 10;
+
+    BenchTimer timer;
+    for (i = 0; i < iterations; i++)
+    {
+        terminal->setDirty(DIRTY_SIZE | DIRTY_CONTENT);
+        terminal->draw(surface);
+        terminal->clearDirty();
+    }
+    reporter->add("Terminal::draw full", {{"width", 640}, {"height", 480}}, iterations, timer.elapsed());
+
+    // New output arriving, which scrolls the whole screen
+    timer.start();
+    for (i = 0; i < iterations; i++)
+    {
+        snprintf(line, sizeof(line), "%06d: The quick brown fox jumps over the lazy dog\r\n", i);
+        terminal->receiveChars(line, strlen(line));
+        terminal->draw(surface);
+        terminal->clearDirty();
+    }
+    reporter->add("Terminal::draw output", {{"width", 640}, {"height", 480}}, iterations, timer.elapsed());
+
+    // Typing on the current line
+    timer.start();
+    for (i = 0; i < iterations; i++)
+    {
+        char c = 'a' + (i % 26);
+        terminal->receiveChars(&c, 1);
+        terminal->draw(surface);
+        terminal->clearDirty();
+    }
+    reporter->add("Terminal::draw typing", {{"width", 640}, {"height", 480}}, iterations, timer.elapsed());
+
+    delete surface;
+}
+
+void benchDraw(BenchApp* app, BenchReporter* reporter)
+{
+    benchLabel(app, reporter);
+    benchTextInput(app, reporter);
+    benchTerminal(app, reporter);
+    app->gc();
+}
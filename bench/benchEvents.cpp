@@ -0,0 +1,71 @@
+
+#include "benchCommon.h"
+
+#include <frontier/widgets/button.h>
+#include <frontier/widgets/grid.h>
+
+using namespace Frontier;
+using namespace std;
+
+#define BENCH_EVENTS 10000
+
+static void benchMotion(BenchApp* app, BenchReporter* reporter, int columns, int rows)
+{
+    FrontierWindow* window = new FrontierWindow(app, L"Bench", WINDOW_NORMAL);
+    Grid* grid = new Grid(app);
+    int x;
+    int y;
+    for (y = 0; y < rows; y++)
+    {
+        for (x = 0; x < columns; x++)
+        {
+            grid->put(x, y, new Button(app, L"Button"));
+        }
+    }
+    window->setContent(grid);
+    window->show();
+
+    Size size = window->getSize();
+
+    // A storm of motion events sweeping across the window
+    BenchTimer timer;
+    int i;
+    for (i = 0; i < BENCH_EVENTS; i++)
+    {
+        MouseMotionEvent motionEvent;
+        motionEvent.eventType = FRONTIER_EVENT_MOUSE_MOTION;
+        motionEvent.window = window;
+        motionEvent.x = (i * 7) % size.width;
+        motionEvent.y = ((i * 7) / size.width * 11) % size.height;
+        window->handleEvent(&motionEvent);
+    }
+    reporter->add(
+        "FrontierWindow::handleEvent motion",
+        {{"widgets", columns * rows}},
+        BENCH_EVENTS,
+        timer.elapsed());
+
+    // The same, but queued and delivered by the engine
+    OffscreenEngine* engine = app->getOffscreenEngine();
+    timer.start();
+    for (i = 0; i < BENCH_EVENTS; i++)
+    {
+        engine->injectMouseMotion(window, (i * 7) % size.width, ((i * 7) / size.width * 11) % size.height);
+    }
+    engine->checkEvents();
+    reporter->add(
+        "OffscreenEngine motion storm",
+        {{"widgets", columns * rows}},
+        BENCH_EVENTS,
+        timer.elapsed());
+
+    window->hide();
+    window->decRefCount();
+}
+
+void benchEvents(BenchApp* app, BenchReporter* reporter)
+{
+    benchMotion(app, reporter, 10, 10);
+    benchMotion(app, reporter, 20, 50);
+    app->gc();
+}
@@ -0,0 +1,138 @@
+
+#include "benchCommon.h"
+
+#include <frontier/widgets/frame.h>
+#include <frontier/widgets/grid.h>
+
+using namespace Frontier;
+using namespace std;
+
+#define BENCH_ITERATIONS 20
+
+class BenchLeaf : public Widget
+{
+ public:
+    explicit BenchLeaf(FrontierApp* app) : Widget(app, L"BenchLeaf") {}
+
+    void calculateSize() override
+    {
+        m_minSize.set(10, 10);
+        m_maxSize.set(WIDGET_SIZE_UNLIMITED, 20);
+    }
+};
+
+/*
+ * Build a tree of Frames, each with fanout children, with widgetCount leaves
+ */
+static Widget* buildFrameTree(FrontierApp* app, int widgetCount, int fanout, vector<Widget*>& leaves)
+{
+    if (widgetCount <= fanout)
+    {
+        Frame* frame = new Frame(app, false);
+        int i;
+        for (i = 0; i < widgetCount; i++)
+        {
+            BenchLeaf* leaf = new BenchLeaf(app);
+            frame->add(leaf);
+            leaves.push_back(leaf);
+        }
+        return frame;
+    }
+
+    Frame* frame = new Frame(app, (widgetCount / fanout) % 2);
+    int i;
+    for (i = 0; i < fanout; i++)
+    {
+        frame->add(buildFrameTree(app, widgetCount / fanout, fanout, leaves));
+    }
+    return frame;
+}
+
+static void layoutTree(Widget* root)
+{
+    root->measure();
+    root->setSize(root->getMinSize());
+    root->layout();
+    root->clearDirty();
+}
+
+static void benchFrameLayout(BenchApp* app, BenchReporter* reporter, int widgetCount)
+{
+    vector<Widget*> leaves;
+    Widget* root = buildFrameTree(app, widgetCount, 10, leaves);
+    layoutTree(root);
+
+    // Everything has changed
+    BenchTimer timer;
+    int iteration;
+    for (iteration = 0; iteration < BENCH_ITERATIONS; iteration++)
+    {
+        root->setDirty(DIRTY_SIZE | DIRTY_STYLE, true);
+        layoutTree(root);
+    }
+    reporter->add("Frame::layout full", {{"widgets", widgetCount}}, BENCH_ITERATIONS, timer.elapsed());
+
+    // A single leaf has changed
+    timer.start();
+    for (iteration = 0; iteration < BENCH_ITERATIONS; iteration++)
+    {
+        leaves.at((iteration * 7919) % leaves.size())->setDirty(DIRTY_SIZE);
+        layoutTree(root);
+    }
+    reporter->add("Frame::layout single", {{"widgets", widgetCount}}, BENCH_ITERATIONS, timer.elapsed());
+}
+
+static void benchGridLayout(BenchApp* app, BenchReporter* reporter, int widgetCount)
+{
+    int columns = 10;
+    int rows = widgetCount / columns;
+
+    Grid* grid = new Grid(app);
+    vector<Widget*> leaves;
+    int x;
+    int y;
+    for (y = 0; y < rows; y++)
+    {
+        for (x = 0; x < columns; x++)
+        {
+            BenchLeaf* leaf = new BenchLeaf(app);
+            grid->put(x, y, leaf);
+            leaves.push_back(leaf);
+        }
+    }
+    layoutTree(grid);
+
+    BenchTimer timer;
+    int iteration;
+    for (iteration = 0; iteration < BENCH_ITERATIONS; iteration++)
+    {
+        grid->setDirty(DIRTY_SIZE | DIRTY_STYLE, true);
+        layoutTree(grid);
+    }
+    reporter->add("Grid::layout full", {{"widgets", widgetCount}}, BENCH_ITERATIONS, timer.elapsed());
+
+    timer.start();
+    for (iteration = 0; iteration < BENCH_ITERATIONS; iteration++)
+    {
+        leaves.at((iteration * 7919) % leaves.size())->setDirty(DIRTY_SIZE);
+        layoutTree(grid);
+    }
+    reporter->add("Grid::layout single", {{"widgets", widgetCount}}, BENCH_ITERATIONS, timer.elapsed());
+}
+
+void benchLayout(BenchApp* app, BenchReporter* reporter)
+{
+    int frameCounts[] = {100, 1000, 10000};
+    for (int widgetCount : frameCounts)
+    {
+        benchFrameLayout(app, reporter, widgetCount);
+    }
+
+    // Grid looks up each cell by position, so keep these smaller
+    int gridCounts[] = {100, 1000, 4000};
+    for (int widgetCount : gridCounts)
+    {
+        benchGridLayout(app, reporter, widgetCount);
+    }
+    app->gc();
+}
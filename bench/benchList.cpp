@@ -0,0 +1,97 @@
+
+#include "benchCommon.h"
+
+#include <frontier/widgets/list.h>
+#include <frontier/widgets/scroller.h>
+
+using namespace Frontier;
+using namespace Geek::Gfx;
+using namespace std;
+
+#define BENCH_SCROLL_STEPS 200
+#define BENCH_ROW_HEIGHT 20
+
+class BenchListModel : public ListModel
+{
+ private:
+    unsigned int m_rowCount;
+
+ public:
+    explicit BenchListModel(unsigned int rowCount) : m_rowCount(rowCount) {}
+
+    unsigned int getRowCount() override { return m_rowCount; }
+    int getFixedRowHeight() override { return BENCH_ROW_HEIGHT; }
+
+    ListItem* createItem(List* list) override
+    {
+        return new TextListItem(list->getApp(), L"");
+    }
+
+    void bindItem(ListItem* item, unsigned int row) override
+    {
+        ((TextListItem*)item)->setText(L"Row " + to_wstring(row));
+    }
+};
+
+static void benchVirtualList(BenchApp* app, BenchReporter* reporter, unsigned int rowCount)
+{
+    Size size(300, 600);
+    Surface* surface = new Surface(size.width, size.height, 4);
+
+    BenchListModel* model = new BenchListModel(rowCount);
+    List* list = new List(app);
+    Scroller* scroller = new Scroller(app, list);
+
+    // Setting the model and showing the first page
+    BenchTimer timer;
+    list->setModel(model);
+    scroller->measure();
+    scroller->setSize(size);
+    scroller->layout();
+    scroller->draw(surface);
+    scroller->clearDirty();
+    reporter->add("List::setModel+draw", {{"rows", rowCount}}, 1, timer.elapsed());
+
+    // Scrolling a row at a time
+    timer.start();
+    int i;
+    for (i = 0; i < BENCH_SCROLL_STEPS; i++)
+    {
+        scroller->setPos((i + 1) * BENCH_ROW_HEIGHT);
+        if (scroller->needsLayout())
+        {
+            scroller->layout();
+        }
+        scroller->draw(surface);
+        scroller->clearDirty();
+    }
+    reporter->add("List scroll row", {{"rows", rowCount}}, BENCH_SCROLL_STEPS, timer.elapsed());
+
+    // Jumping around the whole list
+    timer.start();
+    for (i = 0; i < BENCH_SCROLL_STEPS; i++)
+    {
+        scroller->setPos((int)(((uint64_t)i * 7919 * BENCH_ROW_HEIGHT) % ((uint64_t)rowCount * BENCH_ROW_HEIGHT)));
+        if (scroller->needsLayout())
+        {
+            scroller->layout();
+        }
+        scroller->draw(surface);
+        scroller->clearDirty();
+    }
+    reporter->add("List scroll jump", {{"rows", rowCount}}, BENCH_SCROLL_STEPS, timer.elapsed());
+
+    list->setModel(NULL);
+    delete model;
+    delete surface;
+}
+
+void benchList(BenchApp* app, BenchReporter* reporter)
+{
+    unsigned int rowCounts[] = {10000, 100000, 1000000};
+    for (unsigned int rowCount : rowCounts)
+    {
+        benchVirtualList(app, reporter, rowCount);
+    }
+    app->gc();
+}
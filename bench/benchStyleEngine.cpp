@@ -0,0 +1,98 @@
+
+#include "benchCommon.h"
+
+#include <frontier/styles.h>
+#include <frontier/widgets.h>
+
+#include <stdio.h>
+
+using namespace Frontier;
+using namespace std;
+
+#define BENCH_TYPES 20
+#define BENCH_CLASSES 200
+#define BENCH_WIDGETS 1000
+#define BENCH_ITERATIONS 10
+
+/*
+ * Generate a style sheet with a realistic mix of type, class, id and
+ * descendant/state rules
+ */
+static string generateCSS(int ruleCount)
+{
+    string css;
+    int i;
+    for (i = 0; i < ruleCount; i++)
+    {
+        char buf[256];
+        switch (i % 4)
+        {
+            case 0:
+                snprintf(buf, sizeof(buf), "Type%d { margin-top: 1px; }\n", i % BENCH_TYPES);
+                break;
+            case 1:
+                snprintf(buf, sizeof(buf), ".class%d { margin-left: 2px; }\n", i % BENCH_CLASSES);
+                break;
+            case 2:
+                snprintf(buf, sizeof(buf), "#id%d { margin-right: 3px; }\n", i);
+                break;
+            default:
+                snprintf(buf, sizeof(buf), ".class%d Type%d:hover { margin-bottom: 4px; }\n", i % BENCH_CLASSES, i % BENCH_TYPES);
+                break;
+        }
+        css += buf;
+    }
+    return css;
+}
+
+void benchStyleEngine(BenchApp* app, BenchReporter* reporter)
+{
+    int ruleCounts[] = {10, 100, 1000, 10000};
+
+    Widget* root = new Widget(app, L"Frame");
+    root->setWidgetClass(L"root");
+
+    vector<Widget*> widgets;
+    int i;
+    for (i = 0; i < BENCH_WIDGETS; i++)
+    {
+        wchar_t buf[64];
+        swprintf(buf, 64, L"Type%d", i % BENCH_TYPES);
+        Widget* widget = new Widget(app, buf);
+
+        swprintf(buf, 64, L"class%d", i % BENCH_CLASSES);
+        widget->setWidgetClass(buf);
+        if (i % 10 == 0)
+        {
+            swprintf(buf, 64, L"id%d", i);
+            widget->setWidgetId(buf);
+        }
+        widget->setParent(root);
+        widgets.push_back(widget);
+    }
+
+    for (int ruleCount : ruleCounts)
+    {
+        StyleEngine* styleEngine = new StyleEngine();
+        styleEngine->parseString(generateCSS(ruleCount));
+
+        BenchTimer timer;
+        int iteration;
+        for (iteration = 0; iteration < BENCH_ITERATIONS; iteration++)
+        {
+            for (Widget* widget : widgets)
+            {
+                styleEngine->getProperties(widget);
+            }
+        }
+        uint64_t elapsed = timer.elapsed();
+
+        reporter->add(
+            "StyleEngine::getProperties",
+            {{"rules", (long)styleEngine->getRuleCount()}, {"widgets", BENCH_WIDGETS}},
+            BENCH_WIDGETS * BENCH_ITERATIONS,
+            elapsed);
+
+        delete styleEngine;
+    }
+}
@@ -0,0 +1,84 @@
+
+#include "benchCommon.h"
+
+#include <frontier/widgets/label.h>
+#include <frontier/widgets/grid.h>
+
+using namespace Frontier;
+using namespace std;
+
+#define BENCH_ITERATIONS 100
+
+static void benchUpdate(BenchApp* app, BenchReporter* reporter, int columns, int rows)
+{
+    FrontierWindow* window = new FrontierWindow(app, L"Bench", WINDOW_NORMAL);
+    Grid* grid = new Grid(app);
+    vector<Label*> labels;
+    int x;
+    int y;
+    for (y = 0; y < rows; y++)
+    {
+        for (x = 0; x < columns; x++)
+        {
+            Label* label = new Label(app, L"0000");
+            grid->put(x, y, label);
+            labels.push_back(label);
+        }
+    }
+    window->setContent(grid);
+    window->show();
+
+    OffscreenWindow* ow = app->getOffscreenEngine()->getWindow(window);
+    int widgets = columns * rows;
+
+    // Redraw and present everything
+    BenchTimer timer;
+    int i;
+    for (i = 0; i < BENCH_ITERATIONS; i++)
+    {
+        grid->setDirty(DIRTY_CONTENT, true);
+        window->update();
+    }
+    reporter->add("FrontierWindow::update full", {{"widgets", widgets}}, BENCH_ITERATIONS, timer.elapsed());
+
+    // One widget changing
+    timer.start();
+    for (i = 0; i < BENCH_ITERATIONS; i++)
+    {
+        labels.at((i * 7919) % labels.size())->setDirty(DIRTY_CONTENT);
+        window->update();
+    }
+    reporter->add("FrontierWindow::update single", {{"widgets", widgets}}, BENCH_ITERATIONS, timer.elapsed());
+
+    // One label's text changing, like a counter
+    timer.start();
+    for (i = 0; i < BENCH_ITERATIONS; i++)
+    {
+        labels.at((i * 7919) % labels.size())->setText(to_wstring(1000 + i));
+        window->update();
+    }
+    reporter->add("FrontierWindow::update setText", {{"widgets", widgets}}, BENCH_ITERATIONS, timer.elapsed());
+
+    // Nothing changed
+    timer.start();
+    for (i = 0; i < BENCH_ITERATIONS; i++)
+    {
+        window->update();
+    }
+    reporter->add("FrontierWindow::update idle", {{"widgets", widgets}}, BENCH_ITERATIONS, timer.elapsed());
+
+    if (ow != NULL)
+    {
+        ow->saveFrame("frontier_bench_window.png");
+    }
+
+    window->hide();
+    window->decRefCount();
+}
+
+void benchWindow(BenchApp* app, BenchReporter* reporter)
+{
+    benchUpdate(app, reporter, 10, 10);
+    benchUpdate(app, reporter, 20, 50);
+    app->gc();
+}
@@ -23,11 +23,13 @@
 
 #include <vector>
 #include <set>
+#include <atomic>
 
 #include <geek/gfx-surface.h>
 #include <geek/gfx-colour.h>
 #include <geek/core-logger.h>
 #include <geek/core-timers.h>
+#include <geek/core-thread.h>
 #include <geek/fonts.h>
 
 #include <frontier/object.h>
@@ -36,9 +38,17 @@
 #include <frontier/styles.h>
 #include <frontier/theme.h>
 #include <frontier/menu.h>
+#include <frontier/rendercache.h>
+#include <frontier/textcache.h>
+#include <frontier/profiler.h>
+#include <frontier/framescheduler.h>
+#include <frontier/taskqueue.h>
+#include <frontier/async.h>
 
 #include <sigc++/sigc++.h>
 
+#include <type_traits>
+
 namespace Frontier
 {
 class FrontierEngine;
@@ -75,6 +85,13 @@ class FrontierApp : public Geek::Logger
     std::wstring m_name;
     FrontierEngine* m_engine;
 
+    /// Objects that have no references, deleted by the next gc()
+    std::vector<FrontierObject*> m_releaseQueue;
+    Geek::Mutex* m_releaseMutex;
+    unsigned int m_objectCount;
+
+    /// Every registered object, only kept when tracking to report leaks
+    bool m_trackObjects;
     std::set<FrontierObject*> m_objects;
 
     Geek::FontManager* m_fontManager;
@@ -82,6 +99,16 @@ class FrontierApp : public Geek::Logger
     StyleEngine* m_styleEngine;
     Geek::Core::TimerManager* m_timerManager;
     WidgetBuilder* m_widgetBuilder;
+    RenderCache* m_renderCache;
+    TextCache* m_textCache;
+    Profiler* m_profiler;
+    FrameScheduler* m_frameScheduler;
+    TaskQueue* m_taskQueue;
+    WorkerPool* m_workerPool;
+    /// Set while the app is being destroyed, so async() work that hasn't started is skipped
+    std::atomic<bool> m_shuttingDown;
+    bool m_parallelDraw;
+    bool m_displayListsEnabled;
 
     Menu* m_appMenu;
     ContextMenu* m_contextMenuWindow;
@@ -89,6 +116,12 @@ class FrontierApp : public Geek::Logger
     std::vector<FrontierWindow*> m_windows;
     FrontierWindow* m_activeWindow;
 
+    /// Depth of nested event batches, Windows are only updated once this returns to zero
+    unsigned int m_eventBatchDepth;
+
+    /// Incremented whenever a Widget is moved, resized or reparented. Widgets may be drawn on worker threads
+    std::atomic<uint64_t> m_layoutGeneration;
+
     sigc::signal<void, FrontierWindow*> m_activeWindowChangedSignal;
 
  protected:
@@ -108,11 +141,28 @@ class FrontierApp : public Geek::Logger
     /// Register object with the Apps garbage collection
     void registerObject(FrontierObject* object);
 
-    /// Perform garbage collection
+    /// Queue an object that has no references to be deleted. Called by FrontierObject
+    void releaseObject(FrontierObject* object);
+
+    /// Delete all objects that have been released and still have no references
     void gc();
 
-    /// Return the number of objects that this application is currently tracking
-    unsigned int getObjectCount() { return m_objects.size(); }
+    /// Return the number of registered objects that have not been deleted
+    unsigned int getObjectCount() { return m_objectCount; }
+
+    /**
+     * \brief Keep a list of all registered objects, to report leaks on exit
+     *
+     * Only objects registered after this is enabled are listed. Can also be
+     * enabled by setting FRONTIER_TRACK_OBJECTS.
+     */
+    void setObjectTracking(bool track) { m_trackObjects = track; }
+
+    /// Return a counter that changes whenever any Widget's bounds may have changed
+    uint64_t getLayoutGeneration() const { return m_layoutGeneration; }
+
+    /// Invalidate cached Widget positions and hit indexes. Called by Widget
+    void layoutChanged() { m_layoutGeneration++; }
 
     /// Get the current back end engine
     FrontierEngine* getEngine() { return m_engine; }
@@ -131,6 +181,65 @@ class FrontierApp : public Geek::Logger
 
     WidgetBuilder* getWidgetBuilder() { return m_widgetBuilder; }
 
+    /// Return the cache of rendered Widget Surfaces
+    RenderCache* getRenderCache() { return m_renderCache; }
+
+    /// Return the cache of rendered glyphs and text widths
+    TextCache* getTextCache() { return m_textCache; }
+
+    /// Return the Profiler used to time the phases of each frame
+    Profiler* getProfiler() { return m_profiler; }
+
+    /// Return the FrameScheduler that decides when Windows are updated
+    FrameScheduler* getFrameScheduler() { return m_frameScheduler; }
+
+    /**
+     * \brief Run a Task on the UI thread
+     *
+     * May be called from any thread without blocking. Tasks are run in the
+     * order they were posted, by the Engine's next iteration and before any
+     * Windows are updated.
+     */
+    void post(Task task);
+
+    /// Post several Tasks at once. They will be run together, with a single update
+    void post(std::vector<Task>& tasks);
+
+    /// Run all Tasks that have been posted. Called by the Engine on the UI thread
+    unsigned int runTasks() { return m_taskQueue->run(); }
+
+    /// Return the pool of threads used by async()
+    WorkerPool* getWorkerPool() { return m_workerPool; }
+
+    /**
+     * \brief Draw the dirty children of containers on the worker threads
+     *
+     * Off by default, or on if FRONTIER_PARALLEL_DRAW is set. Widgets
+     * that use FreeType directly from draw() must hold the
+     * TextCache::getFontMutex() lock while they do.
+     */
+    void setParallelDraw(bool parallelDraw) { m_parallelDraw = parallelDraw; }
+    bool isParallelDraw() const { return m_parallelDraw; }
+
+    /**
+     * \brief Record what render cached Widgets draw, and only rasterize it when it changes
+     *
+     * Off by default, or on if FRONTIER_DISPLAY_LISTS is set.
+     */
+    void setDisplayListsEnabled(bool enabled) { m_displayListsEnabled = enabled; }
+    bool isDisplayListsEnabled() const { return m_displayListsEnabled; }
+
+    /**
+     * \brief Run work on a worker thread, then pass its result to done on the UI thread
+     *
+     * The owner, usually the Widget that wants the result, has a reference
+     * held until done has been called. If nothing else references it by
+     * then, it is going away and done is skipped, as it is if the returned
+     * handle is cancelled.
+     */
+    template <typename Work, typename Done>
+    AsyncHandle async(FrontierObject* owner, Work work, Done done);
+
     /// Get the current ContextMenu
     ContextMenu* getContextMenuWindow();
 
@@ -167,6 +276,17 @@ class FrontierApp : public Geek::Logger
     /// Cause all Windows to be updated and redrawn
     void update();
 
+    /**
+     * \brief Start delivering a batch of events
+     *
+     * Events handled outside of a batch produce their frames straight away.
+     * Within a batch, frames are left to the FrameScheduler, which the
+     * engine runs once the batch has been handled.
+     */
+    void beginEventBatch();
+    void endEventBatch();
+    bool isInEventBatch() const { return m_eventBatchDepth > 0; }
+
     /// Handle an event from a user
     virtual void handleEvent(Frontier::Event* event);
 
@@ -194,6 +314,72 @@ class FrontierApp : public Geek::Logger
     virtual sigc::signal<void, FrontierWindow*> activeWindowChangedSignal() { return m_activeWindowChangedSignal; }
 };
 
+template <typename Work, typename Done>
+AsyncHandle FrontierApp::async(FrontierObject* owner, Work work, Done done)
+{
+    AsyncHandle handle;
+    if (m_shuttingDown)
+    {
+        // There's nothing left to run it
+        handle.cancel();
+        return handle;
+    }
+
+    if (owner != NULL)
+    {
+        owner->incRefCount();
+    }
+
+    // Whether the result is still wanted, checked on the UI thread
+    auto wanted = [this, owner, handle]()
+    {
+        return !m_shuttingDown && !handle.isCancelled() && (owner == NULL || owner->getRefCount() > 1);
+    };
+    auto finished = [owner]()
+    {
+        if (owner != NULL)
+        {
+            owner->decRefCount();
+        }
+    };
+
+    m_workerPool->run([this, handle, work, done, wanted, finished]() mutable
+    {
+        if (handle.isCancelled() || m_shuttingDown)
+        {
+            post(finished);
+            return;
+        }
+
+        if constexpr (std::is_void<decltype(work())>::value)
+        {
+            work();
+            post([done, wanted, finished]() mutable
+            {
+                if (wanted())
+                {
+                    done();
+                }
+                finished();
+            });
+        }
+        else
+        {
+            auto result = work();
+            post([result = std::move(result), done, wanted, finished]() mutable
+            {
+                if (wanted())
+                {
+                    done(std::move(result));
+                }
+                finished();
+            });
+        }
+    });
+
+    return handle;
+}
+
 }
 
 #endif
@@ -0,0 +1,99 @@
+/*
+ * Frontier - A toolkit for creating simple OS-independent user interfaces
+ * Copyright (C) 2020 Ian Parker <ian@geekprojects.com>
+ *
+ * This file is part of Frontier.
+ *
+ * Frontier is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * Frontier is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with Frontier.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef __FRONTIER_ASYNC_H_
+#define __FRONTIER_ASYNC_H_
+
+#include <frontier/taskqueue.h>
+
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace Frontier {
+
+/**
+ * \brief A fixed set of threads that run Tasks in the background
+ *
+ * The threads are only started when the first Task is run. Tasks that
+ * haven't started when the pool is destroyed are still run before the
+ * destructor returns.
+ */
+class WorkerPool
+{
+ private:
+    unsigned int m_threadCount;
+    std::vector<std::thread> m_threads;
+
+    std::deque<Task> m_tasks;
+    std::mutex m_mutex;
+    std::condition_variable m_condition;
+    bool m_stopping;
+
+    void worker();
+
+ public:
+    /// Create a pool with the specified number of threads, or one per CPU if 0
+    explicit WorkerPool(unsigned int threadCount = 0);
+    ~WorkerPool();
+
+    /// Run a Task on one of the worker threads. Safe to call from any thread
+    void run(Task task);
+
+    /**
+     * \brief Call the function with each index from 0 to count - 1, spread across the workers
+     *
+     * The calling thread takes part, and idle workers take the next index
+     * as they become free. Returns when every call has finished. As the
+     * caller never waits for a worker to become available, it's safe to
+     * call from within a Task, including another parallelFor.
+     */
+    void parallelFor(unsigned int count, const std::function<void(unsigned int)>& body);
+
+    unsigned int getThreadCount() const { return m_threadCount; }
+};
+
+/**
+ * \brief Refers to work started by FrontierApp::async()
+ *
+ * Copies refer to the same work.
+ */
+class AsyncHandle
+{
+ private:
+    std::shared_ptr<std::atomic<bool>> m_cancelled;
+
+ public:
+    AsyncHandle() : m_cancelled(std::make_shared<std::atomic<bool>>(false)) {}
+
+    /// Stop the result from being delivered. Work that has already started will still finish
+    void cancel() { *m_cancelled = true; }
+
+    bool isCancelled() const { return *m_cancelled; }
+};
+
+}
+
+#endif
@@ -0,0 +1,68 @@
+/*
+ * Frontier - A toolkit for creating simple OS-independent user interfaces
+ * Copyright (C) 2020 Ian Parker <ian@geekprojects.com>
+ *
+ * This file is part of Frontier.
+ *
+ * Frontier is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * Frontier is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with Frontier.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef __FRONTIER_DAMAGE_H_
+#define __FRONTIER_DAMAGE_H_
+
+#include <vector>
+
+#include <frontier/utils.h>
+
+namespace Frontier {
+
+/**
+ * \brief Accumulates the areas of a Surface that have changed
+ *
+ * Overlapping Rects are merged as they are added. Once there are too many
+ * Rects to be worth handling separately, they are collapsed in to their
+ * bounding box.
+ */
+class DamageRegion
+{
+ private:
+    std::vector<Rect> m_rects;
+
+ public:
+    DamageRegion() = default;
+    ~DamageRegion() = default;
+
+    /// Add a damaged area
+    void add(Rect rect);
+
+    /// Add all damaged areas from another region, offset by the given amount
+    void add(const DamageRegion& region, int dx, int dy);
+
+    /// Limit the damaged areas to the specified bounds
+    void clip(const Rect& bounds);
+
+    /// Scale all damaged areas, for example to convert to device pixels
+    void scale(float factor);
+
+    void clear() { m_rects.clear(); }
+    bool isEmpty() const { return m_rects.empty(); }
+    bool covers(const Rect& rect) const;
+
+    const std::vector<Rect>& getRects() const { return m_rects; }
+    Rect getBounds() const;
+};
+
+}
+
+#endif
@@ -0,0 +1,187 @@
+/*
+ * Frontier - A toolkit for creating simple OS-independent user interfaces
+ * Copyright (C) 2020 Ian Parker <ian@geekprojects.com>
+ *
+ * This file is part of Frontier.
+ *
+ * Frontier is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * Frontier is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with Frontier.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef __FRONTIER_DISPLAYLIST_H_
+#define __FRONTIER_DISPLAYLIST_H_
+
+#include <string>
+#include <vector>
+
+#include <geek/gfx-surface.h>
+#include <geek/fonts.h>
+
+#include <frontier/utils.h>
+
+namespace Frontier {
+
+class TextCache;
+
+enum DisplayOp
+{
+    DISPLAY_CLEAR,
+    DISPLAY_PIXEL,
+    DISPLAY_LINE,
+    DISPLAY_RECT,
+    DISPLAY_RECT_FILLED,
+    DISPLAY_RECT_FILLED_ROUNDED,
+    DISPLAY_GRAD,
+    DISPLAY_GRAD_ROUNDED,
+    DISPLAY_CORNER,
+    DISPLAY_CIRCLE_FILLED,
+    DISPLAY_TEXT,
+    DISPLAY_BLIT,
+    DISPLAY_BLIT_VIEW,
+};
+
+/**
+ * \brief A recorded sequence of drawing operations
+ *
+ * Lists are filled by drawing to a RecordingSurface, and rasterized by
+ * replay(). Coordinates are relative to the Surface that was recorded.
+ *
+ * Blitted Surfaces are referred to rather than copied, so must not change
+ * until the list has been replayed. Text refers to the FontHandle and
+ * TextCache it was drawn with.
+ */
+class DisplayList
+{
+ private:
+    struct Command
+    {
+        DisplayOp op;
+        int32_t x;
+        int32_t y;
+        int32_t width;
+        int32_t height;
+        int32_t radius;
+        uint32_t colour;
+        uint32_t colour2;
+
+        /// Index in to m_text or m_surfaces, the Corner, or whether to force alpha
+        uint32_t param;
+        Rect view;
+
+        bool operator ==(const Command& other) const;
+    };
+
+    struct TextRun
+    {
+        TextCache* textCache;
+        Geek::FontHandle* font;
+        std::wstring text;
+
+        /// Area of the Surface that the text was clipped to
+        Rect clip;
+    };
+
+    std::vector<Command> m_commands;
+    std::vector<TextRun> m_text;
+    std::vector<Geek::Gfx::Surface*> m_surfaces;
+    bool m_complete;
+
+    Command& add(DisplayOp op, int32_t x, int32_t y, int32_t width = 0, int32_t height = 0);
+
+ public:
+    DisplayList();
+
+    void clear();
+
+    unsigned int size() const { return m_commands.size(); }
+    bool empty() const { return m_commands.empty(); }
+
+    /// Something was drawn that couldn't be recorded, so replaying this list won't reproduce it
+    void setIncomplete() { m_complete = false; }
+    bool isComplete() const { return m_complete; }
+
+    /**
+     * \brief Return whether replaying this list would draw the same as another
+     *
+     * Incomplete lists, and lists with blits, are never the same as anything
+     * as they may depend on state that hasn't been recorded.
+     */
+    bool isSame(const DisplayList& other) const;
+
+    /// Rasterize the list in to a Surface
+    void replay(Geek::Gfx::Surface* surface) const;
+
+    void addClear(uint32_t colour);
+    void addPixel(int32_t x, int32_t y, uint32_t colour);
+    void addLine(int32_t x1, int32_t y1, int32_t x2, int32_t y2, uint32_t colour);
+    void addRect(int32_t x, int32_t y, int32_t width, int32_t height, uint32_t colour);
+    void addRectFilled(int32_t x, int32_t y, int32_t width, int32_t height, uint32_t colour);
+    void addRectFilledRounded(int32_t x, int32_t y, int32_t width, int32_t height, int32_t radius, uint32_t colour);
+    void addGrad(int32_t x, int32_t y, int32_t width, int32_t height, uint32_t colour1, uint32_t colour2);
+    void addGradRounded(int32_t x, int32_t y, int32_t width, int32_t height, int32_t radius, uint32_t colour1, uint32_t colour2);
+    void addCorner(int32_t x, int32_t y, Geek::Gfx::Corner corner, int32_t radius, uint32_t colour);
+    void addCircleFilled(int32_t x, int32_t y, int32_t radius, uint32_t colour);
+    void addText(TextCache* textCache, Geek::FontHandle* font, int32_t x, int32_t y, const std::wstring& text, uint32_t colour, Rect clip);
+    void addBlit(int32_t x, int32_t y, Geek::Gfx::Surface* surface, bool forceAlpha);
+    void addBlit(int32_t x, int32_t y, Geek::Gfx::Surface* surface, Rect view, bool forceAlpha);
+};
+
+/**
+ * \brief A Surface that records what is drawn to it in to a DisplayList
+ *
+ * Nothing is rasterized. SurfaceViewPorts on to it record in its
+ * coordinates, and the TextCache records text as runs rather than glyph
+ * blits. Anything drawn by writing to the Surface's data directly is lost,
+ * so code that does should call markIncomplete().
+ */
+class RecordingSurface : public Geek::Gfx::Surface
+{
+ private:
+    DisplayList* m_list;
+    uint32_t m_width;
+    uint32_t m_height;
+    bool m_highDPI;
+
+ public:
+    RecordingSurface(DisplayList* list, uint32_t width, uint32_t height, bool highDPI);
+    ~RecordingSurface() override;
+
+    DisplayList* getDisplayList() const { return m_list; }
+
+    /// Return the RecordingSurface that a Surface or SurfaceViewPort draws to, or NULL if it isn't recording
+    static RecordingSurface* getRecorder(Geek::Gfx::Surface* surface);
+
+    /// Note that something has been drawn to a Surface that can't be recorded
+    static void markIncomplete(Geek::Gfx::Surface* surface);
+
+    uint32_t getWidth() const override { return m_width; }
+    uint32_t getHeight() const override { return m_height; }
+    bool isHighDPI() const override { return m_highDPI; }
+
+    bool clear(uint32_t colour) override;
+    bool drawPixel(int32_t x, int32_t y, uint32_t c) override;
+    bool drawLine(int32_t x1, int32_t y1, int32_t x2, int32_t y2, uint32_t c) override;
+    bool drawRect(int32_t x, int32_t y, int32_t w, int32_t h, uint32_t c) override;
+    bool drawRectFilled(int32_t x, int32_t y, int32_t w, int32_t h, uint32_t c) override;
+    bool drawRectFilledRounded(int32_t x, int32_t y, int32_t w, int32_t h, int32_t r, uint32_t c) override;
+    bool drawGrad(int32_t x, int32_t y, int32_t w, int32_t h, uint32_t c1, uint32_t c2) override;
+    bool drawGradRounded(int32_t x, int32_t y, int32_t w, int32_t h, int32_t r, uint32_t c1, uint32_t c2) override;
+    bool drawCorner(int32_t x, int32_t y, Geek::Gfx::Corner corner, int32_t r, uint32_t c) override;
+    bool drawCircleFilled(int32_t x, int32_t y, int32_t r, uint32_t c) override;
+    bool blit(int32_t x, int32_t y, Geek::Gfx::Surface* surface, bool forceAlpha = false) override;
+    bool blit(int32_t x, int32_t y, Geek::Gfx::Surface* surface, int32_t viewX, int32_t viewY, int32_t viewW, int32_t viewH, bool forceAlpha = false) override;
+};
+
+}
+
+#endif
@@ -26,6 +26,7 @@
 #include <geek/core-logger.h>
 
 #include <string>
+#include <vector>
 
 namespace Frontier {
 
@@ -43,6 +44,25 @@ class FrontierEngine : public Geek::Logger
  protected:
     FrontierApp* m_app;
 
+    /// Events waiting to be delivered by dispatchEvents()
+    std::vector<EventValue> m_eventBatch;
+
+    /// Events being delivered. Both vectors are reused, so queueing doesn't allocate
+    std::vector<EventValue> m_dispatchBatch;
+    bool m_dispatching;
+
+    /**
+     * \brief Add an Event to the batch for the Window it is set to
+     *
+     * Mouse motion is merged with motion immediately before it in the same
+     * Window, and scrolling at the same position is accumulated, so that a
+     * burst of input only needs to be handled once.
+     */
+    void queueEvent(const EventValue& event);
+
+    /// Run any posted Tasks and deliver all queued Events, with a single update of each Window afterwards
+    void dispatchEvents();
+
  public:
     explicit FrontierEngine(FrontierApp* app);
     virtual ~FrontierEngine();
@@ -53,6 +73,9 @@ class FrontierEngine : public Geek::Logger
 
     virtual bool checkEvents();
 
+    /// Make a checkEvents() that is waiting return promptly. May be called from any thread
+    virtual void wake();
+
     virtual bool quit(bool force);
 
     virtual std::string getConfigDir();
@@ -0,0 +1,153 @@
+/*
+ * Frontier - A toolkit for creating simple OS-independent user interfaces
+ * Copyright (C) 2020 Ian Parker <ian@geekprojects.com>
+ *
+ * This file is part of Frontier.
+ *
+ * Frontier is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * Frontier is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with Frontier.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef __FRONTIER_ENGINES_OFFSCREEN_H_
+#define __FRONTIER_ENGINES_OFFSCREEN_H_
+
+#include <frontier/engine.h>
+#include <frontier/events.h>
+
+#include <geek/core-thread.h>
+#include <geek/gfx-surface.h>
+
+#include <vector>
+
+namespace Frontier
+{
+
+class OffscreenEngine;
+
+/**
+ * \brief A window that renders into a Surface in memory
+ *
+ * \ingroup engines
+ */
+class OffscreenWindow : public Frontier::FrontierEngineWindow
+{
+ private:
+    Geek::Vector2D m_position;
+    bool m_visible;
+
+    /// Copy of the window's surface, as it would have been presented
+    Geek::Gfx::Surface* m_frame;
+    unsigned int m_frameCount;
+    bool m_updateRequested;
+
+    /// Areas copied by the last update
+    std::vector<Frontier::Rect> m_presentedRects;
+
+ public:
+    OffscreenWindow(Frontier::FrontierEngine* engine, Frontier::FrontierWindow* window);
+    ~OffscreenWindow() override;
+
+    bool init() override;
+    void show() override;
+    void hide() override;
+    bool update() override;
+
+    void setPosition(unsigned int x, unsigned int y) override { m_position.x = x; m_position.y = y; }
+    Geek::Vector2D getPosition() override { return m_position; }
+
+    float getScaleFactor() override;
+
+    void requestUpdate() override;
+
+    bool isVisible() const { return m_visible; }
+
+    /// Return whether an update has been requested and clear the request
+    bool takeUpdateRequest();
+
+    /// Return the last presented frame, or NULL if nothing has been presented
+    Geek::Gfx::Surface* getFrame() { return m_frame; }
+
+    /// Number of frames that have been presented
+    unsigned int getFrameCount() const { return m_frameCount; }
+
+    /// Return the areas of the frame that were updated by the last present
+    const std::vector<Frontier::Rect>& getPresentedRects() const { return m_presentedRects; }
+
+    /// Write the last presented frame to a PNG file
+    bool saveFrame(std::string path);
+};
+
+/**
+ * \brief An Engine that renders to memory, for running without a display
+ *
+ * Windows are rendered through the normal update path, and the results can
+ * be inspected or saved as PNGs. Input can be injected, and is delivered the
+ * next time checkEvents() is called.
+ *
+ * \ingroup engines
+ */
+class OffscreenEngine : public FrontierEngine
+{
+ protected:
+    float m_scaleFactor;
+    std::vector<OffscreenWindow*> m_windows;
+
+    std::vector<EventValue> m_events;
+    std::vector<EventValue> m_checkEvents;
+    Geek::Mutex* m_eventMutex;
+
+    uint32_t m_mouseX;
+    uint32_t m_mouseY;
+
+    void injectEvent(FrontierWindow* window, EventValue event);
+
+ public:
+    explicit OffscreenEngine(FrontierApp* app);
+    ~OffscreenEngine() override;
+
+    bool init() override;
+
+    bool initWindow(FrontierWindow* window) override;
+
+    /// Deliver any injected events and update the windows that requested it
+    bool checkEvents() override;
+
+    std::string getConfigDir() override;
+
+    // Dialogs
+    void message(std::string title, std::string message) override;
+    bool confirmBox(std::string title, std::string message) override;
+    std::string chooseFile(int flags, std::string path, std::string pattern) override;
+
+    void setScaleFactor(float factor) { m_scaleFactor = factor; }
+    float getScaleFactor() const { return m_scaleFactor; }
+
+    /// Return the OffscreenWindow for a FrontierWindow, or NULL
+    OffscreenWindow* getWindow(FrontierWindow* window);
+    void removeWindow(OffscreenWindow* window);
+
+    // Input injection
+    void injectMouseMotion(FrontierWindow* window, uint32_t x, uint32_t y);
+    void injectMouseButton(FrontierWindow* window, uint32_t x, uint32_t y, int buttons, bool direction, bool doubleClick = false);
+    void injectClick(FrontierWindow* window, uint32_t x, uint32_t y, int buttons = BUTTON_LEFT);
+    void injectMouseScroll(FrontierWindow* window, int32_t scrollX, int32_t scrollY);
+    void injectKey(FrontierWindow* window, uint32_t key, wchar_t chr, bool direction, uint32_t modifiers = 0);
+    void injectText(FrontierWindow* window, std::wstring text);
+
+    /// Return whether there are events waiting to be delivered
+    bool hasPendingEvents();
+};
+
+}
+
+#endif
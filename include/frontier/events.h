@@ -24,6 +24,7 @@
 #include <frontier/keycodes.h>
 
 #include <string>
+#include <variant>
 
 namespace Frontier {
 
@@ -99,6 +100,20 @@ struct MouseScrollEvent : MouseEvent
     int32_t scrollY;
 };
 
+/**
+ * \brief Holds any input Event by value
+ *
+ * Engines queue these instead of allocating each Event, and pass the Event
+ * they contain to FrontierWindow::handleEvent.
+ */
+typedef std::variant<KeyEvent, MouseButtonEvent, MouseMotionEvent, MouseScrollEvent> EventValue;
+
+/// Return the Event held by an EventValue
+inline Event* getEvent(EventValue& value)
+{
+    return std::visit([](auto& event) -> Event* { return &event; }, value);
+}
+
 }
 
 #endif
@@ -0,0 +1,95 @@
+/*
+ * Frontier - A toolkit for creating simple OS-independent user interfaces
+ * Copyright (C) 2020 Ian Parker <ian@geekprojects.com>
+ *
+ * This file is part of Frontier.
+ *
+ * Frontier is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * Frontier is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with Frontier.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef __FRONTIER_FRAMESCHEDULER_H_
+#define __FRONTIER_FRAMESCHEDULER_H_
+
+#include <vector>
+
+#include <geek/core-logger.h>
+#include <geek/core-thread.h>
+
+namespace Frontier {
+
+class FrontierApp;
+class FrontierWindow;
+
+/// Default time between frames, in nanoseconds (60Hz)
+#define FRONTIER_FRAME_INTERVAL 16666667
+
+/**
+ * \brief Decides when Windows that have changed are updated
+ *
+ * Handling events only marks Windows as needing a frame. Engines handle all
+ * pending input first and then call runFrames(), which updates every
+ * Window that needs it at most once per frame interval. If the app has been
+ * idle, the frame is produced straight away.
+ */
+class FrameScheduler : public Geek::Logger
+{
+ private:
+    struct PendingFrame
+    {
+        FrontierWindow* window;
+        bool force;
+    };
+
+    FrontierApp* m_app;
+
+    Geek::Mutex* m_mutex;
+    std::vector<PendingFrame> m_pending;
+
+    uint64_t m_interval;
+    uint64_t m_lastFrame;
+    unsigned int m_frameCount;
+
+ public:
+    explicit FrameScheduler(FrontierApp* app);
+    ~FrameScheduler() override;
+
+    /// Mark a Window as needing a frame. May be called from any thread
+    void requestFrame(FrontierWindow* window, bool force = false);
+
+    /// Forget any frame requested for a Window
+    void cancelFrame(FrontierWindow* window);
+
+    bool hasPendingFrames();
+
+    /// Return the number of milliseconds until frames are due, or -1 if none are needed
+    int getTimeout();
+
+    /**
+     * \brief Update all Windows that need a frame
+     *
+     * Does nothing if the last frame was less than an interval ago, unless
+     * force is set. Returns whether any frames were produced.
+     */
+    bool runFrames(bool force = false);
+
+    void setFrameInterval(uint64_t interval) { m_interval = interval; }
+    uint64_t getFrameInterval() const { return m_interval; }
+
+    /// Return the number of times frames have been produced
+    unsigned int getFrameCount() const { return m_frameCount; }
+};
+
+}
+
+#endif
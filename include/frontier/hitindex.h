@@ -0,0 +1,75 @@
+/*
+ * Frontier - A toolkit for creating simple OS-independent user interfaces
+ * Copyright (C) 2020 Ian Parker <ian@geekprojects.com>
+ *
+ * This file is part of Frontier.
+ *
+ * Frontier is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * Frontier is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with Frontier.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef __FRONTIER_HITINDEX_H_
+#define __FRONTIER_HITINDEX_H_
+
+#include <vector>
+
+#include <frontier/utils.h>
+
+namespace Frontier {
+
+/**
+ * \brief A uniform grid of Rects, for finding which of them contain a point
+ *
+ * Rects are identified by the order they were added in. The grid is sized
+ * from the average Rect, so a vertical list becomes a single column of rows
+ * and a grid of icons gets roughly one cell per icon.
+ */
+class HitIndex
+{
+ private:
+    std::vector<Rect> m_rects;
+
+    Rect m_bounds;
+    int m_cols;
+    int m_rows;
+    int m_cellWidth;
+    int m_cellHeight;
+
+    /// For each cell, the offset of its first entry in m_cellItems. Has an extra end entry
+    std::vector<unsigned int> m_cellStart;
+    std::vector<unsigned int> m_cellItems;
+
+    void getCells(const Rect& rect, int& col1, int& row1, int& col2, int& row2) const;
+
+ public:
+    HitIndex();
+    ~HitIndex() = default;
+
+    /// Remove all Rects
+    void clear();
+
+    /// Add a Rect. build() must be called before searching
+    void add(const Rect& rect) { m_rects.push_back(rect); }
+
+    /// Build the grid from the Rects that have been added
+    void build();
+
+    /// Return the lowest index of a Rect that contains the point, or -1
+    int find(int x, int y) const;
+
+    size_t size() const { return m_rects.size(); }
+};
+
+}
+
+#endif
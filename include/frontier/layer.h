@@ -25,6 +25,7 @@
 #include <frontier/utils.h>
 #include <frontier/object.h>
 #include <frontier/app.h>
+#include <frontier/damage.h>
 #include <geek/gfx-surface.h>
 
 namespace Frontier {
@@ -46,6 +47,12 @@ class Layer : public FrontierObject, Geek::Logger
     VerticalAlign m_verticalAlign;
     Frontier::Rect m_rect;
 
+    /// Areas of the surface that have been redrawn since the Layer was last composited
+    DamageRegion m_damage;
+
+    void collectDamage(Widget* widget, int x, int y);
+    void layoutBoundaries(Widget* widget);
+
  public:
     explicit Layer(FrontierApp* app, bool primary = false);
     ~Layer() override;
@@ -70,6 +77,9 @@ class Layer : public FrontierObject, Geek::Logger
     void setSize(Size size) { m_rect.width = size.width; m_rect.height = size.height; }
 
     bool update();
+
+    const DamageRegion& getDamage() const { return m_damage; }
+    void clearDamage() { m_damage.clear(); }
 };
 
 }
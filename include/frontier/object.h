@@ -26,22 +26,40 @@
 namespace Frontier
 {
 
+class FrontierApp;
+
 /**
  * \brief Base class for all Frontier classes, providing basic reference counting
  *
- * This class is used by the FrontierApp garbage collection.
+ * This class is used by the FrontierApp garbage collection. Once a
+ * registered object has no references, it is queued to be deleted by the
+ * next FrontierApp::gc().
  */
 class FrontierObject
 {
  private:
     std::atomic<int> m_referenceCount;
 
+    /// The app that will delete us, set by FrontierApp::registerObject
+    FrontierApp* m_releaseApp;
+    std::atomic<bool> m_releaseQueued;
+
+    void release();
+
+    friend class FrontierApp;
+
  public:
     FrontierObject();
     virtual ~FrontierObject();
 
     void incRefCount() { m_referenceCount++; }
-    void decRefCount() { m_referenceCount--; }
+    void decRefCount()
+    {
+        if (--m_referenceCount <= 0)
+        {
+            release();
+        }
+    }
     int getRefCount() { return m_referenceCount.load(); }
 };
 
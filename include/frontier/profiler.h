@@ -0,0 +1,208 @@
+/*
+ * Frontier - A toolkit for creating simple OS-independent user interfaces
+ * Copyright (C) 2020 Ian Parker <ian@geekprojects.com>
+ *
+ * This file is part of Frontier.
+ *
+ * Frontier is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * Frontier is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with Frontier.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef __FRONTIER_PROFILER_H_
+#define __FRONTIER_PROFILER_H_
+
+#include <string>
+#include <vector>
+#include <unordered_map>
+#include <set>
+#include <atomic>
+#include <memory>
+#include <mutex>
+
+#include <geek/core-logger.h>
+#include <geek/core-thread.h>
+
+namespace Frontier {
+
+/// Maximum number of trace events kept before further events are dropped
+#define FRONTIER_PROFILE_MAX_EVENTS (1024 * 1024)
+
+/// Number of frames kept by a FrameHistogram
+#define FRONTIER_FRAME_HISTORY 256
+
+/// Number of buckets in a FrameHistogram
+#define FRONTIER_FRAME_BUCKETS 7
+
+// Profiler categories, one per phase of producing a frame
+#define PROFILE_FRAME "frame"
+#define PROFILE_STYLE "style"
+#define PROFILE_MEASURE "measure"
+#define PROFILE_LAYOUT "layout"
+#define PROFILE_DRAW "draw"
+#define PROFILE_COMPOSITE "composite"
+#define PROFILE_PRESENT "present"
+
+/**
+ * \brief Rolling record of how long recent frames took
+ */
+class FrameHistogram
+{
+ private:
+    uint64_t m_times[FRONTIER_FRAME_HISTORY];
+    unsigned int m_count;
+    unsigned int m_next;
+
+ public:
+    FrameHistogram();
+
+    /// Add the duration of a frame, in nanoseconds
+    void add(uint64_t ns);
+    void clear();
+
+    unsigned int getCount() const { return m_count; }
+    uint64_t getAverage() const;
+    uint64_t getMax() const;
+
+    /// Return the duration that the specified percentage of frames were faster than
+    uint64_t getPercentile(float percentile) const;
+
+    /// Return the number of frames that fall in to a bucket
+    unsigned int getBucket(unsigned int bucket) const;
+
+    /// Return the upper limit of a bucket, in nanoseconds
+    static uint64_t getBucketLimit(unsigned int bucket);
+
+    std::string toString() const;
+};
+
+/**
+ * \brief Records how long each phase of producing frames takes
+ *
+ * Profiling is off by default and costs a single check per scope. It can be
+ * enabled by setting FRONTIER_PROFILE to the path of a trace file, which is
+ * written when the app exits, or with start() and writeTrace(). Traces are
+ * in the Chrome Trace Event format and can be opened with chrome://tracing
+ * or Perfetto.
+ */
+class Profiler : public Geek::Logger
+{
+ private:
+    struct Event
+    {
+        const char* category;
+        const char* name;
+        uint64_t start;
+        uint64_t duration;
+        unsigned int thread;
+    };
+
+    /// Events recorded by one thread. Only that thread adds to them, so the lock is rarely contended
+    struct ThreadEvents
+    {
+        std::mutex mutex;
+        std::vector<Event> events;
+
+        /// Names already looked up by this thread, only used by this thread
+        std::unordered_map<std::wstring, const char*> nameMap;
+    };
+
+    /// Identifies this Profiler in each thread's list of ThreadEvents
+    unsigned int m_id;
+
+    std::atomic<bool> m_enabled;
+    uint64_t m_startTime;
+    std::string m_tracePath;
+
+    Geek::Mutex* m_mutex;
+    std::vector<std::unique_ptr<ThreadEvents>> m_threadEvents;
+    std::atomic<unsigned int> m_eventCount;
+    std::atomic<unsigned int> m_dropped;
+
+    std::unordered_map<std::wstring, const char*> m_nameMap;
+    std::set<std::string> m_names;
+
+    /// Return the calling thread's events, creating them the first time it records
+    ThreadEvents* getThreadEvents();
+
+ public:
+    Profiler();
+    ~Profiler() override;
+
+    /// Start recording, writing the trace to the specified path when the Profiler is destroyed
+    void start(std::string tracePath = "");
+    void stop();
+    void clear();
+
+    bool isEnabled() const { return m_enabled; }
+
+    /// Return the current time in nanoseconds
+    static uint64_t getTime();
+
+    void record(const char* category, const char* name, uint64_t start, uint64_t end);
+
+    /// Return a permanent copy of a name, such as a Widget name
+    const char* getName(const std::wstring& name);
+
+    unsigned int getEventCount();
+
+    bool writeTrace(std::string path);
+};
+
+/**
+ * \brief Records the time from construction until it goes out of scope
+ */
+class ProfileScope
+{
+ private:
+    Profiler* m_profiler;
+    const char* m_category;
+    const char* m_name;
+    uint64_t m_start;
+
+ public:
+    ProfileScope(Profiler* profiler, const char* category, const char* name)
+    {
+        m_profiler = NULL;
+        if (profiler->isEnabled())
+        {
+            m_profiler = profiler;
+            m_category = category;
+            m_name = name;
+            m_start = Profiler::getTime();
+        }
+    }
+
+    ProfileScope(Profiler* profiler, const char* category, const std::wstring& name)
+    {
+        m_profiler = NULL;
+        if (profiler->isEnabled())
+        {
+            m_profiler = profiler;
+            m_category = category;
+            m_name = profiler->getName(name);
+            m_start = Profiler::getTime();
+        }
+    }
+
+    ~ProfileScope()
+    {
+        if (m_profiler != NULL)
+        {
+            m_profiler->record(m_category, m_name, m_start, Profiler::getTime());
+        }
+    }
+};
+
+}
+
+#endif
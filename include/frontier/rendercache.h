@@ -0,0 +1,100 @@
+/*
+ * Frontier - A toolkit for creating simple OS-independent user interfaces
+ * Copyright (C) 2020 Ian Parker <ian@geekprojects.com>
+ *
+ * This file is part of Frontier.
+ *
+ * Frontier is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * Frontier is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with Frontier.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef __FRONTIER_RENDERCACHE_H_
+#define __FRONTIER_RENDERCACHE_H_
+
+#include <list>
+#include <unordered_map>
+
+#include <geek/gfx-surface.h>
+#include <geek/core-logger.h>
+
+namespace Frontier {
+
+class Widget;
+
+/// Default limit of memory used by cached Widget surfaces (32MB)
+#define FRONTIER_RENDER_CACHE_BUDGET (32 * 1024 * 1024)
+
+/**
+ * \brief Holds the last rendered Surfaces of Widgets that opt in to caching
+ *
+ * The cache is shared between all Windows of an app and is limited to a
+ * memory budget. When the budget is exceeded, the least recently used
+ * Surfaces are freed.
+ */
+class RenderCache : public Geek::Logger
+{
+ private:
+    struct Entry
+    {
+        Widget* widget;
+        Geek::Gfx::Surface* surface;
+        unsigned int size;
+
+        /// Set while the Widget is drawing in to the Surface, so it can't be evicted
+        bool pinned;
+    };
+
+    std::list<Entry> m_entries;
+    std::unordered_map<Widget*, std::list<Entry>::iterator> m_entryMap;
+
+    unsigned int m_budget;
+    unsigned int m_used;
+
+    /// Free least recently used Surfaces until there is room. Returns false if there isn't
+    bool evict(unsigned int required);
+
+ public:
+    RenderCache();
+    ~RenderCache() override;
+
+    /**
+     * \brief Return the cached Surface for a Widget
+     *
+     * If the Widget has no Surface, or it no longer matches the specified
+     * size, a new one is allocated and created is set to true. Returns NULL
+     * if the Surface would not fit in the budget, including when the only
+     * Surfaces that could be freed are pinned.
+     */
+    Geek::Gfx::Surface* get(Widget* widget, int width, int height, bool highDPI, bool& created);
+
+    /**
+     * Stop a Widget's Surface from being evicted while it is being drawn in
+     * to, such as by a cached child asking for its own Surface
+     */
+    void pin(Widget* widget);
+    void unpin(Widget* widget);
+
+    /// Free the Surface associated with a Widget
+    void remove(Widget* widget);
+
+    void clear();
+
+    void setBudget(unsigned int budget);
+    unsigned int getBudget() const { return m_budget; }
+    unsigned int getUsed() const { return m_used; }
+    unsigned int getCount() const { return m_entries.size(); }
+};
+
+}
+
+#endif
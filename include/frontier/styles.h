@@ -26,9 +26,11 @@
 #include <map>
 #include <unordered_map>
 #include <functional>
+#include <bitset>
 
 #include <geek/core-logger.h>
 #include <frontier/value.h>
+#include <frontier/object.h>
 
 #define FRONTIER_COLOUR_TRANSPARENT 0xffffffff00000000ull
 #define FRONTIER_HORIZONTAL_ALIGN_LEFT 0
@@ -38,6 +40,49 @@
 #define FRONTIER_VERTICAL_ALIGN_MIDDLE 1
 #define FRONTIER_VERTICAL_ALIGN_BOTTOM 2
 
+/*
+ * The CSS properties that Frontier knows about. Shortcut properties such as
+ * "margin" are expanded by the parser, so only the properties they expand to
+ * are listed.
+ */
+#define FRONTIER_STYLE_PROPERTIES(P) \
+    P(MARGIN_TOP, "margin-top")                   \
+    P(MARGIN_RIGHT, "margin-right")               \
+    P(MARGIN_BOTTOM, "margin-bottom")             \
+    P(MARGIN_LEFT, "margin-left")                 \
+    P(PADDING_TOP, "padding-top")                 \
+    P(PADDING_RIGHT, "padding-right")             \
+    P(PADDING_BOTTOM, "padding-bottom")           \
+    P(PADDING_LEFT, "padding-left")               \
+    P(BORDER_TOP_WIDTH, "border-top-width")       \
+    P(BORDER_TOP_STYLE, "border-top-style")       \
+    P(BORDER_TOP_COLOR, "border-top-color")       \
+    P(BORDER_RIGHT_WIDTH, "border-right-width")   \
+    P(BORDER_RIGHT_STYLE, "border-right-style")   \
+    P(BORDER_RIGHT_COLOR, "border-right-color")   \
+    P(BORDER_BOTTOM_WIDTH, "border-bottom-width") \
+    P(BORDER_BOTTOM_STYLE, "border-bottom-style") \
+    P(BORDER_BOTTOM_COLOR, "border-bottom-color") \
+    P(BORDER_LEFT_WIDTH, "border-left-width")     \
+    P(BORDER_LEFT_STYLE, "border-left-style")     \
+    P(BORDER_LEFT_COLOR, "border-left-color")     \
+    P(BORDER_RADIUS, "border-radius")             \
+    P(BACKGROUND_COLOR, "background-color")       \
+    P(BACKGROUND_IMAGE, "background-image")       \
+    P(TEXT_COLOR, "text-color")                   \
+    P(FONT_FAMILY, "font-family")                 \
+    P(FONT_STYLE, "font-style")                   \
+    P(FONT_SIZE, "font-size")                     \
+    P(ALIGN_HORIZONTAL, "align-horizontal")       \
+    P(ALIGN_VERTICAL, "align-vertical")           \
+    P(EXPAND_HORIZONTAL, "expand-horizontal")     \
+    P(EXPAND_VERTICAL, "expand-vertical")         \
+    P(MAX_WIDTH, "max-width")                     \
+    P(SCROLLBAR_COLOR, "scrollbar-color")         \
+    P(SCROLLBAR_WIDTH, "scrollbar-width")         \
+    P(RENDER_CACHE, "render-cache")               \
+    P(CONTAIN, "contain")
+
 namespace Frontier {
 
 class Widget;
@@ -46,6 +91,51 @@ class Widget;
  * \defgroup styles CSS Engine
  */
 
+/**
+ * \brief Interned ids of the known CSS properties
+ *
+ * \ingroup styles
+ */
+enum StyleProperty
+{
+#define FRONTIER_STYLE_PROPERTY_ENUM(id, name) STYLE_##id,
+    FRONTIER_STYLE_PROPERTIES(FRONTIER_STYLE_PROPERTY_ENUM)
+#undef FRONTIER_STYLE_PROPERTY_ENUM
+
+    STYLE_PROPERTY_COUNT,
+    STYLE_PROPERTY_UNKNOWN = STYLE_PROPERTY_COUNT
+};
+
+/// Return the CSS name of the specified property
+const char* getStylePropertyName(StyleProperty property);
+
+/// Return the id of the named CSS property, or STYLE_PROPERTY_UNKNOWN
+StyleProperty findStyleProperty(const std::string& name);
+
+/**
+ * \brief Widget states that can be matched by a pseudo-class
+ *
+ * \ingroup styles
+ */
+enum StyleState
+{
+    STYLE_STATE_ACTIVE = 0x1,
+    STYLE_STATE_SELECTED = 0x2,
+    STYLE_STATE_HOVER = 0x4,
+};
+
+/**
+ * \brief Which Widgets need their styles resolving again after a change
+ *
+ * \ingroup styles
+ */
+enum StyleInvalidation
+{
+    STYLE_INVALIDATE_NONE = 0x0,
+    STYLE_INVALIDATE_SELF = 0x1,
+    STYLE_INVALIDATE_DESCENDANTS = 0x2,
+};
+
 struct StyleSelector
 {
     std::wstring widgetType;
@@ -86,13 +176,66 @@ class StyleRule
     void setProperty(std::string property, Value value);
     void applyProperty(std::string property, Value value);
     void applyProperty(std::string property, std::vector<Value> values);
-    std::unordered_map<std::string, Value> getProperties() { return m_properties; }
+    const std::unordered_map<std::string, Value>& getProperties() const { return m_properties; }
+};
+
+/**
+ * \brief The style properties computed for a Widget
+ *
+ * Known properties are stored in a flat array indexed by StyleProperty so
+ * they can be read without hashing. Anything else is kept in a map.
+ *
+ * A ComputedStyle is shared by every Widget with the same style signature,
+ * so it must not be modified once it has been created.
+ *
+ * \ingroup styles
+ */
+class ComputedStyle : public FrontierObject
+{
+ private:
+    Value m_values[STYLE_PROPERTY_COUNT];
+    std::bitset<STYLE_PROPERTY_COUNT> m_hasValue;
+    std::unordered_map<std::string, Value> m_otherProperties;
+
+    void set(const std::string& property, const Value& value);
+
+ public:
+    explicit ComputedStyle(const std::unordered_map<std::string, Value>& properties);
+    ComputedStyle(const ComputedStyle& base, const std::unordered_map<std::string, Value>& properties);
+    ~ComputedStyle() override = default;
+
+    bool has(StyleProperty property) const { return m_hasValue.test(property); }
+    const Value& get(StyleProperty property) const { return m_values[property]; }
+
+    bool has(const std::string& property) const;
+    Value get(const std::string& property) const;
+
+    /// Return the number of properties that have been set
+    unsigned int size() const { return m_hasValue.count() + m_otherProperties.size(); }
+
+    /// Drop a reference, deleting the ComputedStyle once nothing refers to it
+    void release();
+};
+
+/**
+ * \brief A selector in the rule set that matches on a Widget state
+ *
+ * \ingroup styles
+ */
+struct StyleStateDependency
+{
+    /// The selector without its pseudo-class
+    StyleSelector selector;
+    unsigned int state;
+    unsigned int invalidation;
 };
 
 class CssParser;
 
 typedef std::function<bool(std::pair<StyleRule*, int>, std::pair<StyleRule*, int>)> StyleComparator;
 
+typedef std::vector<std::pair<StyleRule*, int>> StyleRuleList;
+
 /**
  * \brief A CSS rules engine
  *
@@ -102,10 +245,46 @@ class StyleEngine : public Geek::Logger
 {
  private:
     CssParser* m_parser;
-    std::vector<std::pair<StyleRule*, int>> m_styleRules;
+    StyleRuleList m_styleRules;
     uint64_t m_timestamp;
     uint64_t m_currentId;
 
+    /*
+     * Rules indexed by their rightmost selector. A rule is only stored in
+     * one bucket, picked by the most selective part of the selector (id,
+     * then class, then widget type), so a Widget only needs to test the
+     * rules in the buckets for its id, classes and types.
+     */
+    std::unordered_map<std::wstring, StyleRuleList> m_idRules;
+    std::unordered_map<std::wstring, StyleRuleList> m_classRules;
+    std::unordered_map<std::wstring, StyleRuleList> m_typeRules;
+    StyleRuleList m_universalRules;
+
+    /*
+     * Computed styles shared between Widgets, keyed by the style signature
+     * of the Widget and its ancestors. The cache holds a reference to each
+     * entry, and entries no Widget is using are pruned as it grows.
+     */
+    std::unordered_map<std::wstring, ComputedStyle*> m_styleCache;
+
+    /*
+     * The states and classes that the rules depend on, and whether a change
+     * affects just the Widget (rightmost selector) or its descendants too.
+     */
+    std::vector<StyleStateDependency> m_stateDependencies;
+    std::unordered_map<std::wstring, unsigned int> m_classDependencies;
+
+    void indexRule(std::pair<StyleRule*, int> rulePair);
+    static void addCandidates(std::unordered_map<std::wstring, StyleRuleList>& index, const std::wstring& key, StyleRuleList& candidates);
+    static bool compareRules(const std::pair<StyleRule*, int>& elem1, const std::pair<StyleRule*, int>& elem2);
+
+    void matchRules(Widget* widget, std::unordered_map<std::string, Value>& results);
+    static std::wstring getStyleSignature(Widget* widget);
+    void pruneStyleCache();
+    void clearStyleCache();
+    void addDependencies(StyleRule* rule);
+    static unsigned int getStateFlag(const std::string& state);
+
  public:
     StyleEngine();
     ~StyleEngine();
@@ -119,7 +298,28 @@ class StyleEngine : public Geek::Logger
     StyleRule* findByKey(std::string key);
 
     std::unordered_map<std::string, Value> getProperties(Widget* widget);
+
+    /**
+     * \brief Return the computed style for a Widget
+     *
+     * Widgets with the same types, classes, id, state and ancestors share
+     * a single ComputedStyle. The caller owns a reference to the returned
+     * object and must release() it.
+     */
+    ComputedStyle* getComputedStyle(Widget* widget);
+
+    /// Return the number of shared computed styles currently cached
+    unsigned int getStyleCacheSize() const { return m_styleCache.size(); }
+
+    /// Return the StyleInvalidation needed when a Widget's StyleStates change
+    unsigned int getStateInvalidation(Widget* widget, unsigned int states);
+
+    /// Return the StyleInvalidation needed when a class is added or removed
+    unsigned int getClassInvalidation(const std::wstring& className);
     uint64_t getTimestamp() const { return m_timestamp; }
+
+    /// Return the number of rules that have been added
+    unsigned int getRuleCount() const { return m_styleRules.size(); }
 };
 
 };
@@ -0,0 +1,72 @@
+/*
+ * Frontier - A toolkit for creating simple OS-independent user interfaces
+ * Copyright (C) 2020 Ian Parker <ian@geekprojects.com>
+ *
+ * This file is part of Frontier.
+ *
+ * Frontier is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * Frontier is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with Frontier.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef __FRONTIER_TASKQUEUE_H_
+#define __FRONTIER_TASKQUEUE_H_
+
+#include <atomic>
+#include <cstddef>
+#include <functional>
+#include <vector>
+
+namespace Frontier {
+
+/// Work to be run on the UI thread
+typedef std::function<void()> Task;
+
+/**
+ * \brief A lock-free queue of Tasks, with many producers and a single consumer
+ *
+ * Producers push on to an atomic list with a compare and swap. The consumer
+ * takes the whole list in one exchange, so it never waits for a producer,
+ * and runs the Tasks in the order they were posted.
+ */
+class TaskQueue
+{
+ private:
+    struct TaskNode
+    {
+        Task task;
+        TaskNode* next;
+    };
+
+    std::atomic<TaskNode*> m_head;
+
+    bool push(TaskNode* first, TaskNode* last);
+
+ public:
+    TaskQueue();
+    ~TaskQueue();
+
+    /// Add a Task. Returns true if the queue was empty, and so the consumer may need waking
+    bool post(Task task);
+
+    /// Add several Tasks with a single atomic operation. The vector is emptied
+    bool post(std::vector<Task>& tasks);
+
+    /// Run all Tasks posted so far, and return how many there were. Only one thread may call this
+    unsigned int run();
+
+    bool isEmpty() const { return m_head.load() == NULL; }
+};
+
+}
+
+#endif
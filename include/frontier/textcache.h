@@ -0,0 +1,173 @@
+/*
+ * Frontier - A toolkit for creating simple OS-independent user interfaces
+ * Copyright (C) 2020 Ian Parker <ian@geekprojects.com>
+ *
+ * This file is part of Frontier.
+ *
+ * Frontier is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * Frontier is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with Frontier.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef __FRONTIER_TEXTCACHE_H_
+#define __FRONTIER_TEXTCACHE_H_
+
+#include <mutex>
+#include <shared_mutex>
+#include <string>
+#include <vector>
+#include <unordered_map>
+
+#include <geek/gfx-surface.h>
+#include <geek/fonts.h>
+#include <geek/core-logger.h>
+
+#include <frontier/utils.h>
+
+namespace Frontier {
+
+/**
+ * \brief Caches rendered glyphs and measured text widths
+ *
+ * Each glyph is rendered by FreeType once per font in to an atlas Surface,
+ * as white on black to capture its coverage. When a glyph is first drawn in
+ * a colour, the coverage is converted to an alpha mask of that colour in
+ * another part of the atlas. Drawing text is then a sequence of blits from
+ * the atlas.
+ *
+ * It's safe to use from several threads at once. Hits only need a shared
+ * lock, so threads only wait for each other when a glyph has to be rendered.
+ * Text drawn to a RecordingSurface is recorded as a run instead.
+ */
+class TextCache : public Geek::Logger
+{
+ private:
+    struct GlyphKey
+    {
+        Geek::FontHandle* font;
+        wchar_t c;
+        uint32_t colour;
+        bool highDPI;
+
+        bool operator ==(const GlyphKey& other) const
+        {
+            return font == other.font && c == other.c && colour == other.colour && highDPI == other.highDPI;
+        }
+    };
+
+    struct GlyphKeyHash
+    {
+        size_t operator()(const GlyphKey& key) const
+        {
+            size_t hash = std::hash<void*>()(key.font);
+            hash = (hash * 31) + key.c;
+            hash = (hash * 31) + key.colour;
+            return (hash * 31) + key.highDPI;
+        }
+    };
+
+    struct WidthKey
+    {
+        Geek::FontHandle* font;
+        std::wstring text;
+
+        bool operator ==(const WidthKey& other) const
+        {
+            return font == other.font && text == other.text;
+        }
+    };
+
+    struct WidthKeyHash
+    {
+        size_t operator()(const WidthKey& key) const
+        {
+            return (std::hash<void*>()(key.font) * 31) + std::hash<std::wstring>()(key.text);
+        }
+    };
+
+    struct Glyph
+    {
+        unsigned int page;
+        Rect rect;
+        int advance;
+        bool empty;
+    };
+
+    struct AtlasPage
+    {
+        Geek::Gfx::Surface* surface;
+        bool highDPI;
+        int shelfX;
+        int shelfY;
+        int shelfHeight;
+    };
+
+    std::vector<AtlasPage> m_pages;
+
+    /// White on black renderings of glyphs, the colour of the key is unused
+    std::unordered_map<GlyphKey, Glyph, GlyphKeyHash> m_coverage;
+
+    /// Glyphs converted to a specific colour
+    std::unordered_map<GlyphKey, Glyph, GlyphKeyHash> m_glyphs;
+
+    std::unordered_map<WidthKey, int, WidthKeyHash> m_widths;
+
+    /// Guards the pages and maps. Held exclusively while anything is added or removed
+    std::shared_mutex m_mutex;
+
+    std::mutex m_fontMutex;
+
+    int drawGlyph(Geek::Gfx::Surface* surface, Geek::FontHandle* font, int x, int y, wchar_t c, uint32_t colour);
+    int blit(Geek::Gfx::Surface* surface, int x, int y, const Glyph* glyph, bool highDPI);
+    int measure(Geek::FontHandle* font, const std::wstring& text);
+    void flush();
+    bool allocate(int width, int height, bool highDPI, unsigned int& page, Rect& rect);
+    const Glyph* getCoverage(Geek::FontHandle* font, wchar_t c, bool highDPI);
+    const Glyph* getGlyph(Geek::FontHandle* font, wchar_t c, uint32_t colour, bool highDPI);
+
+ public:
+    TextCache();
+    ~TextCache() override;
+
+    /// Draw text in the specified colour
+    bool write(Geek::Gfx::Surface* surface, Geek::FontHandle* font, int x, int y, const std::wstring& text, uint32_t colour);
+
+    /// Draw a single character, returning its width
+    int write(Geek::Gfx::Surface* surface, Geek::FontHandle* font, int x, int y, wchar_t c, uint32_t colour);
+
+    /// Return the width of the text as it will be drawn, the sum of its glyphs' advances
+    int width(Geek::FontHandle* font, const std::wstring& text);
+
+    /// Return the width of a single character
+    int width(Geek::FontHandle* font, wchar_t c);
+
+    /// Forget everything cached for a font. Must be called before a FontHandle is deleted
+    void removeFont(Geek::FontHandle* font);
+
+    void clear();
+
+    /**
+     * \brief Lock that must be held while using a FontHandle or the FontManager directly
+     *
+     * FreeType isn't thread safe, and widgets may be drawn concurrently.
+     * Don't call any other TextCache methods while holding it.
+     */
+    std::mutex& getFontMutex() { return m_fontMutex; }
+
+    unsigned int getPageCount() const { return m_pages.size(); }
+    unsigned int getGlyphCount() const { return m_glyphs.size(); }
+    unsigned int getWidthCount() const { return m_widths.size(); }
+};
+
+}
+
+#endif
@@ -22,6 +22,7 @@
 #define __FRONTIER_UTILS_H_
 
 #include <string>
+#include <algorithm>
 
 namespace Frontier {
 
@@ -167,6 +168,67 @@ struct Rect
     {
         return (_x >= x && _y >= y && _x < (x + width) && _y < (y + height));
     }
+
+    bool isEmpty() const
+    {
+        return (width <= 0 || height <= 0);
+    }
+
+    /// Return whether the two Rects overlap
+    bool intersects(const Rect& r) const
+    {
+        return (r.x < x + width && x < r.x + r.width && r.y < y + height && y < r.y + r.height);
+    }
+
+    /// Return whether the Rect is entirely within this Rect
+    bool contains(const Rect& r) const
+    {
+        return (r.x >= x && r.y >= y && r.x + r.width <= x + width && r.y + r.height <= y + height);
+    }
+
+    /// Return the area covered by both Rects
+    Rect intersect(const Rect& r) const
+    {
+        int x1 = std::max(x, r.x);
+        int y1 = std::max(y, r.y);
+        int x2 = std::min(x + width, r.x + r.width);
+        int y2 = std::min(y + height, r.y + r.height);
+        if (x2 <= x1 || y2 <= y1)
+        {
+            return Rect();
+        }
+        return Rect(x1, y1, x2 - x1, y2 - y1);
+    }
+
+    /// Return the smallest Rect that covers both Rects
+    Rect combine(const Rect& r) const
+    {
+        if (isEmpty())
+        {
+            return r;
+        }
+        else if (r.isEmpty())
+        {
+            return *this;
+        }
+        int x1 = std::min(x, r.x);
+        int y1 = std::min(y, r.y);
+        int x2 = std::max(x + width, r.x + r.width);
+        int y2 = std::max(y + height, r.y + r.height);
+        return Rect(x1, y1, x2 - x1, y2 - y1);
+    }
+
+    bool operator ==(const Rect& r) const
+    {
+        return (x == r.x && y == r.y && width == r.width && height == r.height);
+    }
+
+    std::string toString() const
+    {
+        char buffer[64];
+        snprintf(buffer, 64, "%d,%d %dx%d", x, y, width, height);
+        return std::string(buffer);
+    }
 };
 
 /**
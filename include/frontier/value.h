@@ -45,7 +45,7 @@ struct Value
 
     ~Value() = default;
 
-    std::wstring asString()
+    std::wstring asString() const
     {
         switch (type)
         {
@@ -67,7 +67,7 @@ struct Value
         }
     }
 
-    int64_t asInt()
+    int64_t asInt() const
     {
         switch (type)
         {
@@ -86,7 +86,7 @@ struct Value
         }
     }
 
-    bool asBool()
+    bool asBool() const
     {
         switch (type)
         {
@@ -38,6 +38,8 @@
 namespace Frontier {
 
 class Menu;
+class HitIndex;
+class DisplayList;
 
 /**
  * \brief Describes and caches the CSS box model of a widget
@@ -98,8 +100,8 @@ class Widget : public FrontierObject, public Geek::Logger
     /// Styles set directly on the Widget
     StyleRule m_widgetStyleProperties;
 
-    /// Cached style properties
-    std::unordered_map<std::string, Value> m_cachedStyleProperties;
+    /// Cached style properties, shared with similar Widgets
+    ComputedStyle* m_computedStyle;
 
     /// Cached box model style properties
     BoxModel m_cachedBoxModel;
@@ -107,6 +109,21 @@ class Widget : public FrontierObject, public Geek::Logger
     Geek::FontHandle* m_cachedTextFont;
     uint64_t m_cachedTextFontTimestamp;
 
+    /// Whether the last rendered Surface of this Widget should be kept
+    bool m_renderCacheEnabled;
+
+    /// True if the Widget has a Surface in the RenderCache
+    bool m_hasRenderCache;
+
+    /// True if the Surface in the RenderCache is up to date
+    bool m_renderCacheValid;
+
+    /// What was last drawn to the RenderCache, if display lists are enabled
+    DisplayList* m_displayList;
+
+    /// Whether this Widget has been made a layout boundary
+    bool m_layoutBoundary;
+
     sigc::signal<void, bool> m_mouseEnterSignal;
     sigc::signal<void> m_activeSignal;
     sigc::signal<void> m_inactiveSignal;
@@ -119,10 +136,11 @@ class Widget : public FrontierObject, public Geek::Logger
 
     void initWidget(FrontierApp* app, std::wstring widgetName);
     void callInit();
+    void setChildDirty(unsigned int dirty, bool remeasure);
+    void setClassDirty(const std::wstring& className);
+    void setStyleDirty(unsigned int invalidation);
 
-    BoxModel& getBoxModel(std::unordered_map<std::string, Value>& properties);
-    Value getStyle(std::string style, std::unordered_map<std::string, Value>& properties);
-    static bool hasStyle(std::string style, std::unordered_map<std::string, Value>& properties);
+    BoxModel& getBoxModel(const ComputedStyle* style);
 
  protected:
     /// The Application that this widget belongs to
@@ -149,6 +167,17 @@ class Widget : public FrontierObject, public Geek::Logger
     /// Position of the widget, relative to it's parent
     Geek::Vector2D m_position;
 
+    /// Position relative to the Window, valid while the App's layout generation is unchanged
+    mutable Geek::Vector2D m_absolutePosition;
+    mutable uint64_t m_absolutePositionGeneration;
+
+    /// Bounds of m_children for hit testing, built on demand for large containers
+    HitIndex* m_hitIndex;
+    uint64_t m_hitIndexGeneration;
+
+    /// Index of the child that was hit last, which is tried first
+    unsigned int m_lastHitChild;
+
     /// Minimum size this Widget can be. Set during calculateSize()
     Frontier::Size m_minSize;
 
@@ -161,6 +190,17 @@ class Widget : public FrontierObject, public Geek::Logger
     /// Flags indicating what aspects of this Widget are dirty
     unsigned int m_dirty;
 
+    /// True if this Widget itself needs redrawing, rather than just a child
+    bool m_damaged;
+
+    /// Window whose dirty list this Widget is in, if any
+    FrontierWindow* m_dirtyListWindow;
+    void addToDirtyList();
+    void setParentDirty(unsigned int dirty, bool remeasure);
+
+    /// True if m_minSize and m_maxSize are up to date
+    bool m_measureValid;
+
     /// True if this widget is in a selected state
     bool m_selected;
 
@@ -173,6 +213,20 @@ class Widget : public FrontierObject, public Geek::Logger
     /// Get font used for text, as specified by CSS
     Geek::FontHandle* getTextFont();
 
+    /**
+     * Draw each child in to its area of the surface. If parallel drawing is
+     * enabled, children that can be are drawn on the worker threads. The
+     * children mustn't overlap. Each child is passed the part of visible
+     * (in our coordinates) that it covers.
+     */
+    void drawChildren(Geek::Gfx::Surface* surface, const std::vector<Widget*>& children, Frontier::Rect visible);
+
+    /// Record draw() in to the display list and rasterize it, unless it's the same as last time
+    bool drawRecorded(Geek::Gfx::Surface* surface, bool created);
+
+    /// Fill the caches used by draw(), and return whether this Widget and its children can be drawn off the UI thread
+    bool prepareParallelDraw();
+
     /// Draw text using the Widget's CSS styling
     void drawText(Geek::Gfx::Surface* surface, int x, int y, std::wstring str, Geek::FontHandle* font = NULL);
 
@@ -187,6 +241,9 @@ class Widget : public FrontierObject, public Geek::Logger
     /// Get the Widget type name
     std::wstring getWidgetName() { return m_widgetName; }
 
+    /// Return the names of all widget types this Widget is or extends
+    const std::set<std::wstring>& getWidgetNames() const { return m_widgetNames; }
+
     /// Return whether this Widget is or overrides the given widget name
     virtual bool instanceOf(const std::wstring widgetName) { return (m_widgetName == widgetName || m_widgetNames.count(widgetName) > 0); }
 
@@ -211,6 +268,13 @@ class Widget : public FrontierObject, public Geek::Logger
     /// Calculate the minimum and maximum size this Widget can be
     virtual void calculateSize();
 
+    /**
+     * Calculate the minimum and maximum size, unless nothing that affects them
+     * has changed since they were last calculated. Containers should use this
+     * to measure their children.
+     */
+    void measure();
+
     /// Layout the child widgets of this Widget
     virtual void layout();
 
@@ -230,6 +294,55 @@ class Widget : public FrontierObject, public Geek::Logger
      */
     virtual bool draw(Geek::Gfx::Surface* surface, Rect visible);
 
+    /**
+     * Called by scrolling containers with the area of the Widget that is
+     * currently visible. This may be larger than the area passed to draw(),
+     * which may only be the part that needs redrawing.
+     */
+    virtual void setVisibleArea(Rect visible) {}
+
+    /**
+     * Draw the widget, reusing the last rendered Surface if render caching is
+     * enabled and neither this Widget nor its children are dirty. Containers
+     * should use this to draw their children.
+     */
+    bool drawCached(Geek::Gfx::Surface* surface, Rect visible);
+
+    /**
+     * Record what draw() would draw, without rasterizing it. Children are
+     * recorded in to the same list, which can then be replayed on any thread
+     * or at either scale.
+     */
+    bool record(DisplayList* list, bool highDPI = false);
+
+    /**
+     * Return whether draw() can run on a worker thread at the same time as
+     * other Widgets. Widgets that change other Widgets or shared state while
+     * drawing should return false.
+     */
+    virtual bool isParallelDrawSafe() { return true; }
+
+    /// Keep the last rendered Surface of this Widget. This can also be enabled with the render-cache style
+    void setRenderCacheEnabled(bool enabled);
+
+    /// Return whether render caching is enabled, either directly or via CSS
+    bool isRenderCacheEnabled();
+
+    /**
+     * Stop size changes within this Widget from causing its parents to be
+     * laid out, unless its own min or max size changes. Widgets with a fixed
+     * size or the "contain: size" style are always layout boundaries.
+     */
+    void setLayoutBoundary(bool boundary) { m_layoutBoundary = boundary; }
+    bool isLayoutBoundary() const;
+
+    /**
+     * Measure and lay out a layout boundary whose contents have changed.
+     * Returns false if its min or max size changed, in which case its
+     * parent has been marked as needing layout instead.
+     */
+    bool layoutBoundary();
+
     /*
      * Properties
      */
@@ -242,9 +355,11 @@ class Widget : public FrontierObject, public Geek::Logger
 
     /// Return whether the specified style is set by the Style Sheet
     bool hasStyle(std::string style);
+    bool hasStyle(StyleProperty style);
 
     /// Return whether the value of the style set by the Style Sheet for this Widget
     Value getStyle(std::string style);
+    Value getStyle(StyleProperty style);
 
     /// Set the specified CSS property on this Widget
     void setStyle(std::string style, Value value);
@@ -265,13 +380,13 @@ class Widget : public FrontierObject, public Geek::Logger
     void clearWidgetClass(std::wstring className);
 
     /// Return all style classes applied to this Widget
-    std::set<std::wstring> getWidgetClasses() { return m_widgetClasses; }
+    const std::set<std::wstring>& getWidgetClasses() const { return m_widgetClasses; }
 
     /// Return all the styles applied directly to this Widget
     StyleRule* getWidgetStyle() { return &m_widgetStyleProperties; }
 
     // Return all style properties either directly or via CSS
-    std::unordered_map<std::string, Value>& getStyleProperties();
+    const ComputedStyle* getComputedStyle();
 
     /// Return the CSS box model
     BoxModel& getBoxModel();
@@ -301,15 +416,35 @@ class Widget : public FrontierObject, public Geek::Logger
     /// Check whether the specified point lies inside this widget. The position is relative to it's parent
     bool intersects(int x, int y) const;
 
+    /// Return the first of m_children that contains the specified point, or NULL
+    Widget* findChildAt(int x, int y);
+
     /// Set all dirty flags
     void setDirty();
 
     /**
      * Set specified dirty flags.
      * If children is true, recurse through children, otherwise, set on parent Widget
+     * If remeasure is false, DIRTY_SIZE and DIRTY_STYLE don't invalidate the
+     * min and max sizes, such as when the Widget has just been moved or resized.
      * \see Frontier::DirtyFlag
      */
-    void setDirty(unsigned int flags, bool children = false);
+    void setDirty(unsigned int flags, bool children = false, bool remeasure = true);
+
+    /**
+     * Mark this Widget and the descendants that intersect area (in our
+     * coordinates) as needing to be redrawn, such as when part of a
+     * Scroller's child has been scrolled in to view.
+     */
+    void setAreaDirty(Frontier::Rect area);
+
+    /**
+     * Mark the style as dirty after the specified StyleStates have changed.
+     * Only Widgets whose matching rules can change are marked.
+     *
+     * \see Frontier::StyleState
+     */
+    void setStateDirty(unsigned int states);
 
     /// Check if any dirty flags are set
     bool isDirty() const { return !!(m_dirty); }
@@ -317,9 +452,25 @@ class Widget : public FrontierObject, public Geek::Logger
     /// Check if specified DirtyFlag is set
     bool isDirty(DirtyFlag flag) const { return !!(m_dirty & flag); }
 
-    /// Clear all DirtyFlags and recurse through the Widget's children
+    /// Check if this Widget's own area needs redrawing
+    bool isDamaged() const { return m_damaged; }
+
+    /**
+     * Return whether a dirty child only changes the child's own area when
+     * drawn. Containers that redraw all of their content whenever a child
+     * changes should return false.
+     */
+    virtual bool isChildDamageLocal() const { return true; }
+
+    /// Check if the Widget's children need to be laid out again
+    bool needsLayout() const { return !!(m_dirty & (DIRTY_SIZE | DIRTY_STYLE)); }
+
+    /// Clear all DirtyFlags and recurse through the Widget's dirty children
     virtual void clearDirty();
 
+    /// Called by FrontierWindow when this Widget is removed from its dirty list
+    void setDirtyListWindow(FrontierWindow* window) { m_dirtyListWindow = window; }
+
     /// Mark this widget as being active
     void setActive();
 
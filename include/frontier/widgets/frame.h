@@ -48,6 +48,7 @@ class Frame : public Widget
     void layout() override;
 
     bool draw(Geek::Gfx::Surface* surface) override;
+    bool draw(Geek::Gfx::Surface* surface, Frontier::Rect visible) override;
 
     Widget* handleEvent(Frontier::Event* event) override;
 
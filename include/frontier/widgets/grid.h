@@ -47,6 +47,7 @@ class Grid : public Frontier::Widget
     int* m_colMaxSizes;
     int* m_rowMinSizes;
     int* m_rowMaxSizes;
+    Size m_sizesGridSize;
 
     void freeSizes();
     void clearChildren();
@@ -66,6 +67,7 @@ class Grid : public Frontier::Widget
     void clear();
 
     bool draw(Geek::Gfx::Surface* surface) override;
+    bool draw(Geek::Gfx::Surface* surface, Frontier::Rect visible) override;
 
     Widget* handleEvent(Frontier::Event* event) override;
 
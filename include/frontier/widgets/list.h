@@ -102,9 +102,43 @@ class TreeListItem : public TextListItem
     sigc::signal<void, ListItem*> expandSignal() { return m_expandSignal; }
 };
 
+/**
+ * \brief Provides the rows of a virtual List
+ *
+ * Only the visible rows of a virtual List have ListItems. They are created
+ * by the model, and recycled by binding them to different rows as the List
+ * is scrolled.
+ */
+class ListModel
+{
+ public:
+    virtual ~ListModel() = default;
+
+    /// Return the number of rows
+    virtual unsigned int getRowCount() = 0;
+
+    /**
+     * Return the height of all rows. If the rows have different heights,
+     * return 0 and implement getRowHeight() instead.
+     */
+    virtual int getFixedRowHeight() = 0;
+
+    /// Return the height, or an estimate of the height, of the specified row
+    virtual int getRowHeight(unsigned int row) { return getFixedRowHeight(); }
+
+    /// Create a new ListItem that can be bound to any row
+    virtual ListItem* createItem(List* list) = 0;
+
+    /// Update a new or recycled ListItem to show the specified row
+    virtual void bindItem(ListItem* item, unsigned int row) = 0;
+};
+
 /**
  * \brief A widget that shows a List of child ListItems
  *
+ * If a ListModel is set, the List only contains ListItems for the visible
+ * rows. Virtual Lists are always vertical.
+ *
  * \ingroup widgets
  */
 class List : public Widget
@@ -114,9 +148,34 @@ class List : public Widget
     ListItem* m_selected;
     bool m_horizontal;
 
+    ListModel* m_model;
+    int m_selectedRow;
+
+    /// Row shown by the first child when using a ListModel
+    unsigned int m_firstRow;
+
+    /// Whether all visible rows need binding again
+    bool m_rebindRows;
+
+    /// Area set by a Scroller, used to decide which rows are bound
+    Rect m_visibleArea;
+    bool m_hasVisibleArea;
+
+    /// ListItems that are not currently bound to a visible row
+    std::vector<ListItem*> m_recyclePool;
+
+    /// Offsets of each row, only used if the rows aren't a fixed height
+    std::vector<int> m_rowOffsets;
+
     sigc::signal<void, ListItem*> m_selectSignal;
     sigc::signal<void, ListItem*, Geek::Vector2D> m_contextMenuSignal;
 
+    int getRowOffset(unsigned int row);
+    unsigned int getRowAt(int y);
+    ListItem* getRecycledItem();
+    void bindRows(Rect visible);
+    void clearRecyclePool();
+
  public:
     explicit List(FrontierApp* ui);
     List(FrontierApp* ui, bool horizontal);
@@ -127,6 +186,10 @@ class List : public Widget
     void calculateSize() override;
     void layout() override;
     bool draw(Geek::Gfx::Surface* surface, Rect visible) override;
+    void setVisibleArea(Rect visible) override;
+
+    /// Model backed Lists create and lay out their rows while drawing
+    bool isParallelDrawSafe() override { return m_model == NULL; }
 
     Widget* handleEvent(Frontier::Event* event) override;
 
@@ -137,6 +200,20 @@ class List : public Widget
     ListItem* getSelected() { return m_selected; }
     ListItem* getItem(int i) { return (ListItem*)m_children.at(i); }
 
+    /// Show the rows provided by the specified model. The List does not take ownership of the model
+    void setModel(ListModel* model);
+    ListModel* getModel() const { return m_model; }
+
+    /// Must be called after the rows provided by the model have changed
+    void modelChanged();
+
+    /// Return the row that the specified ListItem is currently bound to, or -1
+    int getItemRow(ListItem* item);
+
+    /// Return the selected row when using a ListModel, or -1
+    int getSelectedRow() const { return m_selectedRow; }
+    void setSelectedRow(int row);
+
     virtual sigc::signal<void, ListItem*> selectSignal() { return m_selectSignal; }
     virtual sigc::signal<void, ListItem*, Geek::Vector2D> contextMenuSignal() { return m_contextMenuSignal; }
 };
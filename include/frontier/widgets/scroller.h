@@ -38,10 +38,18 @@ class Scroller : public Widget
     ScrollBar* m_hScrollBar;
     ScrollBar* m_vScrollBar;
     Widget* m_child;
-    Geek::Gfx::Surface* m_childSurface;
     Size m_drawSize;
 
+    /// The visible area of the child, reused when scrolling
+    Geek::Gfx::Surface* m_backingStore;
+
+    /// The scroll position that the backing store was drawn at
+    Geek::Vector2D m_backingPos;
+    bool m_backingValid;
+
     void checkSurfaceSize(bool highDPI);
+    void scrollBackingStore(int dx, int dy);
+    void drawChildArea(Rect area);
 
     void initScroller(Widget* child);
 
@@ -54,8 +62,13 @@ class Scroller : public Widget
     void layout() override;
 
     int getPos() { return m_vScrollBar->getPos(); }
+    void setPos(int pos) { m_vScrollBar->setPos(pos); }
 
     bool draw(Geek::Gfx::Surface* surface) override;
+    bool isChildDamageLocal() const override { return false; }
+
+    /// Scrolling marks the child dirty while drawing
+    bool isParallelDrawSafe() override { return false; }
 
     Widget* handleEvent(Frontier::Event* event) override;
 
@@ -79,8 +79,8 @@ class Tab : public Widget
     void setContent(Widget* content) { add(content); }
     Widget* getContent() { if (m_children.empty()) { return NULL; } else { return m_children.at(0); } }
 
-    void setSelected() { m_selected = true; setDirty(DIRTY_STYLE); }
-    void clearSelected() { m_selected = false; setDirty(DIRTY_STYLE); }
+    void setSelected() { m_selected = true; setStateDirty(STYLE_STATE_SELECTED); }
+    void clearSelected() { m_selected = false; setStateDirty(STYLE_STATE_SELECTED); }
 };
 
 /**
@@ -74,9 +74,19 @@ struct TermChar
 
 struct TermLine
 {
-    std::vector<TermChar> chars;
+    /// Number of cells that have been written
+    unsigned int length;
+
+    /// Whether the line has changed since it was last drawn
+    bool dirty;
 };
 
+/// Default number of lines kept by a Terminal
+#define TERMINAL_DEFAULT_SCROLLBACK 10000
+
+/// Number of cells kept for each line, characters past this are dropped
+#define TERMINAL_MAX_COLUMNS 256
+
 /**
  * \inbrief A very simple terminal emulator Widget
  *
@@ -85,7 +95,18 @@ struct TermLine
 class Terminal : public Widget
 {
  private:
-    std::vector<TermLine> m_buffer;
+    /**
+     * Ring buffer of lines. Rows are numbered from when the Terminal was
+     * last cleared, and only the last m_lines.size() are kept. Each line's
+     * characters are a fixed slice of TERMINAL_MAX_COLUMNS cells in
+     * m_cells, which only grows as lines are first used.
+     */
+    std::vector<TermLine> m_lines;
+    std::vector<TermChar> m_cells;
+    unsigned int m_firstRow;
+    unsigned int m_rowCount;
+    Geek::Mutex* m_bufferMutex;
+
     unsigned int m_col;
     unsigned int m_row;
     unsigned int m_offsetRow;
@@ -97,9 +118,24 @@ class Terminal : public Widget
 
     TerminalProcess* m_process;
 
+    /// State of the last draw, to work out what needs redrawing
+    bool m_fullRedraw;
+    unsigned int m_drawnOffsetRow;
+    unsigned int m_drawnCursorRow;
+
+    /// Set until the Terminal has been drawn, so bursts of output only request one update
+    bool m_redrawPending;
+
     void reset();
     void clear();
+    TermLine& getLine(unsigned int row) { return m_lines.at(row % m_lines.size()); }
+    TermChar* getCells(unsigned int row) { return &(m_cells[(row % m_lines.size()) * TERMINAL_MAX_COLUMNS]); }
+    void eraseChars(unsigned int row, unsigned int col, unsigned int count);
+    bool hasLine(unsigned int row) const { return row >= m_firstRow && row < m_firstRow + m_rowCount; }
+    TermLine* addLine(unsigned int row);
     void setChar(unsigned int row, unsigned int col, wchar_t c);
+    void processChar(wchar_t c);
+    void requestRedraw();
 
     void handleCSI(wchar_t c);
 
@@ -117,6 +153,13 @@ class Terminal : public Widget
     void receiveChar(wchar_t c);
     void receiveChars(char* c, int length);
 
+    /// Set the maximum number of lines to keep. This clears the Terminal
+    void setScrollback(unsigned int lines);
+    unsigned int getScrollback() const { return m_lines.size(); }
+
+    /// Number of lines currently held in the buffer
+    unsigned int getLineCount() const { return m_rowCount; }
+
     bool run(const char* command);
     bool run(const char* command, std::vector<const char*> args);
     bool run(const char* command, std::vector<const char*> args, std::vector<const char*> env);
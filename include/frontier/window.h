@@ -29,6 +29,7 @@
 #include <frontier/events.h>
 #include <frontier/theme.h>
 #include <frontier/layer.h>
+#include <frontier/profiler.h>
 
 #include <sigc++/sigc++.h>
 
@@ -97,12 +98,24 @@ class FrontierWindow : public FrontierObject, public Geek::Logger
     uint64_t m_motionTime;
     Frontier::WindowCursor m_currentCursor;
 
-    uint64_t m_updateTimestamp;
     Geek::Mutex* m_drawMutex;
     bool m_updating;
+
+    /// Widgets that have been marked dirty since the last update
+    std::vector<Widget*> m_dirtyWidgets;
+    Geek::Mutex* m_dirtyMutex;
     bool m_compositeSurface;
     Geek::Gfx::Surface* m_windowSurface;
 
+    /// Areas of the window surface that have changed, in window coordinates
+    DamageRegion m_damage;
+
+    /// Areas of the window surface that the engine needs to present, in pixels
+    DamageRegion m_presentDamage;
+
+    /// How long recent updates that produced a frame took
+    FrameHistogram m_frameHistogram;
+
     Widget* m_dragWidget;
     Geek::Gfx::Surface* m_dragSurface;
     Geek::Vector2D m_dragPosition;
@@ -116,6 +129,7 @@ class FrontierWindow : public FrontierObject, public Geek::Logger
 
     bool initInternal();
     void updateCursor();
+    void clearDirtyWidgets();
 
     Widget* dragOver(Geek::Vector2D position, Widget* current, bool dropped);
 
@@ -149,8 +163,15 @@ class FrontierWindow : public FrontierObject, public Geek::Logger
     void show();
     void hide();
     void update(bool force = false);
+
+    /// Ask for the Window to be updated by the next frame
     void requestUpdate();
 
+    /// Called by Widget when it becomes dirty
+    void addDirtyWidget(Widget* widget);
+    void removeDirtyWidget(Widget* widget);
+    bool hasDirtyWidgets();
+
     void setEngineWindow(FrontierEngineWindow* few) { m_engineWindow = few; }
     FrontierEngineWindow* getEngineWindow() { return m_engineWindow; }
     FrontierApp* getApp() const { return m_app; }
@@ -158,9 +179,19 @@ class FrontierWindow : public FrontierObject, public Geek::Logger
     void setSize(Frontier::Size size);
     Frontier::Size getSize() const { return m_rootLayer->getRect().getSize(); }
     Geek::Gfx::Surface* getSurface() { return m_windowSurface; }
+
+    /**
+     * Return the areas of the window surface that have changed since the
+     * last update, in pixels. Only valid while the engine window is being
+     * updated. If empty, the whole surface should be presented.
+     */
+    const DamageRegion& getDamage() const { return m_presentDamage; }
     float getScaleFactor();
     Geek::Mutex* getDrawMutex() { return m_drawMutex; }
 
+    /// Return the durations of recent updates that produced a frame
+    const FrameHistogram& getFrameHistogram() const { return m_frameHistogram; }
+
     Menu* getMenu() { return m_menu; }
 
     virtual void setMenu(Menu* menu);
@@ -170,7 +201,15 @@ class FrontierWindow : public FrontierObject, public Geek::Logger
     void removeLayer(Layer* layer);
     std::vector<Layer*>& getLayers() { return m_layers; }
 
+    /**
+     * \brief Deliver an input Event from any thread
+     *
+     * The Event is copied, and handled on the UI thread by the Engine's next
+     * iteration. The caller keeps ownership of the Event.
+     */
     void postEvent(Frontier::Event* event);
+
+    /// Deliver an input Event to the Window. The caller keeps ownership of the Event
     virtual bool handleEvent(Frontier::Event* event);
     sigc::signal<void> closeSignal() { return m_closeSignal; }
     sigc::signal<void> showSignal() { return m_showSignal; }
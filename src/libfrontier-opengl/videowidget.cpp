@@ -80,14 +80,27 @@ static void *get_proc_address_mpv(void *fn_ctx, const char *name)
     return dlsym(RTLD_DEFAULT, name);
 }
 
+// mpv calls these from its own threads, so the work is handed over to the UI thread
 static void on_mpv_events(void *ctx)
 {
-    ((VideoWidget*)ctx)->mpvEvent();
+    VideoWidget* widget = (VideoWidget*)ctx;
+    widget->incRefCount();
+    widget->getApp()->post([widget]()
+    {
+        widget->mpvEvent();
+        widget->decRefCount();
+    });
 }
 
 static void on_mpv_render_update(void *ctx)
 {
-    ((VideoWidget*)ctx)->mpvRender();
+    VideoWidget* widget = (VideoWidget*)ctx;
+    widget->incRefCount();
+    widget->getApp()->post([widget]()
+    {
+        widget->mpvRender();
+        widget->decRefCount();
+    });
 }
 
 void VideoWidget::init()
@@ -39,6 +39,7 @@
 #if FRONTIER_ENGINE_WAYLAND
 #   include "engines/wayland/wayland.h"
 #endif
+#include <frontier/engines/offscreen.h>
 
 #define STRINGIFY(x) XSTRINGIFY(x)
 #define XSTRINGIFY(x) #x
@@ -59,13 +60,53 @@ FrontierApp::FrontierApp(wstring name) : Logger(L"FrontierApp[" + name + L"]")
 {
     m_activeWindow = NULL;
     m_contextMenuWindow = NULL;
+    m_eventBatchDepth = 0;
+    m_layoutGeneration = 1;
+
+    m_releaseMutex = Geek::Thread::createMutex();
+    m_objectCount = 0;
+    m_trackObjects = false;
+
+    const char* envTrack = getenv("FRONTIER_TRACK_OBJECTS");
+    if (envTrack != NULL && envTrack[0] != 0)
+    {
+        m_trackObjects = true;
+    }
     m_name = name;
 
     m_engine = NULL;
     m_theme = NULL;
     m_fontManager = NULL;
+    m_styleEngine = NULL;
 
     m_widgetBuilder = new WidgetBuilder(this);
+    m_renderCache = new RenderCache();
+    m_textCache = new TextCache();
+    m_profiler = new Profiler();
+    m_frameScheduler = new FrameScheduler(this);
+    m_taskQueue = new TaskQueue();
+    m_workerPool = new WorkerPool();
+    m_shuttingDown = false;
+
+    const char* envProfile = getenv("FRONTIER_PROFILE");
+    if (envProfile != NULL && envProfile[0] != 0)
+    {
+        m_profiler->start(envProfile);
+    }
+
+    m_parallelDraw = false;
+    const char* envParallelDraw = getenv("FRONTIER_PARALLEL_DRAW");
+    if (envParallelDraw != NULL && envParallelDraw[0] != 0)
+    {
+        m_parallelDraw = true;
+    }
+
+    m_displayListsEnabled = false;
+    const char* envDisplayLists = getenv("FRONTIER_DISPLAY_LISTS");
+    if (envDisplayLists != NULL && envDisplayLists[0] != 0)
+    {
+        m_displayListsEnabled = true;
+    }
 
     m_appMenu = NULL;
 
@@ -87,6 +128,15 @@ FrontierApp::FrontierApp(wstring name) : Logger(L"FrontierApp[" + name + L"]")
 
 FrontierApp::~FrontierApp()
 {
+    // Stop the workers first, as they may still be posting results. Work
+    // that hasn't started is skipped, but still releases its owner
+    m_shuttingDown = true;
+    delete m_workerPool;
+    m_workerPool = NULL;
+
+    // Deliver what was posted, so the owners' references are released
+    m_taskQueue->run();
+
     for (FrontierWindow* window : m_windows)
     {
         window->decRefCount();
@@ -106,15 +156,26 @@ FrontierApp::~FrontierApp()
     if (m_engine != NULL)
     {
         delete m_engine;
+        m_engine = NULL;
     }
 
     gc();
 
+    if (m_objectCount > 0)
+    {
+        log(Geek::DEBUG, "~FrontierApp: Leaked objects: %u", m_objectCount);
+    }
     for (FrontierObject* obj : m_objects)
     {
         log(Geek::DEBUG, "~FrontierApp: Leaked object %p: type=%s references=%d", obj, typeid(*obj).name(), obj->getRefCount());
     }
 
+    delete m_renderCache;
+    delete m_textCache;
+    delete m_profiler;
+    delete m_frameScheduler;
+    delete m_taskQueue;
+
     g_app = NULL;
 }
 
@@ -135,6 +196,14 @@ bool FrontierApp::init()
     if (m_engine == NULL)
     {
         string engineName = STRINGIFY(ENGINE);
+
+        // Allow the engine to be overridden, such as to run headless
+        const char* envEngine = getenv("FRONTIER_ENGINE");
+        if (envEngine != NULL && envEngine[0] != 0)
+        {
+            engineName = envEngine;
+        }
+
         log(DEBUG, "init: Default engine: %s", engineName.c_str());
 #ifdef FRONTIER_ENGINE_SDL
         if (engineName == "SDL")
@@ -160,6 +229,10 @@ bool FrontierApp::init()
             m_engine = new WaylandEngine(this);
         }
 #endif
+        if (engineName == "Offscreen")
+        {
+            m_engine = new OffscreenEngine(this);
+        }
         if (m_engine == nullptr)
         {
             log(ERROR, "Failed to create find engine: %s", engineName.c_str());
@@ -217,40 +290,80 @@ bool FrontierApp::init()
 
 void FrontierApp::registerObject(FrontierObject* obj)
 {
-    m_objects.insert(obj);
+    obj->m_releaseApp = this;
+    m_objectCount++;
+
+    if (m_trackObjects)
+    {
+        m_objects.insert(obj);
+    }
+
+    // Objects that nothing takes a reference to are freed by the next gc
+    if (obj->getRefCount() <= 0)
+    {
+        releaseObject(obj);
+    }
+}
+
+void FrontierApp::releaseObject(FrontierObject* obj)
+{
+    bool queued = false;
+    if (!obj->m_releaseQueued.compare_exchange_strong(queued, true))
+    {
+        // Already waiting for gc
+        return;
+    }
+
+    m_releaseMutex->lock();
+    m_releaseQueue.push_back(obj);
+    m_releaseMutex->unlock();
 }
 
 void FrontierApp::gc()
 {
     unsigned int totalFreed = 0;
-    unsigned int freed = 0;
-    do
+    while (true)
     {
-        set<FrontierObject*> objects = m_objects; // Make a copy!
-        freed = 0;
+        // Deleting objects may release more
+        m_releaseMutex->lock();
+        vector<FrontierObject*> objects;
+        objects.swap(m_releaseQueue);
+        m_releaseMutex->unlock();
+
+        if (objects.empty())
+        {
+            break;
+        }
+
         for (FrontierObject* obj : objects)
         {
-            //log(DEBUG, "gc: %p: references=%d", obj, obj->getRefCount());
+            obj->m_releaseQueued = false;
+
             int count = obj->getRefCount();
-            if (count <= 0)
+            if (count > 0)
+            {
+                // Something has taken a new reference since it was released
+                continue;
+            }
+            if (count < 0)
+            {
+                log(Geek::WARN, "gc: %p: RefCount is less than zero: %s", obj, typeid(*obj).name());
+            }
+
+            if (m_trackObjects)
             {
-                //log(DEBUG, "gc: %p: references=%d", obj, obj->getRefCount());
-                if (count < 0)
-                {
-                    log(Geek::WARN, "gc: %p: RefCount is less than zero: %s", obj, typeid(*obj).name());
-                }
-                delete obj;
                 m_objects.erase(obj);
-                freed++;
             }
+            m_objectCount--;
+
+            delete obj;
+            totalFreed++;
         }
-        totalFreed += freed;
     }
-    while (freed > 0);
 
     if (totalFreed > 0)
     {
-        log(Geek::DEBUG, "gc: totalFreed=%u, currentCount=%lu", totalFreed, m_objects.size());
+        log(Geek::DEBUG, "gc: totalFreed=%u, currentCount=%u", totalFreed, m_objectCount);
     }
 }
 
@@ -356,6 +469,39 @@ void FrontierApp::update()
     gc();
 }
 
+void FrontierApp::post(Task task)
+{
+    // Only the first Task needs to wake the Engine, it'll run any that follow
+    if (m_taskQueue->post(std::move(task)) && m_engine != NULL)
+    {
+        m_engine->wake();
+    }
+}
+
+void FrontierApp::post(vector<Task>& tasks)
+{
+    if (m_taskQueue->post(tasks) && m_engine != NULL)
+    {
+        m_engine->wake();
+    }
+}
+
+void FrontierApp::beginEventBatch()
+{
+    m_eventBatchDepth++;
+}
+
+void FrontierApp::endEventBatch()
+{
+    if (m_eventBatchDepth == 0)
+    {
+        log(ERROR, "endEventBatch: Not in a batch!");
+        return;
+    }
+
+    m_eventBatchDepth--;
+}
+
 void FrontierApp::handleEvent(Event* event)
 {
 }
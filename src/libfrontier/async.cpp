@@ -0,0 +1,147 @@
+/*
+ * Frontier - A toolkit for creating simple OS-independent user interfaces
+ * Copyright (C) 2020 Ian Parker <ian@geekprojects.com>
+ *
+ * This file is part of Frontier.
+ *
+ * Frontier is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * Frontier is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with Frontier.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <frontier/async.h>
+
+using namespace Frontier;
+using namespace std;
+
+WorkerPool::WorkerPool(unsigned int threadCount)
+{
+    if (threadCount == 0)
+    {
+        threadCount = max(1u, thread::hardware_concurrency());
+    }
+    m_threadCount = threadCount;
+    m_stopping = false;
+}
+
+WorkerPool::~WorkerPool()
+{
+    {
+        lock_guard<mutex> lock(m_mutex);
+        m_stopping = true;
+    }
+    m_condition.notify_all();
+
+    for (thread& worker : m_threads)
+    {
+        worker.join();
+    }
+}
+
+void WorkerPool::run(Task task)
+{
+    {
+        lock_guard<mutex> lock(m_mutex);
+        if (m_threads.empty())
+        {
+            unsigned int i;
+            for (i = 0; i < m_threadCount; i++)
+            {
+                m_threads.emplace_back(&WorkerPool::worker, this);
+            }
+        }
+        m_tasks.push_back(std::move(task));
+    }
+    m_condition.notify_one();
+}
+
+namespace {
+
+struct ParallelFor
+{
+    unsigned int count;
+    const function<void(unsigned int)>* body;
+    atomic<unsigned int> next;
+    atomic<unsigned int> finished;
+    mutex finishedMutex;
+    condition_variable finishedCondition;
+
+    void work()
+    {
+        while (true)
+        {
+            unsigned int index = next++;
+            if (index >= count)
+            {
+                return;
+            }
+
+            (*body)(index);
+
+            if (++finished == count)
+            {
+                lock_guard<mutex> lock(finishedMutex);
+                finishedCondition.notify_all();
+            }
+        }
+    }
+};
+
+}
+
+void WorkerPool::parallelFor(unsigned int count, const function<void(unsigned int)>& body)
+{
+    if (count == 0)
+    {
+        return;
+    }
+
+    // Helpers may not start until after we've returned, so they share ownership
+    shared_ptr<ParallelFor> state = make_shared<ParallelFor>();
+    state->count = count;
+    state->body = &body;
+    state->next = 0;
+    state->finished = 0;
+
+    unsigned int helpers = min(count - 1, m_threadCount);
+    unsigned int i;
+    for (i = 0; i < helpers; i++)
+    {
+        run([state]() { state->work(); });
+    }
+
+    state->work();
+
+    unique_lock<mutex> lock(state->finishedMutex);
+    state->finishedCondition.wait(lock, [&state]() { return state->finished == state->count; });
+}
+
+void WorkerPool::worker()
+{
+    while (true)
+    {
+        Task task;
+        {
+            unique_lock<mutex> lock(m_mutex);
+            m_condition.wait(lock, [this]() { return m_stopping || !m_tasks.empty(); });
+            if (m_tasks.empty())
+            {
+                // Only stop once everything queued has been run
+                return;
+            }
+            task = std::move(m_tasks.front());
+            m_tasks.pop_front();
+        }
+
+        task();
+    }
+}
@@ -0,0 +1,130 @@
+/*
+ * Frontier - A toolkit for creating simple OS-independent user interfaces
+ * Copyright (C) 2020 Ian Parker <ian@geekprojects.com>
+ *
+ * This file is part of Frontier.
+ *
+ * Frontier is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * Frontier is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with Frontier.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <frontier/damage.h>
+
+#include <math.h>
+
+using namespace Frontier;
+using namespace std;
+
+// Beyond this, it is cheaper to just update the bounding box
+#define DAMAGE_MAX_RECTS 16
+
+void DamageRegion::add(Rect rect)
+{
+    if (rect.isEmpty())
+    {
+        return;
+    }
+
+    // Keep merging until the Rect doesn't overlap any others
+    bool merged = true;
+    while (merged)
+    {
+        merged = false;
+        for (auto it = m_rects.begin(); it != m_rects.end(); it++)
+        {
+            if (it->contains(rect))
+            {
+                return;
+            }
+            if (it->intersects(rect))
+            {
+                rect = rect.combine(*it);
+                m_rects.erase(it);
+                merged = true;
+                break;
+            }
+        }
+    }
+
+    m_rects.push_back(rect);
+
+    if (m_rects.size() > DAMAGE_MAX_RECTS)
+    {
+        Rect bounds = getBounds();
+        m_rects.clear();
+        m_rects.push_back(bounds);
+    }
+}
+
+void DamageRegion::add(const DamageRegion& region, int dx, int dy)
+{
+    for (const Rect& rect : region.m_rects)
+    {
+        add(Rect(rect.x + dx, rect.y + dy, rect.width, rect.height));
+    }
+}
+
+void DamageRegion::clip(const Rect& bounds)
+{
+    vector<Rect> rects;
+    for (const Rect& rect : m_rects)
+    {
+        Rect clipped = rect.intersect(bounds);
+        if (!clipped.isEmpty())
+        {
+            rects.push_back(clipped);
+        }
+    }
+    m_rects = rects;
+}
+
+void DamageRegion::scale(float factor)
+{
+    if (factor == 1.0f)
+    {
+        return;
+    }
+
+    for (Rect& rect : m_rects)
+    {
+        // Round outwards so no partially covered pixels are missed
+        int x2 = (int)ceilf((float)(rect.x + rect.width) * factor);
+        int y2 = (int)ceilf((float)(rect.y + rect.height) * factor);
+        rect.x = (int)floorf((float)rect.x * factor);
+        rect.y = (int)floorf((float)rect.y * factor);
+        rect.width = x2 - rect.x;
+        rect.height = y2 - rect.y;
+    }
+}
+
+bool DamageRegion::covers(const Rect& rect) const
+{
+    for (const Rect& r : m_rects)
+    {
+        if (r.contains(rect))
+        {
+            return true;
+        }
+    }
+    return false;
+}
+
+Rect DamageRegion::getBounds() const
+{
+    Rect bounds;
+    for (const Rect& rect : m_rects)
+    {
+        bounds = bounds.combine(rect);
+    }
+    return bounds;
+}
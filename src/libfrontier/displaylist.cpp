@@ -0,0 +1,363 @@
+/*
+ * Frontier - A toolkit for creating simple OS-independent user interfaces
+ * Copyright (C) 2020 Ian Parker <ian@geekprojects.com>
+ *
+ * This file is part of Frontier.
+ *
+ * Frontier is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * Frontier is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with Frontier.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <frontier/displaylist.h>
+#include <frontier/textcache.h>
+
+using namespace std;
+using namespace Frontier;
+using namespace Geek;
+using namespace Geek::Gfx;
+
+static bool sameRect(const Frontier::Rect& a, const Frontier::Rect& b)
+{
+    return a.x == b.x && a.y == b.y && a.width == b.width && a.height == b.height;
+}
+
+bool DisplayList::Command::operator ==(const Command& other) const
+{
+    return
+        op == other.op &&
+        x == other.x &&
+        y == other.y &&
+        width == other.width &&
+        height == other.height &&
+        radius == other.radius &&
+        colour == other.colour &&
+        colour2 == other.colour2 &&
+        param == other.param &&
+        sameRect(view, other.view);
+}
+
+DisplayList::DisplayList()
+{
+    m_complete = true;
+}
+
+void DisplayList::clear()
+{
+    m_commands.clear();
+    m_text.clear();
+    m_surfaces.clear();
+    m_complete = true;
+}
+
+bool DisplayList::isSame(const DisplayList& other) const
+{
+    if (!m_complete || !other.m_complete || !m_surfaces.empty() || !other.m_surfaces.empty())
+    {
+        return false;
+    }
+
+    if (m_commands != other.m_commands || m_text.size() != other.m_text.size())
+    {
+        return false;
+    }
+
+    unsigned int i;
+    for (i = 0; i < m_text.size(); i++)
+    {
+        const TextRun& run = m_text.at(i);
+        const TextRun& otherRun = other.m_text.at(i);
+        if (run.textCache != otherRun.textCache ||
+            run.font != otherRun.font ||
+            run.text != otherRun.text ||
+            !sameRect(run.clip, otherRun.clip))
+        {
+            return false;
+        }
+    }
+    return true;
+}
+
+void DisplayList::replay(Surface* surface) const
+{
+    for (const Command& command : m_commands)
+    {
+        switch (command.op)
+        {
+            case DISPLAY_CLEAR:
+                surface->clear(command.colour);
+                break;
+
+            case DISPLAY_PIXEL:
+                surface->drawPixel(command.x, command.y, command.colour);
+                break;
+
+            case DISPLAY_LINE:
+                surface->drawLine(command.x, command.y, command.width, command.height, command.colour);
+                break;
+
+            case DISPLAY_RECT:
+                surface->drawRect(command.x, command.y, command.width, command.height, command.colour);
+                break;
+
+            case DISPLAY_RECT_FILLED:
+                surface->drawRectFilled(command.x, command.y, command.width, command.height, command.colour);
+                break;
+
+            case DISPLAY_RECT_FILLED_ROUNDED:
+                surface->drawRectFilledRounded(command.x, command.y, command.width, command.height, command.radius, command.colour);
+                break;
+
+            case DISPLAY_GRAD:
+                surface->drawGrad(command.x, command.y, command.width, command.height, command.colour, command.colour2);
+                break;
+
+            case DISPLAY_GRAD_ROUNDED:
+                surface->drawGradRounded(command.x, command.y, command.width, command.height, command.radius, command.colour, command.colour2);
+                break;
+
+            case DISPLAY_CORNER:
+                surface->drawCorner(command.x, command.y, (Corner)command.param, command.radius, command.colour);
+                break;
+
+            case DISPLAY_CIRCLE_FILLED:
+                surface->drawCircleFilled(command.x, command.y, command.radius, command.colour);
+                break;
+
+            case DISPLAY_TEXT:
+            {
+                const TextRun& run = m_text.at(command.param);
+                SurfaceViewPort viewport(surface, run.clip.x, run.clip.y, run.clip.width, run.clip.height);
+                run.textCache->write(&viewport, run.font, command.x - run.clip.x, command.y - run.clip.y, run.text, command.colour);
+            } break;
+
+            case DISPLAY_BLIT:
+                surface->blit(command.x, command.y, m_surfaces.at(command.param), command.colour != 0);
+                break;
+
+            case DISPLAY_BLIT_VIEW:
+                surface->blit(
+                    command.x, command.y,
+                    m_surfaces.at(command.param),
+                    command.view.x, command.view.y, command.view.width, command.view.height,
+                    command.colour != 0);
+                break;
+        }
+    }
+}
+
+DisplayList::Command& DisplayList::add(DisplayOp op, int32_t x, int32_t y, int32_t width, int32_t height)
+{
+    Command command;
+    command.op = op;
+    command.x = x;
+    command.y = y;
+    command.width = width;
+    command.height = height;
+    command.radius = 0;
+    command.colour = 0;
+    command.colour2 = 0;
+    command.param = 0;
+    m_commands.push_back(command);
+    return m_commands.back();
+}
+
+void DisplayList::addClear(uint32_t colour)
+{
+    add(DISPLAY_CLEAR, 0, 0).colour = colour;
+}
+
+void DisplayList::addPixel(int32_t x, int32_t y, uint32_t colour)
+{
+    add(DISPLAY_PIXEL, x, y).colour = colour;
+}
+
+void DisplayList::addLine(int32_t x1, int32_t y1, int32_t x2, int32_t y2, uint32_t colour)
+{
+    // The end point is kept in the width and height
+    add(DISPLAY_LINE, x1, y1, x2, y2).colour = colour;
+}
+
+void DisplayList::addRect(int32_t x, int32_t y, int32_t width, int32_t height, uint32_t colour)
+{
+    add(DISPLAY_RECT, x, y, width, height).colour = colour;
+}
+
+void DisplayList::addRectFilled(int32_t x, int32_t y, int32_t width, int32_t height, uint32_t colour)
+{
+    add(DISPLAY_RECT_FILLED, x, y, width, height).colour = colour;
+}
+
+void DisplayList::addRectFilledRounded(int32_t x, int32_t y, int32_t width, int32_t height, int32_t radius, uint32_t colour)
+{
+    Command& command = add(DISPLAY_RECT_FILLED_ROUNDED, x, y, width, height);
+    command.radius = radius;
+    command.colour = colour;
+}
+
+void DisplayList::addGrad(int32_t x, int32_t y, int32_t width, int32_t height, uint32_t colour1, uint32_t colour2)
+{
+    Command& command = add(DISPLAY_GRAD, x, y, width, height);
+    command.colour = colour1;
+    command.colour2 = colour2;
+}
+
+void DisplayList::addGradRounded(int32_t x, int32_t y, int32_t width, int32_t height, int32_t radius, uint32_t colour1, uint32_t colour2)
+{
+    Command& command = add(DISPLAY_GRAD_ROUNDED, x, y, width, height);
+    command.radius = radius;
+    command.colour = colour1;
+    command.colour2 = colour2;
+}
+
+void DisplayList::addCorner(int32_t x, int32_t y, Corner corner, int32_t radius, uint32_t colour)
+{
+    Command& command = add(DISPLAY_CORNER, x, y);
+    command.radius = radius;
+    command.colour = colour;
+    command.param = corner;
+}
+
+void DisplayList::addCircleFilled(int32_t x, int32_t y, int32_t radius, uint32_t colour)
+{
+    Command& command = add(DISPLAY_CIRCLE_FILLED, x, y);
+    command.radius = radius;
+    command.colour = colour;
+}
+
+void DisplayList::addText(TextCache* textCache, FontHandle* font, int32_t x, int32_t y, const wstring& text, uint32_t colour, Frontier::Rect clip)
+{
+    TextRun run;
+    run.textCache = textCache;
+    run.font = font;
+    run.text = text;
+    run.clip = clip;
+
+    Command& command = add(DISPLAY_TEXT, x, y);
+    command.colour = colour;
+    command.param = m_text.size();
+    m_text.push_back(run);
+}
+
+void DisplayList::addBlit(int32_t x, int32_t y, Surface* surface, bool forceAlpha)
+{
+    Command& command = add(DISPLAY_BLIT, x, y);
+    command.colour = forceAlpha;
+    command.param = m_surfaces.size();
+    m_surfaces.push_back(surface);
+}
+
+void DisplayList::addBlit(int32_t x, int32_t y, Surface* surface, Frontier::Rect view, bool forceAlpha)
+{
+    Command& command = add(DISPLAY_BLIT_VIEW, x, y);
+    command.colour = forceAlpha;
+    command.param = m_surfaces.size();
+    command.view = view;
+    m_surfaces.push_back(surface);
+}
+
+RecordingSurface::RecordingSurface(DisplayList* list, uint32_t width, uint32_t height, bool highDPI)
+    : Surface(1, 1, 4)
+{
+    m_list = list;
+    m_width = width;
+    m_height = height;
+    m_highDPI = highDPI;
+}
+
+RecordingSurface::~RecordingSurface() = default;
+
+RecordingSurface* RecordingSurface::getRecorder(Surface* surface)
+{
+    return dynamic_cast<RecordingSurface*>(surface->getRoot());
+}
+
+void RecordingSurface::markIncomplete(Surface* surface)
+{
+    RecordingSurface* recorder = getRecorder(surface);
+    if (recorder != NULL)
+    {
+        recorder->m_list->setIncomplete();
+    }
+}
+
+bool RecordingSurface::clear(uint32_t colour)
+{
+    m_list->addClear(colour);
+    return true;
+}
+
+bool RecordingSurface::drawPixel(int32_t x, int32_t y, uint32_t c)
+{
+    m_list->addPixel(x, y, c);
+    return true;
+}
+
+bool RecordingSurface::drawLine(int32_t x1, int32_t y1, int32_t x2, int32_t y2, uint32_t c)
+{
+    m_list->addLine(x1, y1, x2, y2, c);
+    return true;
+}
+
+bool RecordingSurface::drawRect(int32_t x, int32_t y, int32_t w, int32_t h, uint32_t c)
+{
+    m_list->addRect(x, y, w, h, c);
+    return true;
+}
+
+bool RecordingSurface::drawRectFilled(int32_t x, int32_t y, int32_t w, int32_t h, uint32_t c)
+{
+    m_list->addRectFilled(x, y, w, h, c);
+    return true;
+}
+
+bool RecordingSurface::drawRectFilledRounded(int32_t x, int32_t y, int32_t w, int32_t h, int32_t r, uint32_t c)
+{
+    m_list->addRectFilledRounded(x, y, w, h, r, c);
+    return true;
+}
+
+bool RecordingSurface::drawGrad(int32_t x, int32_t y, int32_t w, int32_t h, uint32_t c1, uint32_t c2)
+{
+    m_list->addGrad(x, y, w, h, c1, c2);
+    return true;
+}
+
+bool RecordingSurface::drawGradRounded(int32_t x, int32_t y, int32_t w, int32_t h, int32_t r, uint32_t c1, uint32_t c2)
+{
+    m_list->addGradRounded(x, y, w, h, r, c1, c2);
+    return true;
+}
+
+bool RecordingSurface::drawCorner(int32_t x, int32_t y, Corner corner, int32_t r, uint32_t c)
+{
+    m_list->addCorner(x, y, corner, r, c);
+    return true;
+}
+
+bool RecordingSurface::drawCircleFilled(int32_t x, int32_t y, int32_t r, uint32_t c)
+{
+    m_list->addCircleFilled(x, y, r, c);
+    return true;
+}
+
+bool RecordingSurface::blit(int32_t x, int32_t y, Surface* surface, bool forceAlpha)
+{
+    m_list->addBlit(x, y, surface, forceAlpha);
+    return true;
+}
+
+bool RecordingSurface::blit(int32_t x, int32_t y, Surface* surface, int32_t viewX, int32_t viewY, int32_t viewW, int32_t viewH, bool forceAlpha)
+{
+    m_list->addBlit(x, y, surface, Frontier::Rect(viewX, viewY, viewW, viewH), forceAlpha);
+    return true;
+}
@@ -29,6 +29,7 @@ using namespace Geek;
 FrontierEngine::FrontierEngine(FrontierApp* app) : Geek::Logger("FrontierEngine")
 {
     m_app = app;
+    m_dispatching = false;
 }
 
 FrontierEngine::~FrontierEngine() = default;
@@ -49,6 +50,69 @@ bool FrontierEngine::checkEvents()
     return false;
 }
 
+void FrontierEngine::wake()
+{
+}
+
+void FrontierEngine::queueEvent(const EventValue& event)
+{
+    if (!m_eventBatch.empty())
+    {
+        EventValue& last = m_eventBatch.back();
+
+        const MouseMotionEvent* motion = get_if<MouseMotionEvent>(&event);
+        MouseMotionEvent* lastMotion = get_if<MouseMotionEvent>(&last);
+        if (motion != NULL && lastMotion != NULL && motion->window == lastMotion->window)
+        {
+            // Only the latest position matters
+            lastMotion->x = motion->x;
+            lastMotion->y = motion->y;
+            return;
+        }
+
+        const MouseScrollEvent* scroll = get_if<MouseScrollEvent>(&event);
+        MouseScrollEvent* lastScroll = get_if<MouseScrollEvent>(&last);
+        if (scroll != NULL && lastScroll != NULL &&
+            scroll->window == lastScroll->window &&
+            scroll->x == lastScroll->x &&
+            scroll->y == lastScroll->y)
+        {
+            lastScroll->scrollX += scroll->scrollX;
+            lastScroll->scrollY += scroll->scrollY;
+            return;
+        }
+    }
+
+    m_eventBatch.push_back(event);
+}
+
+void FrontierEngine::dispatchEvents()
+{
+    if (m_dispatching)
+    {
+        return;
+    }
+
+    // Handling an event may cause more to be queued
+    m_dispatching = true;
+    m_dispatchBatch.swap(m_eventBatch);
+
+    m_app->beginEventBatch();
+
+    // Work handed over by other threads is treated like input
+    m_app->runTasks();
+
+    for (EventValue& value : m_dispatchBatch)
+    {
+        Event* event = getEvent(value);
+        event->window->handleEvent(event);
+    }
+    m_app->endEventBatch();
+
+    m_dispatchBatch.clear();
+    m_dispatching = false;
+}
+
 bool FrontierEngine::quit(bool force)
 {
     log(WARN, "quit: Quit requested");
@@ -52,6 +52,7 @@ class CocoaEngine : public FrontierEngine
     virtual bool initWindow(FrontierWindow* window);
 
     virtual bool checkEvents();
+    virtual void wake();
 
     virtual bool quit(bool force = false);
 
@@ -101,6 +101,15 @@ bool CocoaEngine::checkEvents()
     return run();
 }
 
+void CocoaEngine::wake()
+{
+    // NSApp's run loop is in charge, so ask it to run any posted Tasks
+    dispatch_async(dispatch_get_main_queue(), ^{
+        dispatchEvents();
+        m_app->getFrameScheduler()->runFrames();
+    });
+}
+
 bool CocoaEngine::quit(bool force)
 {
     NSApplication* app = (NSApplication*)m_application;
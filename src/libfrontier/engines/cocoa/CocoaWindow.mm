@@ -94,8 +94,8 @@ using namespace Geek;
 - (void)keyUp:(NSEvent *)theEvent;
 - (void)keyDown:(NSEvent *)theEvent;
 
-- (Frontier::KeyEvent*)createKeyEvent:(NSEvent*)event;
-- (Frontier::MouseButtonEvent*)createMouseButtonEvent:(NSEvent*)event;
+- (Frontier::KeyEvent)createKeyEvent:(NSEvent*)event;
+- (Frontier::MouseButtonEvent)createMouseButtonEvent:(NSEvent*)event;
 
 - (void)setCursor:(NSCursor*)cursor;
 - (void)resetCursorRects;
@@ -147,11 +147,11 @@ using namespace Geek;
 {
     CocoaNSWindow* window = (CocoaNSWindow*)[theEvent window];
 
-    Frontier::MouseButtonEvent* event = [self createMouseButtonEvent: theEvent];
-    event->direction = true;
+    Frontier::MouseButtonEvent event = [self createMouseButtonEvent: theEvent];
+    event.direction = true;
 
     CocoaWindow* cwindow = [window getEngineWindow];
-    cwindow->getWindow()->handleEvent(event);
+    cwindow->getWindow()->handleEvent(&event);
 
 }
 
@@ -159,11 +159,11 @@ using namespace Geek;
 {
     CocoaNSWindow* window = (CocoaNSWindow*)[theEvent window];
 
-    Frontier::MouseButtonEvent* event = [self createMouseButtonEvent: theEvent];
-    event->direction = false;
+    Frontier::MouseButtonEvent event = [self createMouseButtonEvent: theEvent];
+    event.direction = false;
 
     CocoaWindow* cwindow = [window getEngineWindow];
-    cwindow->getWindow()->handleEvent(event);
+    cwindow->getWindow()->handleEvent(&event);
 }
 
 - (void)touchesBeganWithEvent:(NSEvent *)theEvent
@@ -173,16 +173,16 @@ using namespace Geek;
     if (count == 2)
     {
         printf("touchesBeganWithEvent: TWO FINGERS\n");
-        Frontier::MouseButtonEvent* event = [self createMouseButtonEvent: theEvent];
-        event->direction = false;
+        Frontier::MouseButtonEvent event = [self createMouseButtonEvent: theEvent];
+        event.direction = false;
 
         CocoaNSWindow* window = (CocoaNSWindow*)[theEvent window];
         CocoaWindow* cwindow = [window getEngineWindow];
-        cwindow->getWindow()->handleEvent(event);
+        cwindow->getWindow()->handleEvent(&event);
     }
 }
 
-- (Frontier::MouseButtonEvent*)createMouseButtonEvent:(NSEvent*)theEvent
+- (Frontier::MouseButtonEvent)createMouseButtonEvent:(NSEvent*)theEvent
 {
     NSPoint pos = [theEvent locationInWindow];
 
@@ -207,14 +207,14 @@ using namespace Geek;
         }
     }
 
-    Frontier::MouseButtonEvent* event = new Frontier::MouseButtonEvent();
-    event->eventType = FRONTIER_EVENT_MOUSE_BUTTON;
-    event->buttons = button;
-    event->doubleClick = clickCount == 2;
+    Frontier::MouseButtonEvent event;
+    event.eventType = FRONTIER_EVENT_MOUSE_BUTTON;
+    event.buttons = button;
+    event.doubleClick = clickCount == 2;
 
     int height = [self frame].size.height;
-    event->x = (int)pos.x;
-    event->y = height - (int)pos.y;
+    event.x = (int)pos.x;
+    event.y = height - (int)pos.y;
 
     return event;
 }
@@ -225,15 +225,15 @@ using namespace Geek;
 
     NSPoint pos = [theEvent locationInWindow];
 
-    Frontier::MouseMotionEvent* event = new Frontier::MouseMotionEvent();
-    event->eventType = FRONTIER_EVENT_MOUSE_MOTION;
+    Frontier::MouseMotionEvent event;
+    event.eventType = FRONTIER_EVENT_MOUSE_MOTION;
 
     int height = [self frame].size.height;
-    event->x = (int)pos.x;
-    event->y = height - (int)pos.y;
+    event.x = (int)pos.x;
+    event.y = height - (int)pos.y;
 
     CocoaWindow* cwindow = [window getEngineWindow];
-    cwindow->getWindow()->handleEvent(event);
+    cwindow->getWindow()->handleEvent(&event);
 }
 
 - (void)mouseDragged:(NSEvent *)theEvent
@@ -242,15 +242,15 @@ using namespace Geek;
 
     NSPoint pos = [theEvent locationInWindow];
 
-    Frontier::MouseMotionEvent* event = new Frontier::MouseMotionEvent();
-    event->eventType = FRONTIER_EVENT_MOUSE_MOTION;
+    Frontier::MouseMotionEvent event;
+    event.eventType = FRONTIER_EVENT_MOUSE_MOTION;
 
     int height = [self frame].size.height;
-    event->x = (int)pos.x;
-    event->y = height - (int)pos.y;
+    event.x = (int)pos.x;
+    event.y = height - (int)pos.y;
 
     CocoaWindow* cwindow = [window getEngineWindow];
-    cwindow->getWindow()->handleEvent(event);
+    cwindow->getWindow()->handleEvent(&event);
 }
 
 - (void)mouseEntered:(NSEvent *)theEvent
@@ -277,40 +277,40 @@ using namespace Geek;
     NSLog(@"scrollWheel: scroll: %0.2f, %0.2f  hasPreciseScrollingDeltas=%d\n", scrollX, scrollY, hasPreciseScrollingDeltas);
 #endif
 
-    Frontier::MouseScrollEvent* event = new Frontier::MouseScrollEvent();
-    event->eventType = FRONTIER_EVENT_MOUSE_SCROLL;
+    Frontier::MouseScrollEvent event;
+    event.eventType = FRONTIER_EVENT_MOUSE_SCROLL;
 
     int height = [self frame].size.height;
-    event->x = (int)pos.x;
-    event->y = height - (int)pos.y;
-    event->scrollX = (int)scrollX;
-    event->scrollY = (int)scrollY;
+    event.x = (int)pos.x;
+    event.y = height - (int)pos.y;
+    event.scrollX = (int)scrollX;
+    event.scrollY = (int)scrollY;
 
     CocoaWindow* cwindow = [window getEngineWindow];
-    cwindow->getWindow()->handleEvent(event);
+    cwindow->getWindow()->handleEvent(&event);
 }
 
 - (void)keyUp:(NSEvent *)theEvent
 {
-    Frontier::KeyEvent* event = [self createKeyEvent: theEvent];
-    event->direction = false;
+    Frontier::KeyEvent event = [self createKeyEvent: theEvent];
+    event.direction = false;
 
     CocoaNSWindow* window = (CocoaNSWindow*)[theEvent window];
     CocoaWindow* cwindow = [window getEngineWindow];
-    cwindow->getWindow()->handleEvent(event);
+    cwindow->getWindow()->handleEvent(&event);
 }
 
 - (void)keyDown:(NSEvent *)theEvent
 {
-    Frontier::KeyEvent* event = [self createKeyEvent: theEvent];
-    event->direction = true;
+    Frontier::KeyEvent event = [self createKeyEvent: theEvent];
+    event.direction = true;
 
     CocoaNSWindow* window = (CocoaNSWindow*)[theEvent window];
     CocoaWindow* cwindow = [window getEngineWindow];
-    cwindow->getWindow()->handleEvent(event);
+    cwindow->getWindow()->handleEvent(&event);
 }
 
-- (Frontier::KeyEvent*)createKeyEvent:(NSEvent*)theEvent
+- (Frontier::KeyEvent)createKeyEvent:(NSEvent*)theEvent
 {
     uint16_t keyCode = [theEvent keyCode];
     NSString* chars = [theEvent characters];
@@ -318,12 +318,12 @@ using namespace Geek;
 
     std::string wchars = std::string([chars UTF8String], [chars lengthOfBytesUsingEncoding:NSUTF8StringEncoding]);
 
-    Frontier::KeyEvent* event = new Frontier::KeyEvent();
-    event->eventType = FRONTIER_EVENT_KEY;
+    Frontier::KeyEvent event;
+    event.eventType = FRONTIER_EVENT_KEY;
 
     if (wchars.length() > 0)
     {
-        event->key = wchars.at(0);
+        event.key = wchars.at(0);
     }
 
     unsigned int c = 0;
@@ -331,7 +331,7 @@ using namespace Geek;
     {
         c = wchars.at(0);
     }
-    event->chr = c;
+    event.chr = c;
 
     if (wchars.length() > 0 && c != 0xffffffef && !iscntrl(c))
     {
@@ -344,37 +344,37 @@ using namespace Geek;
             NSLog(@"createKeyMessage: keyCode=0x%x, chars=0x%x", keyCode, c);
         }
 
-        event->key = toupper(c);
+        event.key = toupper(c);
     }
     else if (keyCode < 128)
     {
-        event->key = g_darwinKeyCodeMap[keyCode];
+        event.key = g_darwinKeyCodeMap[keyCode];
     }
     else
     {
-        event->key = KC_UNKNOWN;
+        event.key = KC_UNKNOWN;
     }
 
-    event->modifiers = 0;
+    event.modifiers = 0;
     if (modifierFlags & NSEventModifierFlagCapsLock)
     {
-        event->modifiers |= KMOD_CAPS_LOCK;
+        event.modifiers |= KMOD_CAPS_LOCK;
     }
     if (modifierFlags & NSEventModifierFlagShift)
     {
-        event->modifiers |= KMOD_SHIFT;
+        event.modifiers |= KMOD_SHIFT;
     }
     if (modifierFlags & NSEventModifierFlagControl)
     {
-        event->modifiers |= KMOD_CONTROL;
+        event.modifiers |= KMOD_CONTROL;
     }
     if (modifierFlags & NSEventModifierFlagOption)
     {
-        event->modifiers |= KMOD_ALT;
+        event.modifiers |= KMOD_ALT;
     }
     if (modifierFlags & NSEventModifierFlagCommand)
     {
-        event->modifiers |= KMOD_COMMAND;
+        event.modifiers |= KMOD_COMMAND;
     }
 
     return event;
@@ -49,6 +49,9 @@ bool EmbeddedEngine::initWindow(FrontierWindow* window)
 
 bool EmbeddedEngine::checkEvents()
 {
+    // The host app delivers events, but posted Tasks and requested frames are still handled here
+    dispatchEvents();
+    m_app->getFrameScheduler()->runFrames();
     return true;
 }
 
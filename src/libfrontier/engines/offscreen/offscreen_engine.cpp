@@ -0,0 +1,215 @@
+/*
+ * Frontier - A toolkit for creating simple OS-independent user interfaces
+ * Copyright (C) 2020 Ian Parker <ian@geekprojects.com>
+ *
+ * This file is part of Frontier.
+ *
+ * Frontier is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * Frontier is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with Frontier.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+
+#include <frontier/frontier.h>
+#include <frontier/engines/offscreen.h>
+
+using namespace std;
+using namespace Frontier;
+using namespace Geek;
+
+OffscreenEngine::OffscreenEngine(FrontierApp* app) : FrontierEngine(app)
+{
+    m_scaleFactor = 1.0;
+    m_eventMutex = Thread::createMutex();
+
+    m_mouseX = 0;
+    m_mouseY = 0;
+}
+
+OffscreenEngine::~OffscreenEngine() = default;
+
+bool OffscreenEngine::init()
+{
+    return true;
+}
+
+bool OffscreenEngine::initWindow(FrontierWindow* window)
+{
+    OffscreenWindow* ow = new OffscreenWindow(this, window);
+    ow->init();
+    window->setEngineWindow(ow);
+    m_windows.push_back(ow);
+
+    return true;
+}
+
+bool OffscreenEngine::checkEvents()
+{
+    // Take the whole queue, events may inject more as they're handled
+    m_eventMutex->lock();
+    m_checkEvents.swap(m_events);
+    m_eventMutex->unlock();
+
+    for (const EventValue& event : m_checkEvents)
+    {
+        queueEvent(event);
+    }
+    m_checkEvents.clear();
+    dispatchEvents();
+
+    // There's no display to keep pace with, so produce any frames straight away
+    m_app->getFrameScheduler()->runFrames(true);
+
+    return true;
+}
+
+std::string OffscreenEngine::getConfigDir()
+{
+    return string("/tmp");
+}
+
+void OffscreenEngine::message(std::string title, std::string message)
+{
+}
+
+bool OffscreenEngine::confirmBox(std::string title, std::string message)
+{
+    return true;
+}
+
+std::string OffscreenEngine::chooseFile(int flags, std::string path, std::string pattern)
+{
+    return string("/tmp/test.txt");
+}
+
+OffscreenWindow* OffscreenEngine::getWindow(FrontierWindow* window)
+{
+    for (OffscreenWindow* ow : m_windows)
+    {
+        if (ow->getWindow() == window)
+        {
+            return ow;
+        }
+    }
+    return NULL;
+}
+
+void OffscreenEngine::removeWindow(OffscreenWindow* window)
+{
+    vector<OffscreenWindow*>::iterator it;
+    for (it = m_windows.begin(); it != m_windows.end(); ++it)
+    {
+        if (*it == window)
+        {
+            m_windows.erase(it);
+            break;
+        }
+    }
+
+    // Don't deliver events to a window that has gone
+    m_eventMutex->lock();
+    vector<EventValue>::iterator eventIt;
+    for (eventIt = m_events.begin(); eventIt != m_events.end(); )
+    {
+        if (getEvent(*eventIt)->window == window->getWindow())
+        {
+            eventIt = m_events.erase(eventIt);
+        }
+        else
+        {
+            ++eventIt;
+        }
+    }
+    m_eventMutex->unlock();
+}
+
+void OffscreenEngine::injectEvent(FrontierWindow* window, EventValue event)
+{
+    getEvent(event)->window = window;
+
+    m_eventMutex->lock();
+    m_events.push_back(event);
+    m_eventMutex->unlock();
+}
+
+bool OffscreenEngine::hasPendingEvents()
+{
+    m_eventMutex->lock();
+    bool pending = !m_events.empty();
+    m_eventMutex->unlock();
+    return pending;
+}
+
+void OffscreenEngine::injectMouseMotion(FrontierWindow* window, uint32_t x, uint32_t y)
+{
+    MouseMotionEvent mouseMotionEvent;
+    mouseMotionEvent.eventType = FRONTIER_EVENT_MOUSE_MOTION;
+    mouseMotionEvent.x = x;
+    mouseMotionEvent.y = y;
+    injectEvent(window, mouseMotionEvent);
+
+    m_mouseX = x;
+    m_mouseY = y;
+}
+
+void OffscreenEngine::injectMouseButton(FrontierWindow* window, uint32_t x, uint32_t y, int buttons, bool direction, bool doubleClick)
+{
+    MouseButtonEvent mouseButtonEvent;
+    mouseButtonEvent.eventType = FRONTIER_EVENT_MOUSE_BUTTON;
+    mouseButtonEvent.direction = direction;
+    mouseButtonEvent.buttons = buttons;
+    mouseButtonEvent.doubleClick = doubleClick;
+    mouseButtonEvent.x = x;
+    mouseButtonEvent.y = y;
+    injectEvent(window, mouseButtonEvent);
+
+    m_mouseX = x;
+    m_mouseY = y;
+}
+
+void OffscreenEngine::injectClick(FrontierWindow* window, uint32_t x, uint32_t y, int buttons)
+{
+    injectMouseMotion(window, x, y);
+    injectMouseButton(window, x, y, buttons, true);
+    injectMouseButton(window, x, y, buttons, false);
+}
+
+void OffscreenEngine::injectMouseScroll(FrontierWindow* window, int32_t scrollX, int32_t scrollY)
+{
+    MouseScrollEvent mouseScrollEvent;
+    mouseScrollEvent.eventType = FRONTIER_EVENT_MOUSE_SCROLL;
+    mouseScrollEvent.x = m_mouseX;
+    mouseScrollEvent.y = m_mouseY;
+    mouseScrollEvent.scrollX = scrollX;
+    mouseScrollEvent.scrollY = scrollY;
+    injectEvent(window, mouseScrollEvent);
+}
+
+void OffscreenEngine::injectKey(FrontierWindow* window, uint32_t key, wchar_t chr, bool direction, uint32_t modifiers)
+{
+    KeyEvent keyEvent;
+    keyEvent.eventType = FRONTIER_EVENT_KEY;
+    keyEvent.direction = direction;
+    keyEvent.key = key;
+    keyEvent.chr = chr;
+    keyEvent.modifiers = modifiers;
+    injectEvent(window, keyEvent);
+}
+
+void OffscreenEngine::injectText(FrontierWindow* window, std::wstring text)
+{
+    for (wchar_t c : text)
+    {
+        injectKey(window, c, c, true);
+        injectKey(window, c, c, false);
+    }
+}
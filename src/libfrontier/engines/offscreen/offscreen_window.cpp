@@ -0,0 +1,158 @@
+/*
+ * Frontier - A toolkit for creating simple OS-independent user interfaces
+ * Copyright (C) 2020 Ian Parker <ian@geekprojects.com>
+ *
+ * This file is part of Frontier.
+ *
+ * Frontier is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * Frontier is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with Frontier.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+
+#include <frontier/frontier.h>
+#include <frontier/engines/offscreen.h>
+
+#include <string.h>
+
+using namespace std;
+using namespace Frontier;
+using namespace Geek;
+using namespace Geek::Gfx;
+
+OffscreenWindow::OffscreenWindow(Frontier::FrontierEngine* engine, Frontier::FrontierWindow* window)
+    : FrontierEngineWindow(engine, window)
+{
+    m_position.x = 0;
+    m_position.y = 0;
+    m_visible = false;
+
+    m_frame = NULL;
+    m_frameCount = 0;
+    m_updateRequested = false;
+}
+
+OffscreenWindow::~OffscreenWindow()
+{
+    ((OffscreenEngine*)m_engine)->removeWindow(this);
+
+    if (m_frame != NULL)
+    {
+        delete m_frame;
+    }
+}
+
+bool OffscreenWindow::init()
+{
+    return true;
+}
+
+void OffscreenWindow::show()
+{
+    m_visible = true;
+}
+
+void OffscreenWindow::hide()
+{
+    m_visible = false;
+}
+
+bool OffscreenWindow::update()
+{
+    Surface* surface = m_window->getSurface();
+    if (surface == NULL || surface->getData() == NULL)
+    {
+        return true;
+    }
+
+    float scale = getScaleFactor();
+    Size winSize = m_window->getSize();
+    unsigned int width = (unsigned int)((float)winSize.width * scale);
+    unsigned int height = (unsigned int)((float)winSize.height * scale);
+
+    // Only copy the areas that have changed, as a real window would present them
+    vector<Frontier::Rect> rects = m_window->getDamage().getRects();
+    if (m_frame == NULL || m_frame->getWidth() != width || m_frame->getHeight() != height)
+    {
+        if (m_frame != NULL)
+        {
+            delete m_frame;
+        }
+        m_frame = new Surface(width, height, 4);
+        rects.clear();
+    }
+    if (rects.empty())
+    {
+        rects.push_back(Frontier::Rect(0, 0, width, height));
+    }
+
+    ProfileScope scope(m_window->getApp()->getProfiler(), PROFILE_PRESENT, "OffscreenWindow::update");
+
+    uint8_t* frameData = m_frame->getData();
+    uint8_t* surfaceData = surface->getData();
+    int frameStride = m_frame->getStride();
+    int surfaceStride = surface->getStride();
+
+    // The window's Surface may not have caught up with its size, so don't read past either
+    Frontier::Rect frameRect(0, 0, width, height);
+    Frontier::Rect surfaceRect(0, 0, surface->getWidth(), surface->getHeight());
+    m_presentedRects.clear();
+    for (Frontier::Rect rect : rects)
+    {
+        rect = rect.intersect(frameRect).intersect(surfaceRect);
+        if (rect.width <= 0 || rect.height <= 0)
+        {
+            continue;
+        }
+
+        m_presentedRects.push_back(rect);
+        for (int y = rect.y; y < rect.y + rect.height; y++)
+        {
+            memcpy(
+                frameData + (y * frameStride) + (rect.x * 4),
+                surfaceData + (y * surfaceStride) + (rect.x * 4),
+                rect.width * 4);
+        }
+    }
+
+    m_frameCount++;
+
+    return true;
+}
+
+float OffscreenWindow::getScaleFactor()
+{
+    return ((OffscreenEngine*)m_engine)->getScaleFactor();
+}
+
+void OffscreenWindow::requestUpdate()
+{
+    m_updateRequested = true;
+}
+
+bool OffscreenWindow::takeUpdateRequest()
+{
+    bool requested = m_updateRequested;
+    m_updateRequested = false;
+    return requested;
+}
+
+bool OffscreenWindow::saveFrame(std::string path)
+{
+    if (m_frame == NULL)
+    {
+        log(ERROR, "saveFrame: No frame has been presented");
+        return false;
+    }
+
+    return m_frame->savePNG(path);
+}
@@ -29,9 +29,8 @@ using namespace Frontier;
 
 FrontierEngineSDL::FrontierEngineSDL(FrontierApp* app) : FrontierEngine(app)
 {
-    m_lastMotion = 0;
     m_lastText = "";
-    m_keyDownEvent = NULL;
+    m_hasKeyDownEvent = false;
 }
 
 FrontierEngineSDL::~FrontierEngineSDL()
@@ -175,9 +174,45 @@ static FrontierEngineWindowSDL* getWindow(uint32_t id)
 
 bool FrontierEngineSDL::checkEvents()
 {
+    FrameScheduler* scheduler = m_app->getFrameScheduler();
+
+    // Sleep until there is input or a frame is due
     SDL_Event event;
-    SDL_WaitEvent(&event);
+    int hasEvent;
+    int timeout = scheduler->getTimeout();
+    if (timeout < 0)
+    {
+        hasEvent = SDL_WaitEvent(&event);
+    }
+    else
+    {
+        hasEvent = SDL_WaitEventTimeout(&event, timeout);
+    }
+
+    // Handle everything that is waiting, so input can be merged and only causes one update
+    bool running = true;
+    if (hasEvent)
+    {
+        do
+        {
+            if (!handleSDLEvent(event))
+            {
+                running = false;
+                break;
+            }
+        }
+        while (SDL_PollEvent(&event));
+    }
+
+    // Input is handled before any frames are produced
+    dispatchEvents();
+    scheduler->runFrames();
 
+    return running;
+}
+
+bool FrontierEngineSDL::handleSDLEvent(SDL_Event& event)
+{
     switch (event.type)
     {
         case SDL_QUIT:
@@ -202,26 +237,27 @@ bool FrontierEngineSDL::checkEvents()
                 return true;
             }
 
-            MouseButtonEvent* mouseButtonEvent = new MouseButtonEvent();
-            mouseButtonEvent->eventType = FRONTIER_EVENT_MOUSE_BUTTON;
-            mouseButtonEvent->direction = (event.button.type == SDL_MOUSEBUTTONDOWN);
+            MouseButtonEvent mouseButtonEvent;
+            mouseButtonEvent.eventType = FRONTIER_EVENT_MOUSE_BUTTON;
+            mouseButtonEvent.direction = (event.button.type == SDL_MOUSEBUTTONDOWN);
 
-            mouseButtonEvent->buttons = 0;
+            mouseButtonEvent.buttons = 0;
             if (event.button.button == SDL_BUTTON_LEFT)
             {
-                mouseButtonEvent->buttons = BUTTON_LEFT;
+                mouseButtonEvent.buttons = BUTTON_LEFT;
             }
             else if (event.button.button == SDL_BUTTON_RIGHT)
             {
-                mouseButtonEvent->buttons = BUTTON_RIGHT;
+                mouseButtonEvent.buttons = BUTTON_RIGHT;
             }
 
-            mouseButtonEvent->doubleClick = (event.button.clicks == 2);
+            mouseButtonEvent.doubleClick = (event.button.clicks == 2);
 
-            mouseButtonEvent->x = event.button.x;
-            mouseButtonEvent->y = event.button.y;
-            log(DEBUG, "checkEvents: few=%p, x=%d, y=%d", few, mouseButtonEvent->x, mouseButtonEvent->y);
-            few->getWindow()->handleEvent(mouseButtonEvent);
+            mouseButtonEvent.x = event.button.x;
+            mouseButtonEvent.y = event.button.y;
+            mouseButtonEvent.window = few->getWindow();
+            log(DEBUG, "checkEvents: few=%p, x=%d, y=%d", few, mouseButtonEvent.x, mouseButtonEvent.y);
+            queueEvent(mouseButtonEvent);
             m_lastMouseX = event.button.x;
             m_lastMouseY = event.button.y;
         } break;
@@ -234,15 +270,16 @@ bool FrontierEngineSDL::checkEvents()
                 return true;
             }
 
-            Frontier::MouseScrollEvent* mouseScrollEvent = new Frontier::MouseScrollEvent();
-            mouseScrollEvent->eventType = FRONTIER_EVENT_MOUSE_SCROLL;
+            Frontier::MouseScrollEvent mouseScrollEvent;
+            mouseScrollEvent.eventType = FRONTIER_EVENT_MOUSE_SCROLL;
 
-            mouseScrollEvent->x = m_lastMouseX;
-            mouseScrollEvent->y = m_lastMouseY;
-            mouseScrollEvent->scrollX = event.wheel.x * 2;
-            mouseScrollEvent->scrollY = event.wheel.y * 2;
+            mouseScrollEvent.x = m_lastMouseX;
+            mouseScrollEvent.y = m_lastMouseY;
+            mouseScrollEvent.scrollX = event.wheel.x * 2;
+            mouseScrollEvent.scrollY = event.wheel.y * 2;
+            mouseScrollEvent.window = few->getWindow();
 
-            few->getWindow()->handleEvent(mouseScrollEvent);
+            queueEvent(mouseScrollEvent);
 
         } break;
 
@@ -256,119 +293,114 @@ bool FrontierEngineSDL::checkEvents()
                 return true;
             }
 
-            MouseButtonEvent* mouseButtonEvent = new MouseButtonEvent();
-            mouseButtonEvent->eventType = FRONTIER_EVENT_MOUSE_BUTTON;
-            mouseButtonEvent->direction = (event.tfinger.type == SDL_FINGERDOWN);
+            MouseButtonEvent mouseButtonEvent;
+            mouseButtonEvent.eventType = FRONTIER_EVENT_MOUSE_BUTTON;
+            mouseButtonEvent.direction = (event.tfinger.type == SDL_FINGERDOWN);
 
-            mouseButtonEvent->buttons = BUTTON_LEFT;
+            mouseButtonEvent.buttons = BUTTON_LEFT;
 
-            mouseButtonEvent->x = (uint32_t)(event.tfinger.x * (float)few->getWindow()->getSize().width);
-            mouseButtonEvent->y = (uint32_t)(event.tfinger.y * (float)few->getWindow()->getSize().height);
-            log(DEBUG, "checkEvents: SDL_FINGERx: few=%p, %0.2f, %0.2f -> x=%d, y=%d", few, event.tfinger.x, event.tfinger.y, mouseButtonEvent->x, mouseButtonEvent->y);
-            few->getWindow()->handleEvent(mouseButtonEvent);
+            mouseButtonEvent.x = (uint32_t)(event.tfinger.x * (float)few->getWindow()->getSize().width);
+            mouseButtonEvent.y = (uint32_t)(event.tfinger.y * (float)few->getWindow()->getSize().height);
+            mouseButtonEvent.window = few->getWindow();
+            log(DEBUG, "checkEvents: SDL_FINGERx: few=%p, %0.2f, %0.2f -> x=%d, y=%d", few, event.tfinger.x, event.tfinger.y, mouseButtonEvent.x, mouseButtonEvent.y);
+            queueEvent(mouseButtonEvent);
 
-            m_lastMouseX = mouseButtonEvent->x;
-            m_lastMouseY = mouseButtonEvent->y;
+            m_lastMouseX = mouseButtonEvent.x;
+            m_lastMouseY = mouseButtonEvent.y;
         } break;
 #endif
 
         case SDL_MOUSEMOTION:
         {
-            uint32_t now = SDL_GetTicks();
-            if (((now - event.motion.timestamp) > 50) && ((event.motion.timestamp - m_lastMotion) < 100))
-            {
-                log(DEBUG, "checkEvents: SDL_MOUSEMOTION: Ignoring!");
-                // It has been too long, ignore
-                return true;
-            }
-
             FrontierEngineWindowSDL* few = getWindow(event.motion.windowID);
             if (few == NULL)
             {
                 return true;
             }
 
-            m_lastMotion = event.motion.timestamp;
-
-            MouseMotionEvent* mouseMotionEvent = new MouseMotionEvent();
-            mouseMotionEvent->eventType = FRONTIER_EVENT_MOUSE_MOTION;
-            mouseMotionEvent->x = event.button.x;
-            mouseMotionEvent->y = event.button.y;
+            // Consecutive motion is merged by queueEvent
+            MouseMotionEvent mouseMotionEvent;
+            mouseMotionEvent.eventType = FRONTIER_EVENT_MOUSE_MOTION;
+            mouseMotionEvent.x = event.motion.x;
+            mouseMotionEvent.y = event.motion.y;
+            mouseMotionEvent.window = few->getWindow();
 
-            few->getWindow()->handleEvent(mouseMotionEvent);
+            queueEvent(mouseMotionEvent);
         } break;
 
         case SDL_KEYDOWN:
         case SDL_KEYUP:
         {
-            KeyEvent* keyEvent = new KeyEvent();
-            keyEvent->eventType = FRONTIER_EVENT_KEY;
-            keyEvent->direction = (event.type == SDL_KEYDOWN);
+            KeyEvent keyEvent;
+            keyEvent.eventType = FRONTIER_EVENT_KEY;
+            keyEvent.direction = (event.type == SDL_KEYDOWN);
 
             map<uint32_t, uint32_t>::iterator it = m_keycodeTable.find(event.key.keysym.sym);
             if (it != m_keycodeTable.end())
             {
 
-                keyEvent->key = it->second;
-                keyEvent->chr = 0;
+                keyEvent.key = it->second;
+                keyEvent.chr = 0;
                 if (!(event.key.keysym.sym & SDLK_SCANCODE_MASK) && iswprint(event.key.keysym.sym))
                 {
-                    keyEvent->chr = event.key.keysym.sym;
+                    keyEvent.chr = event.key.keysym.sym;
                 }
 
-                keyEvent->modifiers = 0;
+                keyEvent.modifiers = 0;
                 if (event.key.keysym.mod & KMOD_LSHIFT)
                 {
-                    keyEvent->modifiers |= KeyModifier::KMOD_SHIFT_L;
+                    keyEvent.modifiers |= KeyModifier::KMOD_SHIFT_L;
                 }
                 if (event.key.keysym.mod & KMOD_RSHIFT)
                 {
-                    keyEvent->modifiers |= KeyModifier::KMOD_SHIFT_R;
+                    keyEvent.modifiers |= KeyModifier::KMOD_SHIFT_R;
                 }
 
-                if (keyEvent->modifiers & (KeyModifier::KMOD_SHIFT_L | KeyModifier::KMOD_SHIFT_R))
+                if (keyEvent.modifiers & (KeyModifier::KMOD_SHIFT_L | KeyModifier::KMOD_SHIFT_R))
                 {
-                    //keyEvent->chr = toupper(keyEvent->chr);
+                    //keyEvent.chr = toupper(keyEvent.chr);
                 }
 
-                if (event.type == SDL_KEYUP || (keyEvent->chr == 0))
+                if (event.type == SDL_KEYUP || (keyEvent.chr == 0))
                 {
                     FrontierEngineWindowSDL* few = getWindow(event.key.windowID);
-                    few->getWindow()->handleEvent(keyEvent);
+                    keyEvent.window = few->getWindow();
+                    queueEvent(keyEvent);
                     m_lastText = "";
                 }
                 else if (event.type == SDL_KEYDOWN)
                 {
                     m_keyDownEvent = keyEvent;
+                    m_hasKeyDownEvent = true;
                 }
             }
         } break;
 
         case SDL_TEXTINPUT:
         {
-            if (m_keyDownEvent != NULL)
+            if (m_hasKeyDownEvent)
             {
                 log(DEBUG,
                     "checkEvents: SDL_TEXTINPUT: Sending DOWN: chr=%s, key=0x%x, mod=0x%x",
                     event.text.text,
-                    m_keyDownEvent->key,
-                    m_keyDownEvent->modifiers);
+                    m_keyDownEvent.key,
+                    m_keyDownEvent.modifiers);
                 m_lastText = string(event.text.text);
 
-                KeyEvent* eventCopy = new KeyEvent();
-                *eventCopy = *m_keyDownEvent;
+                KeyEvent eventCopy = m_keyDownEvent;
                 if (m_lastText.length() > 0)
                 {
-                    eventCopy->chr = m_lastText.at(0);
+                    eventCopy.chr = m_lastText.at(0);
                 }
 
                 FrontierEngineWindowSDL* few = getWindow(event.key.windowID);
-                few->getWindow()->handleEvent(eventCopy);
-                m_keyDownEvent = NULL;
+                eventCopy.window = few->getWindow();
+                queueEvent(eventCopy);
+                m_hasKeyDownEvent = false;
             }
             else
             {
-                log(DEBUG, "checkEvents: SDL_TEXTINPUT: m_keyDownEvent is NULL");
+                log(DEBUG, "checkEvents: SDL_TEXTINPUT: No key down");
             }
         } break;
 
@@ -378,6 +410,9 @@ bool FrontierEngineSDL::checkEvents()
 
         case SDL_WINDOWEVENT:
         {
+            // Deliver any input that came before this first
+            dispatchEvents();
+
             FrontierEngineWindowSDL* few = getWindow(event.window.windowID);
 
             switch (event.window.event)
@@ -391,7 +426,6 @@ bool FrontierEngineSDL::checkEvents()
 
                 case SDL_WINDOWEVENT_RESIZED:
                     few->getWindow()->setSize(Size(event.window.data1, event.window.data2));
-                    few->getWindow()->update();
                     log(DEBUG, "checkEvents: SDL_WINDOWEVENT_RESIZED");
                     break;
 
@@ -402,7 +436,7 @@ bool FrontierEngineSDL::checkEvents()
                 case SDL_WINDOWEVENT_SHOWN:
                 case SDL_WINDOWEVENT_EXPOSED:
                     log(DEBUG, "checkEvents: SDL_WINDOWEVENT: Forcing update");
-                    few->getWindow()->update(true);
+                    m_app->getFrameScheduler()->requestFrame(few->getWindow(), true);
                     break;
 
                 case SDL_WINDOWEVENT_FOCUS_GAINED:
@@ -426,8 +460,8 @@ bool FrontierEngineSDL::checkEvents()
         default:
             if (event.type == m_redrawWindowEvent)
             {
-                FrontierEngineWindowSDL* few = (FrontierEngineWindowSDL*)(event.user.data1);
-                few->getWindow()->update(true);
+                // The Window has already asked the FrameScheduler for a frame, or a Task
+                // has been posted. This just woke us up
             }
             else
             {
@@ -462,3 +496,8 @@ void FrontierEngineSDL::requestUpdate(FrontierEngineWindowSDL* window)
     SDL_PushEvent(&event);
 }
 
+void FrontierEngineSDL::wake()
+{
+    // SDL_PushEvent is safe to call from any thread
+    requestUpdate(NULL);
+}
@@ -54,15 +54,17 @@ class FrontierEngineSDL : public Frontier::FrontierEngine
 
     std::map<uint32_t, uint32_t> m_keycodeTable;
 
-    int m_lastMotion;
     int m_lastMouseX;
     int m_lastMouseY;
     std::string m_lastText;
     
-    Frontier::KeyEvent* m_keyDownEvent;
+    Frontier::KeyEvent m_keyDownEvent;
+    bool m_hasKeyDownEvent;
 
     uint32_t m_redrawWindowEvent;
 
+    bool handleSDLEvent(SDL_Event& event);
+
  public:
     FrontierEngineSDL(Frontier::FrontierApp* app);
     virtual ~FrontierEngineSDL();
@@ -73,6 +75,7 @@ class FrontierEngineSDL : public Frontier::FrontierEngine
     bool quit(bool force = false);
 
     virtual bool checkEvents();
+    void wake() override;
 
     void requestUpdate(FrontierEngineWindowSDL* window);
 };
@@ -94,10 +94,17 @@ bool FrontierEngineWindowSDL::update()
     int h = 0;
     SDL_GetWindowSize(m_sdlWindow, &w, &h);
 
+    // Only present the areas that have changed, unless we have to redraw everything
+    std::vector<Frontier::Rect> rects = m_window->getDamage().getRects();
     if (w != winSize.width || h != winSize.height)
     {
         SDL_SetWindowSize(m_sdlWindow, winSize.width, winSize.height);
         log(DEBUG, "update: Setting window size: %s", winSize.toString().c_str());
+        rects.clear();
+    }
+    if (rects.empty())
+    {
+        rects.push_back(Frontier::Rect(0, 0, winSize.width, winSize.height));
     }
 
     SDL_Surface* sdlSurface = SDL_GetWindowSurface(m_sdlWindow);
@@ -106,15 +113,31 @@ bool FrontierEngineWindowSDL::update()
         return false;
     }
 
+    ProfileScope scope(m_window->getApp()->getProfiler(), PROFILE_PRESENT, "SDL_ConvertPixels");
+
     int res;
-    res = SDL_ConvertPixels(
-        winSize.width, winSize.height,
-        SDL_PIXELFORMAT_ARGB8888, m_window->getSurface()->getData(), winSize.width * 4,
-        sdlSurface->format->format, sdlSurface->pixels, sdlSurface->pitch);
-    if (res < 0)
+    uint8_t* srcData = m_window->getSurface()->getData();
+    int srcPitch = winSize.width * 4;
+    int bpp = sdlSurface->format->BytesPerPixel;
+    std::vector<SDL_Rect> sdlRects;
+    for (const Frontier::Rect& rect : rects)
     {
-        log(ERROR, "redraw: res=%d: %s", res, SDL_GetError());
-        return false;
+        res = SDL_ConvertPixels(
+            rect.width, rect.height,
+            SDL_PIXELFORMAT_ARGB8888, srcData + (rect.y * srcPitch) + (rect.x * 4), srcPitch,
+            sdlSurface->format->format, (uint8_t*)sdlSurface->pixels + (rect.y * sdlSurface->pitch) + (rect.x * bpp), sdlSurface->pitch);
+        if (res < 0)
+        {
+            log(ERROR, "redraw: res=%d: %s", res, SDL_GetError());
+            return false;
+        }
+
+        SDL_Rect sdlRect;
+        sdlRect.x = rect.x;
+        sdlRect.y = rect.y;
+        sdlRect.w = rect.width;
+        sdlRect.h = rect.height;
+        sdlRects.push_back(sdlRect);
     }
 
 /*
@@ -127,7 +150,7 @@ bool FrontierEngineWindowSDL::update()
     SDL_BlitSurface(m_surface, NULL, winSurface, &dstrect);
 */
 
-    res = SDL_UpdateWindowSurface(m_sdlWindow);
+    res = SDL_UpdateWindowSurfaceRects(m_sdlWindow, sdlRects.data(), sdlRects.size());
     if (res < 0)
     {
         log(ERROR, "redraw: res=%d: %s", res, SDL_GetError());
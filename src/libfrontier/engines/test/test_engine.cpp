@@ -47,6 +47,7 @@ bool TestEngine::initWindow(FrontierWindow* window)
 
 bool TestEngine::checkEvents()
 {
+    dispatchEvents();
     return true;
 }
 
@@ -30,6 +30,9 @@ class WaylandEngine : public FrontierEngine
     double m_currentX;
     double m_currentY;
 
+    /// An eventfd written to by wake(), to interrupt the poll() in checkEvents()
+    int m_wakeFd = -1;
+
     void registryHandler(const char* interface, uint32_t id, int version);
     void seatCapabilities(struct wl_seat *wl_seat, uint32_t capabilities);
 
@@ -52,6 +55,12 @@ class WaylandEngine : public FrontierEngine
         uint32_t time,
         uint32_t button,
         uint32_t state);
+
+    void pointerAxis(
+        wl_pointer* wl_pointer,
+        uint32_t time,
+        uint32_t axis,
+        double value);
  public:
     explicit WaylandEngine(FrontierApp* app);
     ~WaylandEngine() override;
@@ -62,6 +71,7 @@ class WaylandEngine : public FrontierEngine
     bool quit(bool force) override;
 
     bool checkEvents() override;
+    void wake() override;
 
     void requestUpdate(WaylandEngine* window);
 
@@ -170,7 +180,7 @@ class WaylandWindow : public FrontierEngineWindow
     Size m_currentSize = {0, 0};
 
     bool createBuffer(Size winSize);
-    wl_buffer* drawFrame();
+    wl_buffer* drawFrame(const std::vector<Frontier::Rect>& damage);
 
     void xdgSurfaceConfigure(xdg_surface *xdg_surface, uint32_t serial);
 
@@ -1,6 +1,10 @@
 
 #include "wayland.h"
 
+#include <poll.h>
+#include <sys/eventfd.h>
+#include <unistd.h>
+
 using namespace std;
 using namespace Frontier;
 using namespace Geek;
@@ -49,7 +53,10 @@ WaylandEngine::WaylandEngine(FrontierApp* app) : FrontierEngine(app)
 
 WaylandEngine::~WaylandEngine()
 {
-
+    if (m_wakeFd != -1)
+    {
+        close(m_wakeFd);
+    }
 }
 
 bool WaylandEngine::init()
@@ -80,6 +87,13 @@ bool WaylandEngine::init()
 
     wl_seat_add_listener(m_seat, &wl_seat_listener, this);
 
+    m_wakeFd = eventfd(0, EFD_NONBLOCK | EFD_CLOEXEC);
+    if (m_wakeFd == -1)
+    {
+        log(ERROR, "init: Failed to create wake eventfd");
+        return false;
+    }
+
     return true;
 }
 
@@ -107,11 +121,60 @@ bool WaylandEngine::quit(bool force)
 
 bool WaylandEngine::checkEvents()
 {
-    while (wl_display_dispatch(m_display))
+    FrameScheduler* scheduler = m_app->getFrameScheduler();
+
+    // Handle anything that has already been read
+    while (wl_display_prepare_read(m_display) != 0)
+    {
+        wl_display_dispatch_pending(m_display);
+    }
+    wl_display_flush(m_display);
+
+    // Sleep until there is input, a frame is due or we're woken up
+    pollfd fds[2];
+    fds[0].fd = wl_display_get_fd(m_display);
+    fds[0].events = POLLIN;
+    fds[0].revents = 0;
+    fds[1].fd = m_wakeFd;
+    fds[1].events = POLLIN;
+    fds[1].revents = 0;
+    if (poll(fds, 2, scheduler->getTimeout()) > 0 && (fds[0].revents & POLLIN))
     {
-        /* This space deliberately left blank */
+        wl_display_read_events(m_display);
     }
-    return false;
+    else
+    {
+        wl_display_cancel_read(m_display);
+    }
+
+    // Reading resets the counter, so we can sleep again next time
+    uint64_t wakeCount;
+    ssize_t res = read(m_wakeFd, &wakeCount, sizeof(wakeCount));
+    (void)res;
+
+    if (wl_display_dispatch_pending(m_display) < 0)
+    {
+        log(ERROR, "checkEvents: Lost connection to the display");
+        return false;
+    }
+
+    // Input is handled before any frames are produced
+    dispatchEvents();
+    scheduler->runFrames();
+
+    return true;
+}
+
+void WaylandEngine::wake()
+{
+    if (m_wakeFd == -1)
+    {
+        return;
+    }
+
+    uint64_t one = 1;
+    ssize_t res = write(m_wakeFd, &one, sizeof(one));
+    (void)res;
 }
 
 void WaylandEngine::requestUpdate(WaylandEngine* window)
@@ -228,7 +291,7 @@ void WaylandEngine::pointerButton(
 void
 WaylandEngine::pointerAxis(void* data, struct wl_pointer* wl_pointer, uint32_t time, uint32_t axis, wl_fixed_t value)
 {
-
+    ((WaylandEngine*)data)->pointerAxis(wl_pointer, time, axis, wl_fixed_to_double(value));
 }
 
 void WaylandEngine::pointerFrame(void* data, struct wl_pointer* wl_pointer)
@@ -280,25 +343,26 @@ WaylandEngine::pointerButton(wl_pointer* wl_pointer, uint32_t serial, uint32_t t
         return;
     }
 
-    MouseButtonEvent* mouseButtonEvent = new MouseButtonEvent();
-    mouseButtonEvent->eventType = FRONTIER_EVENT_MOUSE_BUTTON;
-    mouseButtonEvent->direction = !!state;
+    MouseButtonEvent mouseButtonEvent;
+    mouseButtonEvent.eventType = FRONTIER_EVENT_MOUSE_BUTTON;
+    mouseButtonEvent.direction = !!state;
 
-    mouseButtonEvent->buttons = 0;
+    mouseButtonEvent.buttons = 0;
     if (button == BTN_LEFT)
     {
-        mouseButtonEvent->buttons = BUTTON_LEFT;
+        mouseButtonEvent.buttons = BUTTON_LEFT;
     }
     else if (button == BTN_RIGHT)
     {
-        mouseButtonEvent->buttons = BUTTON_RIGHT;
+        mouseButtonEvent.buttons = BUTTON_RIGHT;
     }
-    mouseButtonEvent->doubleClick = false;
+    mouseButtonEvent.doubleClick = false;
 
-    mouseButtonEvent->x = m_currentX;
-    mouseButtonEvent->y = m_currentY;
-    log(DEBUG, "pointerButton: few=%p, x=%d, y=%d", m_currentWindow, mouseButtonEvent->x, mouseButtonEvent->y);
-    m_currentWindow->getWindow()->handleEvent(mouseButtonEvent);
+    mouseButtonEvent.x = m_currentX;
+    mouseButtonEvent.y = m_currentY;
+    mouseButtonEvent.window = m_currentWindow->getWindow();
+    log(DEBUG, "pointerButton: few=%p, x=%d, y=%d", m_currentWindow, mouseButtonEvent.x, mouseButtonEvent.y);
+    queueEvent(mouseButtonEvent);
 }
 
 void WaylandEngine::pointerMotion(struct wl_pointer* wl_pointer, uint32_t time, double x, double y)
@@ -311,11 +375,43 @@ void WaylandEngine::pointerMotion(struct wl_pointer* wl_pointer, uint32_t time,
     m_currentX = x;
     m_currentY = y;
 
-    MouseMotionEvent* mouseMotionEvent = new MouseMotionEvent();
-    mouseMotionEvent->eventType = FRONTIER_EVENT_MOUSE_MOTION;
+    MouseMotionEvent mouseMotionEvent;
+    mouseMotionEvent.eventType = FRONTIER_EVENT_MOUSE_MOTION;
+
+    mouseMotionEvent.x = m_currentX;
+    mouseMotionEvent.y = m_currentY;
+    mouseMotionEvent.window = m_currentWindow->getWindow();
 
-    mouseMotionEvent->x = m_currentX;
-    mouseMotionEvent->y = m_currentY;
+    // Consecutive motion is merged by queueEvent
+    queueEvent(mouseMotionEvent);
+}
+
+void WaylandEngine::pointerAxis(struct wl_pointer* wl_pointer, uint32_t time, uint32_t axis, double value)
+{
+    if (m_currentWindow == nullptr)
+    {
+        return;
+    }
+
+    MouseScrollEvent mouseScrollEvent;
+    mouseScrollEvent.eventType = FRONTIER_EVENT_MOUSE_SCROLL;
+    mouseScrollEvent.x = m_currentX;
+    mouseScrollEvent.y = m_currentY;
+    mouseScrollEvent.scrollX = 0;
+    mouseScrollEvent.scrollY = 0;
+
+    // Wayland scrolls down for positive values, about 10 per wheel click
+    int amount = -(int)(value / 5.0);
+    if (axis == WL_POINTER_AXIS_HORIZONTAL_SCROLL)
+    {
+        mouseScrollEvent.scrollX = amount;
+    }
+    else
+    {
+        mouseScrollEvent.scrollY = amount;
+    }
+    mouseScrollEvent.window = m_currentWindow->getWindow();
 
-    m_currentWindow->getWindow()->handleEvent(mouseMotionEvent);
+    // Scrolling in the same place is accumulated by queueEvent
+    queueEvent(mouseScrollEvent);
 }
@@ -115,9 +115,7 @@ bool WaylandWindow::update()
     if (m_configured)
     {
         log(DEBUG, "update: Redrawing...");
-        drawFrame();
-        wl_surface_damage_buffer(m_wlSurface, 0, 0, INT32_MAX, INT32_MAX);
-        wl_surface_commit(m_wlSurface);
+        drawFrame(m_window->getDamage().getRects());
     }
 
     return true;
@@ -150,9 +148,9 @@ void WaylandWindow::updateCursor(Frontier::WindowCursor cursor, int x, int y, in
 
 void WaylandWindow::requestUpdate()
 {
-    log(DEBUG, "requestUpdate: Here!");
-    //wl_surface_damage_buffer(m_wlSurface, 0, 0, INT32_MAX, INT32_MAX);
-    update();
+    // The frame has already been requested, but the engine may be asleep. This
+    // can be called from other threads, so don't draw here
+    m_engine->wake();
 }
 
 void WaylandWindow::xdgSurfaceConfigure(void* data, struct xdg_surface* xdg_surface, uint32_t serial)
@@ -165,15 +163,17 @@ void WaylandWindow::xdgSurfaceConfigure(xdg_surface* xdg_surface, uint32_t seria
     log(DEBUG, "xdgSurfaceConfigure: here");
     xdg_surface_ack_configure(xdg_surface, serial);
 
-    drawFrame();
+    drawFrame(std::vector<Frontier::Rect>());
     m_configured = true;
 }
 
-wl_buffer* WaylandWindow::drawFrame()
+wl_buffer* WaylandWindow::drawFrame(const std::vector<Frontier::Rect>& damage)
 {
     Size winSize = m_window->getSize();
+    bool full = damage.empty();
     if (m_currentSize != winSize)
     {
+        full = true;
         bool res;
         res = createBuffer(winSize);
         if (!res)
@@ -184,7 +184,25 @@ wl_buffer* WaylandWindow::drawFrame()
     }
 
     log(DEBUG, "drawFrame: Drawing!");
-    memcpy(m_data, m_window->getSurface()->getData(), winSize.width * winSize.height * 4);
+    ProfileScope scope(m_window->getApp()->getProfiler(), PROFILE_PRESENT, "WaylandWindow::drawFrame");
+    uint8_t* surfaceData = m_window->getSurface()->getData();
+    if (full)
+    {
+        memcpy(m_data, surfaceData, winSize.width * winSize.height * 4);
+    }
+    else
+    {
+        // Only copy the areas that have changed
+        int stride = winSize.width * 4;
+        for (const Frontier::Rect& rect : damage)
+        {
+            for (int y = rect.y; y < rect.y + rect.height; y++)
+            {
+                int offset = (y * stride) + (rect.x * 4);
+                memcpy((uint8_t*)m_data + offset, surfaceData + offset, rect.width * 4);
+            }
+        }
+    }
 
     wl_buffer* buffer = wl_shm_pool_create_buffer(
         m_pool,
@@ -198,6 +216,17 @@ wl_buffer* WaylandWindow::drawFrame()
     wl_buffer_add_listener(buffer, &wl_buffer_listener, NULL);
 
     wl_surface_attach(m_wlSurface, buffer, 0, 0);
+    if (full)
+    {
+        wl_surface_damage_buffer(m_wlSurface, 0, 0, INT32_MAX, INT32_MAX);
+    }
+    else
+    {
+        for (const Frontier::Rect& rect : damage)
+        {
+            wl_surface_damage_buffer(m_wlSurface, rect.x, rect.y, rect.width, rect.height);
+        }
+    }
     wl_surface_commit(m_wlSurface);
 
     return buffer;
@@ -71,11 +71,11 @@ void WindowingEngine::mouseMotion(int x, int y)
     FrontierWindow* window = windowAt(x, y);
     if (window != NULL)
     {
-        MouseMotionEvent* mouseMotionEvent = new MouseMotionEvent();
-        mouseMotionEvent->eventType = FRONTIER_EVENT_MOUSE_MOTION;
-        mouseMotionEvent->x = x - window->getPosition().x;
-        mouseMotionEvent->y = y - window->getPosition().y;
-        window->handleEvent(mouseMotionEvent);
+        MouseMotionEvent mouseMotionEvent;
+        mouseMotionEvent.eventType = FRONTIER_EVENT_MOUSE_MOTION;
+        mouseMotionEvent.x = x - window->getPosition().x;
+        mouseMotionEvent.y = y - window->getPosition().y;
+        window->handleEvent(&mouseMotionEvent);
     }
 }
 
@@ -87,13 +87,13 @@ void WindowingEngine::mouseButton(int x, int y, int button, bool direction)
         // Bring it to the front
         showWindow(window);
 
-        MouseButtonEvent* mouseButtonEvent = new MouseButtonEvent();
-        mouseButtonEvent->eventType = FRONTIER_EVENT_MOUSE_BUTTON;
-        mouseButtonEvent->direction = direction;
-        mouseButtonEvent->buttons = button;
-        mouseButtonEvent->x = x - window->getPosition().x;
-        mouseButtonEvent->y = y - window->getPosition().y;
-        window->handleEvent(mouseButtonEvent);
+        MouseButtonEvent mouseButtonEvent;
+        mouseButtonEvent.eventType = FRONTIER_EVENT_MOUSE_BUTTON;
+        mouseButtonEvent.direction = direction;
+        mouseButtonEvent.buttons = button;
+        mouseButtonEvent.x = x - window->getPosition().x;
+        mouseButtonEvent.y = y - window->getPosition().y;
+        window->handleEvent(&mouseButtonEvent);
     }
 }
 
@@ -1,16 +1,27 @@
 
 #include "x11_engine.h"
 
+#include <sys/select.h>
+#include <fcntl.h>
+#include <unistd.h>
+
 using namespace std;
 using namespace Frontier;
 using namespace Geek;
 
 X11Engine::X11Engine(FrontierApp* app) : FrontierEngine(app)
 {
+    m_wakePipe[0] = -1;
+    m_wakePipe[1] = -1;
 }
 
 X11Engine::~X11Engine()
 {
+    if (m_wakePipe[0] != -1)
+    {
+        close(m_wakePipe[0]);
+        close(m_wakePipe[1]);
+    }
 }
 
 bool X11Engine::init()
@@ -52,6 +63,15 @@ bool X11Engine::init()
 
     WM_DELETE_WINDOW = XInternAtom(m_display, "WM_DELETE_WINDOW", False);
 
+    res = pipe(m_wakePipe);
+    if (res != 0)
+    {
+        log(ERROR, "Failed to create wake pipe");
+        return false;
+    }
+    fcntl(m_wakePipe[0], F_SETFL, O_NONBLOCK);
+    fcntl(m_wakePipe[1], F_SETFL, O_NONBLOCK);
+
     return true;
 }
 
@@ -88,9 +108,65 @@ X11FrontierWindow* X11Engine::getWindow(Window window)
 
 bool X11Engine::checkEvents()
 {
+    FrameScheduler* scheduler = m_app->getFrameScheduler();
+
+    if (XPending(m_display) == 0)
+    {
+        // Sleep until there is input or a frame is due
+        int timeout = scheduler->getTimeout();
+        int fd = ConnectionNumber(m_display);
+        fd_set fds;
+        FD_ZERO(&fds);
+        FD_SET(fd, &fds);
+        FD_SET(m_wakePipe[0], &fds);
+
+        timeval tv;
+        timeval* tvp = NULL;
+        if (timeout >= 0)
+        {
+            tv.tv_sec = timeout / 1000;
+            tv.tv_usec = (timeout % 1000) * 1000;
+            tvp = &tv;
+        }
+        select(max(fd, m_wakePipe[0]) + 1, &fds, NULL, NULL, tvp);
+    }
+
+    // We're awake now, so forget about any wake ups
+    char buffer[64];
+    while (read(m_wakePipe[0], buffer, sizeof(buffer)) > 0)
+    {
+    }
+
+    // Handle everything that is waiting, so input can be merged and only causes one update
     XEvent event;
-    XNextEvent(m_display, &event);
+    while (XPending(m_display) > 0)
+    {
+        XNextEvent(m_display, &event);
+        handleX11Event(event);
+    }
+
+    // Input is handled before any frames are produced
+    dispatchEvents();
+    scheduler->runFrames();
+
+    return true;
+}
+
+void X11Engine::wake()
+{
+    if (m_wakePipe[1] == -1)
+    {
+        return;
+    }
+
+    // If the pipe is full, there's already a wake up waiting
+    char c = 0;
+    ssize_t res = write(m_wakePipe[1], &c, 1);
+    (void)res;
+}
 
+void X11Engine::handleX11Event(XEvent& event)
+{
     switch (event.type)
     {
         case ButtonRelease:
@@ -99,17 +175,18 @@ bool X11Engine::checkEvents()
             X11FrontierWindow* few = getWindow(event.xbutton.window);
             if (few == NULL)
             {
-                return true;
+                return;
             }
-            MouseButtonEvent* mouseButtonEvent = new MouseButtonEvent();
-            mouseButtonEvent->eventType = FRONTIER_EVENT_MOUSE_BUTTON;
-
-            mouseButtonEvent->x = event.xbutton.x;
-            mouseButtonEvent->y = event.xbutton.y;
-            //mouseButtonEvent->modifier = translateModifier(event.xbutton.state);
-            //mouseButtonEvent->button = event.xbutton.button;
-            mouseButtonEvent->direction = (event.type == ButtonPress);
-            few->getWindow()->handleEvent(mouseButtonEvent);
+            MouseButtonEvent mouseButtonEvent;
+            mouseButtonEvent.eventType = FRONTIER_EVENT_MOUSE_BUTTON;
+
+            mouseButtonEvent.x = event.xbutton.x;
+            mouseButtonEvent.y = event.xbutton.y;
+            //mouseButtonEvent.modifier = translateModifier(event.xbutton.state);
+            //mouseButtonEvent.button = event.xbutton.button;
+            mouseButtonEvent.direction = (event.type == ButtonPress);
+            mouseButtonEvent.window = few->getWindow();
+            queueEvent(mouseButtonEvent);
         } break;
 
         case MotionNotify:
@@ -117,21 +194,27 @@ bool X11Engine::checkEvents()
             X11FrontierWindow* few = getWindow(event.xmotion.window);
             if (few == NULL)
             {
-                return true;
+                return;
             }
 
-            MouseMotionEvent* mouseMotionEvent = new MouseMotionEvent();
-            mouseMotionEvent->eventType = FRONTIER_EVENT_MOUSE_MOTION;
-            mouseMotionEvent->x = event.xbutton.x;
-            mouseMotionEvent->y = event.xbutton.y;
+            MouseMotionEvent mouseMotionEvent;
+            mouseMotionEvent.eventType = FRONTIER_EVENT_MOUSE_MOTION;
+            mouseMotionEvent.x = event.xmotion.x;
+            mouseMotionEvent.y = event.xmotion.y;
+            mouseMotionEvent.window = few->getWindow();
 
-            few->getWindow()->handleEvent(mouseMotionEvent);
+            // Consecutive motion is merged by queueEvent
+            queueEvent(mouseMotionEvent);
         } break;
 
         case Expose:
         {
             X11FrontierWindow* window = getWindow(event.xexpose.window);
-            window->getWindow()->update(true);
+            if (window == NULL)
+            {
+                return;
+            }
+            m_app->getFrameScheduler()->requestFrame(window->getWindow(), true);
         } break;
 
         case ClientMessage:
@@ -139,8 +222,10 @@ bool X11Engine::checkEvents()
             X11FrontierWindow* few = getWindow(event.xclient.window);
             if (few == NULL)
             {
-                return true;
+                return;
             }
+            dispatchEvents();
+
             unsigned int type = static_cast<unsigned int>(event.xclient.data.l[0]);
             log(DEBUG, "checkEvents: checkEvents: window=%p, type=%d", few, type);
             if (type == WM_DELETE_WINDOW)
@@ -150,7 +235,6 @@ bool X11Engine::checkEvents()
             }
         } break;
     }
-    return true;
 }
 
 
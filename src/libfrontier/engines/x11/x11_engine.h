@@ -67,6 +67,11 @@ class X11Engine : public Frontier::FrontierEngine
 
     Atom WM_DELETE_WINDOW;
 
+    /// Written to by wake(), to interrupt the select() in checkEvents()
+    int m_wakePipe[2];
+
+    void handleX11Event(XEvent& event);
+
  public:
     X11Engine(Frontier::FrontierApp* app);
     virtual ~X11Engine();
@@ -77,6 +82,7 @@ class X11Engine : public Frontier::FrontierEngine
     X11FrontierWindow* getWindow(Window window);
 
     virtual bool checkEvents();
+    void wake() override;
 
     Atom* getWMDeleteWindow() { return &WM_DELETE_WINDOW; }
     Display* getDisplay() { return m_display; }
@@ -116,8 +116,12 @@ bool X11FrontierWindow::update()
     Size winSize = m_window->getSize();
 
     int len = winSize.width * winSize.height * 4;
+
+    // Only copy and put the areas that have changed, unless we have to redraw everything
+    std::vector<Frontier::Rect> rects = m_window->getDamage().getRects();
     if (m_xImage == NULL || m_size != winSize)
     {
+        rects.clear();
         m_size = winSize;
         XResizeWindow(dpy, m_x11Window, winSize.width, winSize.height);
 
@@ -194,30 +198,47 @@ bool X11FrontierWindow::update()
     }
 
 
-    if (engine->useShm())
+    if (rects.empty())
     {
-        memcpy(m_xImage->data, m_window->getSurface()->getData(), len);
-        XShmPutImage(
-            dpy,
-            m_x11Window,
-            m_gc,
-            m_xImage,
-            0, 0,
-            0, 0,
-            m_size.width, m_size.height,
-            False);
+        rects.push_back(Frontier::Rect(0, 0, m_size.width, m_size.height));
     }
-    else
+
+    ProfileScope scope(m_window->getApp()->getProfiler(), PROFILE_PRESENT, engine->useShm() ? "XShmPutImage" : "XPutImage");
+
+    char* imageData = m_xImage->data;
+    uint8_t* surfaceData = m_window->getSurface()->getData();
+    int stride = m_size.width * 4;
+    for (const Frontier::Rect& rect : rects)
     {
-        memcpy(m_xImageData, m_window->getSurface()->getData(), len);
-        XPutImage(
-            dpy,
-            m_x11Window,
-            m_gc,
-            m_xImage,
-            0, 0,
-            0, 0,
-            m_size.width, m_size.height);
+        for (int y = rect.y; y < rect.y + rect.height; y++)
+        {
+            int offset = (y * stride) + (rect.x * 4);
+            memcpy(imageData + offset, surfaceData + offset, rect.width * 4);
+        }
+
+        if (engine->useShm())
+        {
+            XShmPutImage(
+                dpy,
+                m_x11Window,
+                m_gc,
+                m_xImage,
+                rect.x, rect.y,
+                rect.x, rect.y,
+                rect.width, rect.height,
+                False);
+        }
+        else
+        {
+            XPutImage(
+                dpy,
+                m_x11Window,
+                m_gc,
+                m_xImage,
+                rect.x, rect.y,
+                rect.x, rect.y,
+                rect.width, rect.height);
+        }
     }
 
     return true;
@@ -229,5 +250,7 @@ void X11FrontierWindow::setPosition(unsigned int x, unsigned int y)
 
 void X11FrontierWindow::requestUpdate()
 {
+    // The frame has already been requested, but the engine may be asleep
+    m_engine->wake();
 }
 
@@ -0,0 +1,149 @@
+/*
+ * Frontier - A toolkit for creating simple OS-independent user interfaces
+ * Copyright (C) 2020 Ian Parker <ian@geekprojects.com>
+ *
+ * This file is part of Frontier.
+ *
+ * Frontier is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * Frontier is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with Frontier.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <frontier/framescheduler.h>
+#include <frontier/frontier.h>
+
+#include <algorithm>
+
+using namespace std;
+using namespace Frontier;
+using namespace Geek;
+
+FrameScheduler::FrameScheduler(FrontierApp* app) : Logger(L"FrameScheduler")
+{
+    m_app = app;
+    m_mutex = Thread::createMutex();
+
+    m_interval = FRONTIER_FRAME_INTERVAL;
+    m_lastFrame = 0;
+    m_frameCount = 0;
+}
+
+FrameScheduler::~FrameScheduler() = default;
+
+void FrameScheduler::requestFrame(FrontierWindow* window, bool force)
+{
+    m_mutex->lock();
+    bool found = false;
+    for (PendingFrame& pending : m_pending)
+    {
+        if (pending.window == window)
+        {
+            pending.force |= force;
+            found = true;
+            break;
+        }
+    }
+
+    if (!found)
+    {
+        PendingFrame pending;
+        pending.window = window;
+        pending.force = force;
+        m_pending.push_back(pending);
+    }
+    m_mutex->unlock();
+}
+
+void FrameScheduler::cancelFrame(FrontierWindow* window)
+{
+    m_mutex->lock();
+    vector<PendingFrame>::iterator it;
+    for (it = m_pending.begin(); it != m_pending.end(); ++it)
+    {
+        if (it->window == window)
+        {
+            m_pending.erase(it);
+            break;
+        }
+    }
+    m_mutex->unlock();
+}
+
+bool FrameScheduler::hasPendingFrames()
+{
+    m_mutex->lock();
+    bool pending = !m_pending.empty();
+    m_mutex->unlock();
+    return pending;
+}
+
+int FrameScheduler::getTimeout()
+{
+    if (!hasPendingFrames())
+    {
+        return -1;
+    }
+
+    uint64_t now = Profiler::getTime();
+    uint64_t elapsed = now - m_lastFrame;
+    if (m_lastFrame == 0 || elapsed >= m_interval)
+    {
+        return 0;
+    }
+
+    // Round up, so we don't wake just before the frame is due
+    return (int)((m_interval - elapsed + 999999) / 1000000);
+}
+
+bool FrameScheduler::runFrames(bool force)
+{
+    uint64_t now = Profiler::getTime();
+
+    m_mutex->lock();
+    if (m_pending.empty())
+    {
+        m_mutex->unlock();
+        return false;
+    }
+
+    if (!force && m_lastFrame != 0 && (now - m_lastFrame) < m_interval)
+    {
+        // Too soon, the engine will wait until getTimeout() has passed
+        m_mutex->unlock();
+        return false;
+    }
+
+    // Windows may request another frame while being updated
+    vector<PendingFrame> frames;
+    frames.swap(m_pending);
+    m_mutex->unlock();
+
+    m_lastFrame = now;
+    m_frameCount++;
+
+    // The active Window is the one the user is most likely to be looking at
+    FrontierWindow* activeWindow = m_app->getActiveWindow();
+    stable_partition(frames.begin(), frames.end(), [activeWindow](const PendingFrame& pending)
+    {
+        return pending.window == activeWindow;
+    });
+
+    for (PendingFrame& pending : frames)
+    {
+        pending.window->update(pending.force);
+    }
+
+    // Now nothing is being drawn, release anything that is no longer used
+    m_app->gc();
+
+    return true;
+}
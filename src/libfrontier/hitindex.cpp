@@ -0,0 +1,188 @@
+/*
+ * Frontier - A toolkit for creating simple OS-independent user interfaces
+ * Copyright (C) 2020 Ian Parker <ian@geekprojects.com>
+ *
+ * This file is part of Frontier.
+ *
+ * Frontier is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * Frontier is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with Frontier.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <frontier/hitindex.h>
+
+using namespace Frontier;
+using namespace std;
+
+// Limit the number of cells, relative to the number of Rects
+#define HIT_INDEX_CELLS_PER_RECT 4
+
+HitIndex::HitIndex()
+{
+    m_cols = 0;
+    m_rows = 0;
+    m_cellWidth = 1;
+    m_cellHeight = 1;
+}
+
+void HitIndex::clear()
+{
+    m_rects.clear();
+    m_cellStart.clear();
+    m_cellItems.clear();
+    m_cols = 0;
+    m_rows = 0;
+}
+
+void HitIndex::getCells(const Rect& rect, int& col1, int& row1, int& col2, int& row2) const
+{
+    col1 = max(0, (rect.x - m_bounds.x) / m_cellWidth);
+    row1 = max(0, (rect.y - m_bounds.y) / m_cellHeight);
+    col2 = min(m_cols - 1, (rect.x + rect.width - 1 - m_bounds.x) / m_cellWidth);
+    row2 = min(m_rows - 1, (rect.y + rect.height - 1 - m_bounds.y) / m_cellHeight);
+}
+
+void HitIndex::build()
+{
+    m_cellStart.clear();
+    m_cellItems.clear();
+    m_cols = 0;
+    m_rows = 0;
+
+    // Find the area covered, and how big a typical Rect is
+    int x1 = 0;
+    int y1 = 0;
+    int x2 = 0;
+    int y2 = 0;
+    int64_t totalWidth = 0;
+    int64_t totalHeight = 0;
+    int count = 0;
+    for (const Rect& rect : m_rects)
+    {
+        if (rect.width <= 0 || rect.height <= 0)
+        {
+            continue;
+        }
+        if (count == 0)
+        {
+            x1 = rect.x;
+            y1 = rect.y;
+            x2 = rect.x + rect.width;
+            y2 = rect.y + rect.height;
+        }
+        else
+        {
+            x1 = min(x1, rect.x);
+            y1 = min(y1, rect.y);
+            x2 = max(x2, rect.x + rect.width);
+            y2 = max(y2, rect.y + rect.height);
+        }
+        totalWidth += rect.width;
+        totalHeight += rect.height;
+        count++;
+    }
+    if (count == 0)
+    {
+        return;
+    }
+    m_bounds = Rect(x1, y1, x2 - x1, y2 - y1);
+
+    int averageWidth = max(1, (int)(totalWidth / count));
+    int averageHeight = max(1, (int)(totalHeight / count));
+    m_cols = max(1, m_bounds.width / averageWidth);
+    m_rows = max(1, m_bounds.height / averageHeight);
+    while (m_cols * m_rows > count * HIT_INDEX_CELLS_PER_RECT)
+    {
+        if (m_cols > m_rows)
+        {
+            m_cols = (m_cols + 1) / 2;
+        }
+        else
+        {
+            m_rows = (m_rows + 1) / 2;
+        }
+    }
+    m_cellWidth = max(1, (m_bounds.width + m_cols - 1) / m_cols);
+    m_cellHeight = max(1, (m_bounds.height + m_rows - 1) / m_rows);
+
+    // Count the entries in each cell, then fill them in Rect order
+    m_cellStart.resize(m_cols * m_rows + 1, 0);
+    int col1;
+    int row1;
+    int col2;
+    int row2;
+    int col;
+    int row;
+    for (const Rect& rect : m_rects)
+    {
+        if (rect.width <= 0 || rect.height <= 0)
+        {
+            continue;
+        }
+        getCells(rect, col1, row1, col2, row2);
+        for (row = row1; row <= row2; row++)
+        {
+            for (col = col1; col <= col2; col++)
+            {
+                m_cellStart[(row * m_cols) + col + 1]++;
+            }
+        }
+    }
+
+    unsigned int i;
+    for (i = 1; i < m_cellStart.size(); i++)
+    {
+        m_cellStart[i] += m_cellStart[i - 1];
+    }
+
+    m_cellItems.resize(m_cellStart.back());
+    vector<unsigned int> cellEnd(m_cellStart.begin(), m_cellStart.end() - 1);
+    for (i = 0; i < m_rects.size(); i++)
+    {
+        const Rect& rect = m_rects[i];
+        if (rect.width <= 0 || rect.height <= 0)
+        {
+            continue;
+        }
+        getCells(rect, col1, row1, col2, row2);
+        for (row = row1; row <= row2; row++)
+        {
+            for (col = col1; col <= col2; col++)
+            {
+                m_cellItems[cellEnd[(row * m_cols) + col]++] = i;
+            }
+        }
+    }
+}
+
+int HitIndex::find(int x, int y) const
+{
+    if (m_cols == 0 || !m_bounds.intersects(x, y))
+    {
+        return -1;
+    }
+
+    int col = (x - m_bounds.x) / m_cellWidth;
+    int row = (y - m_bounds.y) / m_cellHeight;
+    int cell = (row * m_cols) + col;
+
+    unsigned int i;
+    for (i = m_cellStart[cell]; i < m_cellStart[cell + 1]; i++)
+    {
+        unsigned int item = m_cellItems[i];
+        if (m_rects[item].intersects(x, y))
+        {
+            return item;
+        }
+    }
+    return -1;
+}
@@ -86,9 +86,15 @@ bool Layer::update()
 
     m_root->setWindow(m_window);
 
+    if (m_root->isDirty())
+    {
+        ProfileScope boundaryScope(m_app->getProfiler(), PROFILE_LAYOUT, "Layer::layoutBoundaries");
+        layoutBoundaries(m_root);
+    }
+
     if (m_root->isDirty(DIRTY_SIZE) || m_root->isDirty(DIRTY_STYLE))
     {
-        m_root->calculateSize();
+        m_root->measure();
 
         Size min = m_root->getMinSize();
         if (m_primary)
@@ -134,13 +140,22 @@ bool Layer::update()
     if (surface != m_surface)
     {
         m_surface = surface;
-        m_root->setDirty(DIRTY_SIZE | DIRTY_CONTENT, true);
+        m_root->setDirty(DIRTY_SIZE | DIRTY_CONTENT, true, false);
     }
 
     if (m_root->isDirty())
     {
-        m_root->layout();
+        // Content changes don't move anything, so only lay out when sizes may have changed
+        if (m_root->needsLayout())
+        {
+            ProfileScope layoutScope(m_app->getProfiler(), PROFILE_LAYOUT, "Layer::layout");
+            m_root->layout();
+        }
 
+        // Positions are final now, so work out what is about to be redrawn
+        collectDamage(m_root, 0, 0);
+
+        ProfileScope drawScope(m_app->getProfiler(), PROFILE_DRAW, "Layer::draw");
         m_root->draw(m_surface);
         m_root->clearDirty();
 
@@ -152,3 +167,53 @@ bool Layer::update()
     }
 }
 
+void Layer::layoutBoundaries(Widget* widget)
+{
+    for (Widget* child : widget->getChildren())
+    {
+        if (!child->isDirty())
+        {
+            continue;
+        }
+
+        // Deepest first, as a boundary may need to pass a size change to the one above it
+        layoutBoundaries(child);
+
+        if (child->needsLayout() && !widget->needsLayout())
+        {
+            // A layout boundary stopped the change reaching us
+            child->layoutBoundary();
+        }
+    }
+}
+
+void Layer::collectDamage(Widget* widget, int x, int y)
+{
+    x += widget->getX();
+    y += widget->getY();
+    Rect rect(x, y, widget->getWidth(), widget->getHeight());
+
+    // A size change causes the whole Widget to be redrawn
+    if (widget->isDamaged() || widget->isDirty(DIRTY_SIZE) || !widget->isChildDamageLocal())
+    {
+        m_damage.add(rect);
+        return;
+    }
+
+    bool found = false;
+    for (Widget* child : widget->getChildren())
+    {
+        if (child->isDirty())
+        {
+            collectDamage(child, x, y);
+            found = true;
+        }
+    }
+
+    if (!found)
+    {
+        // Something dirty that we can't see, so assume the worst
+        m_damage.add(rect);
+    }
+}
+
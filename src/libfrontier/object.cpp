@@ -20,6 +20,7 @@
 
 
 #include <frontier/object.h>
+#include <frontier/app.h>
 
 #include <stdio.h>
 
@@ -29,6 +30,8 @@ using namespace Frontier;
 FrontierObject::FrontierObject()
 {
     m_referenceCount = 0;
+    m_releaseApp = NULL;
+    m_releaseQueued = false;
 }
 
 FrontierObject::~FrontierObject()
@@ -39,4 +42,10 @@ FrontierObject::~FrontierObject()
     }
 }
 
-
+void FrontierObject::release()
+{
+    if (m_releaseApp != NULL)
+    {
+        m_releaseApp->releaseObject(this);
+    }
+}
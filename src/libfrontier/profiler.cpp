@@ -0,0 +1,379 @@
+/*
+ * Frontier - A toolkit for creating simple OS-independent user interfaces
+ * Copyright (C) 2020 Ian Parker <ian@geekprojects.com>
+ *
+ * This file is part of Frontier.
+ *
+ * Frontier is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * Frontier is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with Frontier.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <frontier/profiler.h>
+
+#include <chrono>
+#include <atomic>
+#include <algorithm>
+
+using namespace std;
+using namespace Frontier;
+using namespace Geek;
+
+// Upper limits of the FrameHistogram buckets
+static const uint64_t g_bucketLimits[FRONTIER_FRAME_BUCKETS] = {
+    4000000,
+    8000000,
+    16666667,
+    33333333,
+    50000000,
+    100000000,
+    UINT64_MAX
+};
+
+static atomic<unsigned int> g_nextThread(1);
+static thread_local unsigned int g_thread = 0;
+
+// Each thread's events for each Profiler, by Profiler id. Ids aren't reused,
+// so entries for Profilers that have been destroyed are never looked up
+static atomic<unsigned int> g_nextProfiler(1);
+static thread_local unordered_map<unsigned int, void*> g_threadEvents;
+
+FrameHistogram::FrameHistogram()
+{
+    clear();
+}
+
+void FrameHistogram::add(uint64_t ns)
+{
+    m_times[m_next] = ns;
+    m_next = (m_next + 1) % FRONTIER_FRAME_HISTORY;
+    if (m_count < FRONTIER_FRAME_HISTORY)
+    {
+        m_count++;
+    }
+}
+
+void FrameHistogram::clear()
+{
+    m_count = 0;
+    m_next = 0;
+}
+
+uint64_t FrameHistogram::getAverage() const
+{
+    if (m_count == 0)
+    {
+        return 0;
+    }
+
+    uint64_t total = 0;
+    unsigned int i;
+    for (i = 0; i < m_count; i++)
+    {
+        total += m_times[i];
+    }
+    return total / m_count;
+}
+
+uint64_t FrameHistogram::getMax() const
+{
+    uint64_t max = 0;
+    unsigned int i;
+    for (i = 0; i < m_count; i++)
+    {
+        max = std::max(max, m_times[i]);
+    }
+    return max;
+}
+
+uint64_t FrameHistogram::getPercentile(float percentile) const
+{
+    if (m_count == 0)
+    {
+        return 0;
+    }
+
+    vector<uint64_t> times(m_times, m_times + m_count);
+    sort(times.begin(), times.end());
+
+    unsigned int pos = (unsigned int)((percentile / 100.0f) * (float)(m_count - 1) + 0.5f);
+    if (pos >= m_count)
+    {
+        pos = m_count - 1;
+    }
+    return times.at(pos);
+}
+
+unsigned int FrameHistogram::getBucket(unsigned int bucket) const
+{
+    if (bucket >= FRONTIER_FRAME_BUCKETS)
+    {
+        return 0;
+    }
+
+    uint64_t lower = 0;
+    if (bucket > 0)
+    {
+        lower = g_bucketLimits[bucket - 1];
+    }
+    uint64_t upper = g_bucketLimits[bucket];
+
+    unsigned int count = 0;
+    unsigned int i;
+    for (i = 0; i < m_count; i++)
+    {
+        if (m_times[i] >= lower && m_times[i] < upper)
+        {
+            count++;
+        }
+    }
+    return count;
+}
+
+uint64_t FrameHistogram::getBucketLimit(unsigned int bucket)
+{
+    if (bucket >= FRONTIER_FRAME_BUCKETS)
+    {
+        return UINT64_MAX;
+    }
+    return g_bucketLimits[bucket];
+}
+
+string FrameHistogram::toString() const
+{
+    char buffer[256];
+    snprintf(
+        buffer,
+        sizeof(buffer),
+        "frames=%u, avg=%0.2fms, p50=%0.2fms, p95=%0.2fms, p99=%0.2fms, max=%0.2fms",
+        m_count,
+        (double)getAverage() / 1000000.0,
+        (double)getPercentile(50) / 1000000.0,
+        (double)getPercentile(95) / 1000000.0,
+        (double)getPercentile(99) / 1000000.0,
+        (double)getMax() / 1000000.0);
+    string str = buffer;
+
+    unsigned int bucket;
+    for (bucket = 0; bucket < FRONTIER_FRAME_BUCKETS; bucket++)
+    {
+        if (bucket < FRONTIER_FRAME_BUCKETS - 1)
+        {
+            snprintf(buffer, sizeof(buffer), ", <%0.1fms=%u", (double)g_bucketLimits[bucket] / 1000000.0, getBucket(bucket));
+        }
+        else
+        {
+            snprintf(buffer, sizeof(buffer), ", slower=%u", getBucket(bucket));
+        }
+        str += buffer;
+    }
+    return str;
+}
+
+Profiler::Profiler() : Logger(L"Profiler")
+{
+    m_id = g_nextProfiler++;
+    m_enabled = false;
+    m_startTime = 0;
+    m_eventCount = 0;
+    m_dropped = 0;
+    m_mutex = Thread::createMutex();
+}
+
+Profiler::~Profiler()
+{
+    if (!m_tracePath.empty())
+    {
+        writeTrace(m_tracePath);
+    }
+}
+
+void Profiler::start(string tracePath)
+{
+    m_mutex->lock();
+    if (!tracePath.empty())
+    {
+        m_tracePath = tracePath;
+    }
+    if (m_startTime == 0)
+    {
+        m_startTime = getTime();
+    }
+    m_enabled = true;
+    m_mutex->unlock();
+}
+
+void Profiler::stop()
+{
+    m_enabled = false;
+}
+
+void Profiler::clear()
+{
+    m_mutex->lock();
+    for (auto& threadEvents : m_threadEvents)
+    {
+        lock_guard<mutex> lock(threadEvents->mutex);
+        threadEvents->events.clear();
+    }
+    m_eventCount = 0;
+    m_dropped = 0;
+    m_startTime = getTime();
+    m_mutex->unlock();
+}
+
+uint64_t Profiler::getTime()
+{
+    return chrono::duration_cast<chrono::nanoseconds>(chrono::steady_clock::now().time_since_epoch()).count();
+}
+
+Profiler::ThreadEvents* Profiler::getThreadEvents()
+{
+    auto it = g_threadEvents.find(m_id);
+    if (it != g_threadEvents.end())
+    {
+        return (ThreadEvents*)it->second;
+    }
+
+    if (g_thread == 0)
+    {
+        g_thread = g_nextThread++;
+    }
+
+    ThreadEvents* threadEvents = new ThreadEvents();
+    m_mutex->lock();
+    m_threadEvents.emplace_back(threadEvents);
+    m_mutex->unlock();
+    g_threadEvents[m_id] = threadEvents;
+    return threadEvents;
+}
+
+void Profiler::record(const char* category, const char* name, uint64_t start, uint64_t end)
+{
+    ThreadEvents* threadEvents = getThreadEvents();
+    if (m_eventCount++ >= FRONTIER_PROFILE_MAX_EVENTS)
+    {
+        m_eventCount--;
+        m_dropped++;
+        return;
+    }
+
+    Event event;
+    event.category = category;
+    event.name = name;
+    event.start = start;
+    event.duration = end - start;
+    event.thread = g_thread;
+
+    lock_guard<mutex> lock(threadEvents->mutex);
+    threadEvents->events.push_back(event);
+}
+
+const char* Profiler::getName(const wstring& name)
+{
+    ThreadEvents* threadEvents = getThreadEvents();
+    auto localIt = threadEvents->nameMap.find(name);
+    if (localIt != threadEvents->nameMap.end())
+    {
+        return localIt->second;
+    }
+
+    m_mutex->lock();
+    const char* result;
+    auto it = m_nameMap.find(name);
+    if (it != m_nameMap.end())
+    {
+        result = it->second;
+    }
+    else
+    {
+        string str;
+        for (wchar_t c : name)
+        {
+            // Names end up in JSON strings, so keep them simple
+            if (c < 0x20 || c > 0x7e || c == '"' || c == '\\')
+            {
+                c = '_';
+            }
+            str += (char)c;
+        }
+        result = m_names.insert(str).first->c_str();
+        m_nameMap.insert(make_pair(name, result));
+    }
+    m_mutex->unlock();
+
+    threadEvents->nameMap.insert(make_pair(name, result));
+    return result;
+}
+
+unsigned int Profiler::getEventCount()
+{
+    return m_eventCount;
+}
+
+bool Profiler::writeTrace(string path)
+{
+    FILE* fp = fopen(path.c_str(), "w");
+    if (fp == NULL)
+    {
+        log(ERROR, "writeTrace: Unable to open %s", path.c_str());
+        return false;
+    }
+
+    m_mutex->lock();
+
+    fprintf(fp, "{\"traceEvents\":[\n");
+    vector<Event> events;
+    for (auto& threadEvents : m_threadEvents)
+    {
+        lock_guard<mutex> lock(threadEvents->mutex);
+        events.insert(events.end(), threadEvents->events.begin(), threadEvents->events.end());
+    }
+
+    bool first = true;
+    for (const Event& event : events)
+    {
+        if (event.start < m_startTime)
+        {
+            continue;
+        }
+
+        if (!first)
+        {
+            fprintf(fp, ",\n");
+        }
+        first = false;
+
+        // Trace Event timestamps are in microseconds
+        fprintf(
+            fp,
+            "{\"name\":\"%s\",\"cat\":\"%s\",\"ph\":\"X\",\"ts\":%0.3f,\"dur\":%0.3f,\"pid\":1,\"tid\":%u}",
+            event.name,
+            event.category,
+            (double)(event.start - m_startTime) / 1000.0,
+            (double)event.duration / 1000.0,
+            event.thread);
+    }
+    unsigned int dropped = m_dropped;
+    fprintf(fp, "\n],\n\"displayTimeUnit\":\"ms\",\n\"otherData\":{\"droppedEvents\":%u}}\n", dropped);
+
+    log(INFO, "writeTrace: Wrote %lu events to %s", events.size(), path.c_str());
+    if (dropped > 0)
+    {
+        log(WARN, "writeTrace: %u events were dropped", dropped);
+    }
+
+    m_mutex->unlock();
+
+    fclose(fp);
+    return true;
+}
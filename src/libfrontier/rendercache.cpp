@@ -0,0 +1,171 @@
+/*
+ * Frontier - A toolkit for creating simple OS-independent user interfaces
+ * Copyright (C) 2020 Ian Parker <ian@geekprojects.com>
+ *
+ * This file is part of Frontier.
+ *
+ * Frontier is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * Frontier is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with Frontier.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <frontier/rendercache.h>
+
+using namespace std;
+using namespace Frontier;
+using namespace Geek;
+using namespace Geek::Gfx;
+
+RenderCache::RenderCache() : Logger(L"RenderCache")
+{
+    m_budget = FRONTIER_RENDER_CACHE_BUDGET;
+    m_used = 0;
+}
+
+RenderCache::~RenderCache()
+{
+    clear();
+}
+
+Surface* RenderCache::get(Widget* widget, int width, int height, bool highDPI, bool& created)
+{
+    created = false;
+
+    if (highDPI)
+    {
+        width *= 2;
+        height *= 2;
+    }
+    unsigned int size = width * height * 4;
+
+    auto it = m_entryMap.find(widget);
+    if (it != m_entryMap.end())
+    {
+        Entry& entry = *(it->second);
+        if (entry.surface->getWidth() == (uint32_t)width &&
+            entry.surface->getHeight() == (uint32_t)height &&
+            entry.surface->isHighDPI() == highDPI)
+        {
+            // Move to the front of the list
+            m_entries.splice(m_entries.begin(), m_entries, it->second);
+            return entry.surface;
+        }
+
+        // The Widget has changed size
+        remove(widget);
+    }
+
+    if (width <= 0 || height <= 0 || size > m_budget)
+    {
+        return NULL;
+    }
+
+    if (!evict(size))
+    {
+        return NULL;
+    }
+
+    Entry entry;
+    entry.widget = widget;
+    entry.size = size;
+    entry.pinned = false;
+    if (highDPI)
+    {
+        entry.surface = new HighDPISurface(width / 2, height / 2, 4);
+    }
+    else
+    {
+        entry.surface = new Surface(width, height, 4);
+    }
+
+    m_entries.push_front(entry);
+    m_entryMap.insert(make_pair(widget, m_entries.begin()));
+    m_used += size;
+
+    created = true;
+    return entry.surface;
+}
+
+void RenderCache::remove(Widget* widget)
+{
+    auto it = m_entryMap.find(widget);
+    if (it == m_entryMap.end())
+    {
+        return;
+    }
+
+    Entry& entry = *(it->second);
+    m_used -= entry.size;
+    delete entry.surface;
+
+    m_entries.erase(it->second);
+    m_entryMap.erase(it);
+}
+
+bool RenderCache::evict(unsigned int required)
+{
+    auto it = m_entries.end();
+    while (it != m_entries.begin() && m_used + required > m_budget)
+    {
+        it--;
+        if (it->pinned)
+        {
+            // Still being drawn in to
+            continue;
+        }
+
+#if 0
+        log(DEBUG, "evict: Evicting %p (%d bytes)", it->widget, it->size);
+#endif
+        m_used -= it->size;
+        delete it->surface;
+
+        m_entryMap.erase(it->widget);
+        it = m_entries.erase(it);
+    }
+    return m_used + required <= m_budget;
+}
+
+void RenderCache::pin(Widget* widget)
+{
+    auto it = m_entryMap.find(widget);
+    if (it != m_entryMap.end())
+    {
+        it->second->pinned = true;
+    }
+}
+
+void RenderCache::unpin(Widget* widget)
+{
+    auto it = m_entryMap.find(widget);
+    if (it != m_entryMap.end())
+    {
+        it->second->pinned = false;
+    }
+}
+
+void RenderCache::clear()
+{
+    for (Entry& entry : m_entries)
+    {
+        delete entry.surface;
+    }
+    m_entries.clear();
+    m_entryMap.clear();
+    m_used = 0;
+}
+
+void RenderCache::setBudget(unsigned int budget)
+{
+    m_budget = budget;
+    evict(0);
+}
@@ -36,6 +36,9 @@ using namespace Geek;
 
 #undef DEBUG_STYLE_PROPERTIES
 
+// Only prune unused computed styles once the cache has grown past this
+#define STYLE_CACHE_PRUNE_SIZE 1024
+
 #define STRINGIFY(x) XSTRINGIFY(x)
 #define XSTRINGIFY(x) #x
 
@@ -48,6 +51,7 @@ StyleEngine::StyleEngine() : Logger("StyleEngine")
 
 StyleEngine::~StyleEngine()
 {
+    clearStyleCache();
 }
 
 bool StyleEngine::init()
@@ -146,66 +150,405 @@ void StyleEngine::addRule(StyleRule* rule)
         }
     }
 
-    m_styleRules.push_back(make_pair(rule, specificity));
+    pair<StyleRule*, int> rulePair = make_pair(rule, specificity);
+    m_styleRules.push_back(rulePair);
+    indexRule(rulePair);
+    addDependencies(rule);
+
+    // Any shared styles may now be out of date
+    clearStyleCache();
+}
+
+bool StyleEngine::compareRules(const pair<StyleRule*, int>& elem1, const pair<StyleRule*, int>& elem2)
+{
+    if (elem1.second == elem2.second)
+    {
+        return elem1.first->getId() < elem2.first->getId();
+    }
+    else
+    {
+        return elem1.second < elem2.second;
+    }
+}
+
+void StyleEngine::indexRule(pair<StyleRule*, int> rulePair)
+{
+    StyleRule* rule = rulePair.first;
 
-    StyleComparator compFunctor = [](std::pair<StyleRule*, int> elem1 ,std::pair<StyleRule*, int> elem2)
+    StyleRuleList* bucket = &m_universalRules;
+    const vector<StyleSelector>& selectors = rule->getSelectors();
+    if (!selectors.empty())
     {
-        if (elem1.second == elem2.second)
+        // Only the rightmost selector has to match the Widget itself
+        const StyleSelector& selector = selectors.back();
+        if (selector.id.length() > 0)
         {
-            return elem1.first->getId() < elem2.first->getId();
+            bucket = &(m_idRules[selector.id]);
         }
-        else
+        else if (selector.className.length() > 0)
+        {
+            bucket = &(m_classRules[selector.className]);
+        }
+        else if (selector.widgetType.length() > 0 && selector.widgetType != L"*")
         {
-            return elem1.second < elem2.second;
+            bucket = &(m_typeRules[selector.widgetType]);
         }
-    };
+    }
 
-    std::sort(m_styleRules.begin(), m_styleRules.end(), compFunctor);
+    // Keep each bucket in cascade order
+    auto it = upper_bound(bucket->begin(), bucket->end(), rulePair, compareRules);
+    bucket->insert(it, rulePair);
 }
 
-unordered_map<string, Value> StyleEngine::getProperties(Widget* widget)
+unsigned int StyleEngine::getStateFlag(const string& state)
 {
-    vector<StyleRule*> matchedRules;
-    for (pair<StyleRule*, int> rulePair : m_styleRules)
+    if (state == "active")
     {
-        StyleRule* rule = rulePair.first;
-        if (rule->matches(widget))
+        return STYLE_STATE_ACTIVE;
+    }
+    else if (state == "selected")
+    {
+        return STYLE_STATE_SELECTED;
+    }
+    else if (state == "hover")
+    {
+        return STYLE_STATE_HOVER;
+    }
+    return 0;
+}
+
+void StyleEngine::addDependencies(StyleRule* rule)
+{
+    const vector<StyleSelector>& selectors = rule->getSelectors();
+    unsigned int i;
+    for (i = 0; i < selectors.size(); i++)
+    {
+        const StyleSelector& selector = selectors.at(i);
+
+        // Selectors to the left match ancestors
+        unsigned int invalidation = STYLE_INVALIDATE_SELF;
+        if (i < selectors.size() - 1)
+        {
+            invalidation = STYLE_INVALIDATE_DESCENDANTS;
+        }
+
+        if (selector.className.length() > 0)
+        {
+            m_classDependencies[selector.className] |= invalidation;
+        }
+
+        unsigned int state = getStateFlag(selector.state);
+        if (state != 0)
         {
-            matchedRules.push_back(rule);
+            StyleStateDependency dependency;
+            dependency.selector = selector;
+            dependency.selector.state = "";
+            dependency.state = state;
+            dependency.invalidation = invalidation;
+            m_stateDependencies.push_back(dependency);
+        }
+    }
+}
+
+unsigned int StyleEngine::getStateInvalidation(Widget* widget, unsigned int states)
+{
+    unsigned int invalidation = STYLE_INVALIDATE_NONE;
+    for (StyleStateDependency& dependency : m_stateDependencies)
+    {
+        if ((dependency.state & states) && (invalidation & dependency.invalidation) != dependency.invalidation)
+        {
+            if (dependency.selector.matches(widget))
+            {
+                invalidation |= dependency.invalidation;
+            }
         }
     }
+    return invalidation;
+}
 
-    matchedRules.push_back(widget->getWidgetStyle());
+unsigned int StyleEngine::getClassInvalidation(const wstring& className)
+{
+    auto it = m_classDependencies.find(className);
+    if (it != m_classDependencies.end())
+    {
+        return it->second;
+    }
+    return STYLE_INVALIDATE_NONE;
+}
 
-    unordered_map<string, Value> results;
-    for (auto rule : matchedRules)
+void StyleEngine::addCandidates(unordered_map<wstring, StyleRuleList>& index, const wstring& key, StyleRuleList& candidates)
+{
+    auto it = index.find(key);
+    if (it != index.end())
+    {
+        candidates.insert(candidates.end(), it->second.begin(), it->second.end());
+    }
+}
+
+void StyleEngine::matchRules(Widget* widget, unordered_map<string, Value>& results)
+{
+    StyleRuleList candidates;
+    candidates.insert(candidates.end(), m_universalRules.begin(), m_universalRules.end());
+
+    const wstring& widgetId = widget->getWidgetId();
+    if (widgetId.length() > 0)
+    {
+        addCandidates(m_idRules, widgetId, candidates);
+    }
+
+    for (const wstring& className : widget->getWidgetClasses())
+    {
+        addCandidates(m_classRules, className, candidates);
+    }
+
+    for (const wstring& widgetName : widget->getWidgetNames())
+    {
+        addCandidates(m_typeRules, widgetName, candidates);
+    }
+
+    // Each bucket is already sorted, but the buckets need merging
+    sort(candidates.begin(), candidates.end(), compareRules);
+
+    for (const pair<StyleRule*, int>& rulePair : candidates)
     {
+        StyleRule* rule = rulePair.first;
+        if (!rule->matches(widget))
+        {
+            continue;
+        }
+
 #ifdef DEBUG_STYLE_PROPERTIES
-        //int specificity = matchedRule.second;
-        //log(DEBUG, "getProperties: %d: %ls", specificity, rule->getKey().c_str());
+        log(DEBUG, "getProperties: %d: %ls", rulePair.second, rule->getKey().c_str());
 #endif
 
-        for (auto prop : rule->getProperties())
+        for (const auto& prop : rule->getProperties())
         {
-            auto it = results.find(prop.first);
-            if (it != results.end())
-            {
-                results.erase(it);
-            }
-            results.insert(make_pair(prop.first, prop.second));
+            results.insert_or_assign(prop.first, prop.second);
         }
     }
+}
+
+unordered_map<string, Value> StyleEngine::getProperties(Widget* widget)
+{
+    unordered_map<string, Value> results;
+    matchRules(widget, results);
+
+    for (const auto& prop : widget->getWidgetStyle()->getProperties())
+    {
+        results.insert_or_assign(prop.first, prop.second);
+    }
 
 #ifdef DEBUG_STYLE_PROPERTIES
     for (auto prop : results)
     {
-        log(DEBUG, "getProperties:     %s -> %lld (0x%llx)", prop.first.c_str(), prop.second, prop.second);
+        log(DEBUG, "getProperties:     %s -> %ls", prop.first.c_str(), prop.second.asString().c_str());
     }
 #endif
 
     return results;
 }
 
+wstring StyleEngine::getStyleSignature(Widget* widget)
+{
+    // Everything a StyleSelector can match on, for the Widget and its ancestors
+    wstring signature = L"";
+    for (Widget* current = widget; current != NULL; current = current->getParent())
+    {
+        for (const wstring& widgetName : current->getWidgetNames())
+        {
+            signature += widgetName + L",";
+        }
+        for (const wstring& className : current->getWidgetClasses())
+        {
+            signature += L"." + className;
+        }
+        const wstring& widgetId = current->getWidgetId();
+        if (widgetId.length() > 0)
+        {
+            signature += L"#" + widgetId;
+        }
+        signature += L":";
+        signature += current->isActive() ? L'a' : L'-';
+        signature += current->isSelected() ? L's' : L'-';
+        signature += current->isMouseOver() ? L'h' : L'-';
+        signature += L"/";
+    }
+    return signature;
+}
+
+ComputedStyle* StyleEngine::getComputedStyle(Widget* widget)
+{
+    wstring signature = getStyleSignature(widget);
+
+    ComputedStyle* style;
+    auto it = m_styleCache.find(signature);
+    if (it != m_styleCache.end())
+    {
+        style = it->second;
+    }
+    else
+    {
+        if (m_styleCache.size() >= STYLE_CACHE_PRUNE_SIZE)
+        {
+            pruneStyleCache();
+        }
+
+        unordered_map<string, Value> results;
+        matchRules(widget, results);
+        style = new ComputedStyle(results);
+        style->incRefCount();
+        m_styleCache.insert(make_pair(signature, style));
+    }
+
+    const unordered_map<string, Value>& widgetProperties = widget->getWidgetStyle()->getProperties();
+    if (!widgetProperties.empty())
+    {
+        // Styles set directly on the Widget make it unique
+        style = new ComputedStyle(*style, widgetProperties);
+    }
+
+    style->incRefCount();
+    return style;
+}
+
+void StyleEngine::pruneStyleCache()
+{
+    auto it = m_styleCache.begin();
+    while (it != m_styleCache.end())
+    {
+        // Only the cache is referring to this style
+        if (it->second->getRefCount() <= 1)
+        {
+            it->second->release();
+            it = m_styleCache.erase(it);
+        }
+        else
+        {
+            it++;
+        }
+    }
+}
+
+void StyleEngine::clearStyleCache()
+{
+    for (auto& entry : m_styleCache)
+    {
+        entry.second->release();
+    }
+    m_styleCache.clear();
+}
+
+static const char* g_stylePropertyNames[] =
+{
+#define FRONTIER_STYLE_PROPERTY_NAME(id, name) name,
+    FRONTIER_STYLE_PROPERTIES(FRONTIER_STYLE_PROPERTY_NAME)
+#undef FRONTIER_STYLE_PROPERTY_NAME
+};
+
+const char* Frontier::getStylePropertyName(StyleProperty property)
+{
+    if (property >= STYLE_PROPERTY_COUNT)
+    {
+        return NULL;
+    }
+    return g_stylePropertyNames[property];
+}
+
+static unordered_map<string, StyleProperty> createStylePropertyIds()
+{
+    unordered_map<string, StyleProperty> propertyIds;
+    int i;
+    for (i = 0; i < STYLE_PROPERTY_COUNT; i++)
+    {
+        propertyIds.insert(make_pair(string(g_stylePropertyNames[i]), (StyleProperty)i));
+    }
+    return propertyIds;
+}
+
+StyleProperty Frontier::findStyleProperty(const string& name)
+{
+    static const unordered_map<string, StyleProperty> propertyIds = createStylePropertyIds();
+
+    auto it = propertyIds.find(name);
+    if (it != propertyIds.end())
+    {
+        return it->second;
+    }
+    return STYLE_PROPERTY_UNKNOWN;
+}
+
+ComputedStyle::ComputedStyle(const unordered_map<string, Value>& properties)
+{
+    for (const auto& prop : properties)
+    {
+        set(prop.first, prop.second);
+    }
+}
+
+ComputedStyle::ComputedStyle(const ComputedStyle& base, const unordered_map<string, Value>& properties)
+    : FrontierObject(), m_hasValue(base.m_hasValue), m_otherProperties(base.m_otherProperties)
+{
+    int i;
+    for (i = 0; i < STYLE_PROPERTY_COUNT; i++)
+    {
+        m_values[i] = base.m_values[i];
+    }
+
+    for (const auto& prop : properties)
+    {
+        set(prop.first, prop.second);
+    }
+}
+
+void ComputedStyle::set(const string& property, const Value& value)
+{
+    StyleProperty id = findStyleProperty(property);
+    if (id != STYLE_PROPERTY_UNKNOWN)
+    {
+        m_values[id] = value;
+        m_hasValue.set(id);
+    }
+    else
+    {
+        m_otherProperties.insert_or_assign(property, value);
+    }
+}
+
+bool ComputedStyle::has(const string& property) const
+{
+    StyleProperty id = findStyleProperty(property);
+    if (id != STYLE_PROPERTY_UNKNOWN)
+    {
+        return has(id);
+    }
+    return (m_otherProperties.find(property) != m_otherProperties.end());
+}
+
+Value ComputedStyle::get(const string& property) const
+{
+    StyleProperty id = findStyleProperty(property);
+    if (id != STYLE_PROPERTY_UNKNOWN)
+    {
+        return get(id);
+    }
+
+    auto it = m_otherProperties.find(property);
+    if (it != m_otherProperties.end())
+    {
+        return it->second;
+    }
+    return Value();
+}
+
+void ComputedStyle::release()
+{
+    decRefCount();
+    if (getRefCount() <= 0)
+    {
+        delete this;
+    }
+}
+
 void StyleRule::addSelector(StyleSelector selector)
 {
     m_selectors.push_back(selector);
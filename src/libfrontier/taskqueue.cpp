@@ -0,0 +1,111 @@
+/*
+ * Frontier - A toolkit for creating simple OS-independent user interfaces
+ * Copyright (C) 2020 Ian Parker <ian@geekprojects.com>
+ *
+ * This file is part of Frontier.
+ *
+ * Frontier is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * Frontier is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with Frontier.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <frontier/taskqueue.h>
+
+using namespace Frontier;
+using namespace std;
+
+TaskQueue::TaskQueue()
+{
+    m_head = NULL;
+}
+
+TaskQueue::~TaskQueue()
+{
+    TaskNode* node = m_head.exchange(NULL);
+    while (node != NULL)
+    {
+        TaskNode* next = node->next;
+        delete node;
+        node = next;
+    }
+}
+
+bool TaskQueue::push(TaskNode* first, TaskNode* last)
+{
+    TaskNode* head = m_head.load(memory_order_relaxed);
+    do
+    {
+        last->next = head;
+    }
+    while (!m_head.compare_exchange_weak(head, first, memory_order_release, memory_order_relaxed));
+
+    return head == NULL;
+}
+
+bool TaskQueue::post(Task task)
+{
+    TaskNode* node = new TaskNode();
+    node->task = std::move(task);
+    return push(node, node);
+}
+
+bool TaskQueue::post(vector<Task>& tasks)
+{
+    if (tasks.empty())
+    {
+        return false;
+    }
+
+    // The list is newest first, so link them up in reverse
+    TaskNode* first = NULL;
+    TaskNode* last = NULL;
+    for (Task& task : tasks)
+    {
+        TaskNode* node = new TaskNode();
+        node->task = std::move(task);
+        node->next = first;
+        first = node;
+        if (last == NULL)
+        {
+            last = node;
+        }
+    }
+    tasks.clear();
+
+    return push(first, last);
+}
+
+unsigned int TaskQueue::run()
+{
+    TaskNode* node = m_head.exchange(NULL, memory_order_acquire);
+
+    // Put them back in to the order they were posted
+    TaskNode* ordered = NULL;
+    while (node != NULL)
+    {
+        TaskNode* next = node->next;
+        node->next = ordered;
+        ordered = node;
+        node = next;
+    }
+
+    unsigned int count = 0;
+    while (ordered != NULL)
+    {
+        TaskNode* next = ordered->next;
+        ordered->task();
+        delete ordered;
+        ordered = next;
+        count++;
+    }
+    return count;
+}
@@ -0,0 +1,437 @@
+/*
+ * Frontier - A toolkit for creating simple OS-independent user interfaces
+ * Copyright (C) 2020 Ian Parker <ian@geekprojects.com>
+ *
+ * This file is part of Frontier.
+ *
+ * Frontier is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * Frontier is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with Frontier.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <frontier/textcache.h>
+#include <frontier/displaylist.h>
+
+using namespace std;
+using namespace Frontier;
+using namespace Geek;
+using namespace Geek::Gfx;
+
+// Size of each atlas page
+#define TEXT_CACHE_PAGE_SIZE 512
+
+// When all pages are full, the cache is flushed
+#define TEXT_CACHE_MAX_PAGES 8
+
+#define TEXT_CACHE_MAX_WIDTHS 4096
+
+// Extra space to the right of a glyph, for glyphs that draw past their advance
+#define TEXT_CACHE_GLYPH_OVERHANG 2
+
+TextCache::TextCache() : Logger(L"TextCache")
+{
+}
+
+TextCache::~TextCache()
+{
+    flush();
+}
+
+// Text drawn to a RecordingSurface is kept as a run, in the recorder's coordinates
+static void recordText(TextCache* textCache, RecordingSurface* recorder, Surface* surface, FontHandle* font, int x, int y, const wstring& text, uint32_t colour)
+{
+    Geek::Rect origin = surface->absolute();
+    Frontier::Rect clip(origin.x, origin.y, surface->getWidth(), surface->getHeight());
+    recorder->getDisplayList()->addText(textCache, font, origin.x + x, origin.y + y, text, colour, clip);
+}
+
+bool TextCache::write(Surface* surface, FontHandle* font, int x, int y, const wstring& text, uint32_t colour)
+{
+    RecordingSurface* recorder = RecordingSurface::getRecorder(surface);
+    if (recorder != NULL)
+    {
+        recordText(this, recorder, surface, font, x, y, text, colour);
+        return true;
+    }
+
+    for (wchar_t c : text)
+    {
+        x += drawGlyph(surface, font, x, y, c, colour);
+    }
+    return true;
+}
+
+int TextCache::write(Surface* surface, FontHandle* font, int x, int y, wchar_t c, uint32_t colour)
+{
+    RecordingSurface* recorder = RecordingSurface::getRecorder(surface);
+    if (recorder != NULL)
+    {
+        recordText(this, recorder, surface, font, x, y, wstring(1, c), colour);
+        return width(font, c);
+    }
+    return drawGlyph(surface, font, x, y, c, colour);
+}
+
+int TextCache::drawGlyph(Surface* surface, FontHandle* font, int x, int y, wchar_t c, uint32_t colour)
+{
+    bool highDPI = surface->isHighDPI();
+
+    GlyphKey key;
+    key.font = font;
+    key.c = c;
+    key.colour = colour;
+    key.highDPI = highDPI;
+
+    {
+        shared_lock<shared_mutex> lock(m_mutex);
+        auto it = m_glyphs.find(key);
+        if (it != m_glyphs.end())
+        {
+            return blit(surface, x, y, &(it->second), highDPI);
+        }
+    }
+
+    unique_lock<shared_mutex> lock(m_mutex);
+    const Glyph* glyph = getGlyph(font, c, colour, highDPI);
+    if (glyph == NULL)
+    {
+        // Too big for the atlas
+        {
+            lock_guard<mutex> fontLock(m_fontMutex);
+            font->write(surface, x, y, wstring(1, c), colour);
+        }
+        return measure(font, wstring(1, c));
+    }
+
+    return blit(surface, x, y, glyph, highDPI);
+}
+
+int TextCache::blit(Surface* surface, int x, int y, const Glyph* glyph, bool highDPI)
+{
+    if (!glyph->empty)
+    {
+        int scale = highDPI ? 2 : 1;
+        surface->blit(
+            x, y,
+            m_pages.at(glyph->page).surface,
+            glyph->rect.x * scale, glyph->rect.y * scale,
+            glyph->rect.width * scale, glyph->rect.height * scale,
+            true);
+    }
+    return glyph->advance;
+}
+
+int TextCache::width(FontHandle* font, const wstring& text)
+{
+    WidthKey key;
+    key.font = font;
+    key.text = text;
+
+    {
+        shared_lock<shared_mutex> lock(m_mutex);
+        auto it = m_widths.find(key);
+        if (it != m_widths.end())
+        {
+            return it->second;
+        }
+    }
+
+    unique_lock<shared_mutex> lock(m_mutex);
+    return measure(font, text);
+}
+
+int TextCache::width(FontHandle* font, wchar_t c)
+{
+    return width(font, wstring(1, c));
+}
+
+int TextCache::measure(FontHandle* font, const wstring& text)
+{
+    WidthKey key;
+    key.font = font;
+    key.text = text;
+
+    auto it = m_widths.find(key);
+    if (it != m_widths.end())
+    {
+        return it->second;
+    }
+
+    if (m_widths.size() >= TEXT_CACHE_MAX_WIDTHS)
+    {
+        m_widths.clear();
+    }
+
+    int w = 0;
+    if (text.length() == 1)
+    {
+        lock_guard<mutex> fontLock(m_fontMutex);
+        w = font->width(text);
+    }
+    else
+    {
+        // Text is drawn a glyph at a time, so it has to be measured the same way
+        for (wchar_t c : text)
+        {
+            w += measure(font, wstring(1, c));
+        }
+    }
+    m_widths.insert(make_pair(key, w));
+    return w;
+}
+
+bool TextCache::allocate(int width, int height, bool highDPI, unsigned int& page, Rect& rect)
+{
+    for (page = 0; page < m_pages.size(); page++)
+    {
+        AtlasPage& atlasPage = m_pages.at(page);
+        if (atlasPage.highDPI != highDPI)
+        {
+            continue;
+        }
+
+        if (atlasPage.shelfX + width > TEXT_CACHE_PAGE_SIZE)
+        {
+            // Start a new shelf
+            atlasPage.shelfX = 0;
+            atlasPage.shelfY += atlasPage.shelfHeight;
+            atlasPage.shelfHeight = 0;
+        }
+        if (atlasPage.shelfY + height > TEXT_CACHE_PAGE_SIZE)
+        {
+            continue;
+        }
+
+        rect = Rect(atlasPage.shelfX, atlasPage.shelfY, width, height);
+        atlasPage.shelfX += width;
+        atlasPage.shelfHeight = MAX(atlasPage.shelfHeight, height);
+        return true;
+    }
+
+    if (m_pages.size() >= TEXT_CACHE_MAX_PAGES)
+    {
+        return false;
+    }
+
+    AtlasPage atlasPage;
+    if (highDPI)
+    {
+        atlasPage.surface = new HighDPISurface(TEXT_CACHE_PAGE_SIZE, TEXT_CACHE_PAGE_SIZE, 4);
+    }
+    else
+    {
+        atlasPage.surface = new Surface(TEXT_CACHE_PAGE_SIZE, TEXT_CACHE_PAGE_SIZE, 4);
+    }
+    atlasPage.surface->clear(0);
+    atlasPage.highDPI = highDPI;
+    atlasPage.shelfX = width;
+    atlasPage.shelfY = 0;
+    atlasPage.shelfHeight = height;
+    m_pages.push_back(atlasPage);
+
+    page = m_pages.size() - 1;
+    rect = Rect(0, 0, width, height);
+    return true;
+}
+
+const TextCache::Glyph* TextCache::getCoverage(FontHandle* font, wchar_t c, bool highDPI)
+{
+    GlyphKey key;
+    key.font = font;
+    key.c = c;
+    key.colour = 0;
+    key.highDPI = highDPI;
+
+    auto it = m_coverage.find(key);
+    if (it != m_coverage.end())
+    {
+        return &(it->second);
+    }
+
+    Glyph glyph;
+    glyph.advance = measure(font, wstring(1, c));
+
+    int glyphWidth = glyph.advance + TEXT_CACHE_GLYPH_OVERHANG;
+    int glyphHeight = font->getPixelHeight();
+    if (glyphWidth > TEXT_CACHE_PAGE_SIZE || glyphHeight > TEXT_CACHE_PAGE_SIZE)
+    {
+        return NULL;
+    }
+
+    if (!allocate(glyphWidth, glyphHeight, highDPI, glyph.page, glyph.rect))
+    {
+        return NULL;
+    }
+
+    Surface* atlas = m_pages.at(glyph.page).surface;
+    atlas->drawRectFilled(glyph.rect.x, glyph.rect.y, glyph.rect.width, glyph.rect.height, 0xff000000);
+
+    SurfaceViewPort viewport(atlas, glyph.rect.x, glyph.rect.y, glyph.rect.width, glyph.rect.height);
+    {
+        lock_guard<mutex> fontLock(m_fontMutex);
+        font->write(&viewport, 0, 0, wstring(1, c), 0xffffffff);
+    }
+
+    // Check whether there is anything to draw, for example for spaces
+    int scale = highDPI ? 2 : 1;
+    int stride = TEXT_CACHE_PAGE_SIZE * scale;
+    uint32_t* data = (uint32_t*)atlas->getData();
+    glyph.empty = true;
+    for (int y = glyph.rect.y * scale; glyph.empty && y < (glyph.rect.y + glyph.rect.height) * scale; y++)
+    {
+        for (int x = glyph.rect.x * scale; x < (glyph.rect.x + glyph.rect.width) * scale; x++)
+        {
+            if (data[(y * stride) + x] & 0xff0000)
+            {
+                glyph.empty = false;
+                break;
+            }
+        }
+    }
+
+    auto result = m_coverage.insert(make_pair(key, glyph));
+    return &(result.first->second);
+}
+
+const TextCache::Glyph* TextCache::getGlyph(FontHandle* font, wchar_t c, uint32_t colour, bool highDPI)
+{
+    GlyphKey key;
+    key.font = font;
+    key.c = c;
+    key.colour = colour;
+    key.highDPI = highDPI;
+
+    auto it = m_glyphs.find(key);
+    if (it != m_glyphs.end())
+    {
+        return &(it->second);
+    }
+
+    const Glyph* coverage = getCoverage(font, c, highDPI);
+    Glyph glyph;
+    if (coverage != NULL)
+    {
+        glyph = *coverage;
+    }
+
+    if (coverage == NULL || (!glyph.empty && !allocate(glyph.rect.width, glyph.rect.height, highDPI, glyph.page, glyph.rect)))
+    {
+        if (m_pages.size() < TEXT_CACHE_MAX_PAGES)
+        {
+            // The glyph is too big
+            return NULL;
+        }
+
+        // The atlas is full, start again
+#if 0
+        log(DEBUG, "getGlyph: Flushing atlas");
+#endif
+        flush();
+        coverage = getCoverage(font, c, highDPI);
+        if (coverage == NULL)
+        {
+            return NULL;
+        }
+        glyph = *coverage;
+        if (!glyph.empty && !allocate(glyph.rect.width, glyph.rect.height, highDPI, glyph.page, glyph.rect))
+        {
+            return NULL;
+        }
+    }
+
+    if (!glyph.empty)
+    {
+        // Convert the coverage to an alpha mask of the colour
+        int scale = highDPI ? 2 : 1;
+        int stride = TEXT_CACHE_PAGE_SIZE * scale;
+        uint32_t* src = (uint32_t*)m_pages.at(coverage->page).surface->getData();
+        uint32_t* dest = (uint32_t*)m_pages.at(glyph.page).surface->getData();
+        uint32_t alpha = colour >> 24;
+        uint32_t rgb = colour & 0xffffff;
+
+        int srcX = coverage->rect.x * scale;
+        int srcY = coverage->rect.y * scale;
+        int destX = glyph.rect.x * scale;
+        int destY = glyph.rect.y * scale;
+        for (int y = 0; y < glyph.rect.height * scale; y++)
+        {
+            uint32_t* srcRow = src + ((srcY + y) * stride) + srcX;
+            uint32_t* destRow = dest + ((destY + y) * stride) + destX;
+            for (int x = 0; x < glyph.rect.width * scale; x++)
+            {
+                uint32_t a = (((srcRow[x] >> 16) & 0xff) * alpha) / 255;
+                destRow[x] = (a << 24) | rgb;
+            }
+        }
+    }
+
+    auto result = m_glyphs.insert(make_pair(key, glyph));
+    return &(result.first->second);
+}
+
+void TextCache::removeFont(FontHandle* font)
+{
+    unique_lock<shared_mutex> lock(m_mutex);
+    for (auto it = m_coverage.begin(); it != m_coverage.end(); )
+    {
+        if (it->first.font == font)
+        {
+            it = m_coverage.erase(it);
+        }
+        else
+        {
+            it++;
+        }
+    }
+
+    for (auto it = m_glyphs.begin(); it != m_glyphs.end(); )
+    {
+        if (it->first.font == font)
+        {
+            it = m_glyphs.erase(it);
+        }
+        else
+        {
+            it++;
+        }
+    }
+
+    for (auto it = m_widths.begin(); it != m_widths.end(); )
+    {
+        if (it->first.font == font)
+        {
+            it = m_widths.erase(it);
+        }
+        else
+        {
+            it++;
+        }
+    }
+}
+
+void TextCache::clear()
+{
+    unique_lock<shared_mutex> lock(m_mutex);
+    flush();
+}
+
+void TextCache::flush()
+{
+    for (AtlasPage& page : m_pages)
+    {
+        delete page.surface;
+    }
+    m_pages.clear();
+    m_coverage.clear();
+    m_glyphs.clear();
+    m_widths.clear();
+}
@@ -20,6 +20,7 @@
 
 
 #include <frontier/frontier.h>
+#include <frontier/displaylist.h>
 
 using namespace std;
 using namespace Frontier;
@@ -119,6 +120,10 @@ void UITheme::drawIcon(Geek::Gfx::Surface* surface, int x, int y, wchar_t icon,
     wstring text = L"";
     text += icon;
 
+    // Icons are drawn by FreeType, not the TextCache
+    RecordingSurface::markIncomplete(surface);
+
+    lock_guard<mutex> lock(m_app->getTextCache()->getFontMutex());
     FontManager* fm = m_app->getFontManager();
     fm->write(m_iconFont,
         surface,
@@ -135,6 +140,7 @@ int UITheme::getIconWidth(wchar_t icon) const
     wstring text = L"";
     text += icon;
 
+    lock_guard<mutex> lock(m_app->getTextCache()->getFontMutex());
     FontManager* fm = m_app->getFontManager();
     return fm->width(m_iconFont, text);
 }
@@ -82,6 +82,11 @@ void Frame::remove(Widget* widget)
 }
 
 bool Frame::draw(Surface* surface)
+{
+    return draw(surface, Rect(0, 0, getWidth(), getHeight()));
+}
+
+bool Frame::draw(Surface* surface, Rect visible)
 {
     bool dirtySize = isDirty(DIRTY_SIZE);
     if (dirtySize)
@@ -89,14 +94,17 @@ bool Frame::draw(Surface* surface)
         drawBorder(surface);
     }
 
+    vector<Widget*> dirtyChildren;
     for (Widget* child : m_children)
     {
-        if (dirtySize || child->isDirty() || child->hasChildren())
+        // Children outside of the visible area will be drawn when they're scrolled in to view
+        Rect childRect(child->getX(), child->getY(), child->getWidth(), child->getHeight());
+        if ((dirtySize || child->isDirty()) && visible.intersects(childRect))
         {
-            SurfaceViewPort viewport(surface, child->getX(), child->getY(), child->getWidth(), child->getHeight());
-            child->draw(&viewport, Rect(0, 0, child->getWidth(), child->getHeight()));
+            dirtyChildren.push_back(child);
         }
     }
+    drawChildren(surface, dirtyChildren, visible);
     return true;
 }
 
@@ -112,10 +120,7 @@ void Frame::calculateSize()
     BoxModel boxModel = getBoxModel();
     for (Widget* child : m_children)
     {
-        if (child->isDirty(DIRTY_SIZE) || child->isDirty(DIRTY_STYLE))
-        {
-            child->calculateSize();
-        }
+        child->measure();
 
         Size childMin = child->getMinSize();
         Size childMax = child->getMaxSize();
@@ -163,11 +168,11 @@ void Frame::calculateSize()
     m_maxSize.width += boxModel.getWidth();
     m_maxSize.height += boxModel.getHeight();
 
-    if (getStyle("expand-horizontal").asBool())
+    if (getStyle(STYLE_EXPAND_HORIZONTAL).asBool())
     {
         m_maxSize.width = WIDGET_SIZE_UNLIMITED;
     }
-    if (getStyle("expand-vertical").asBool())
+    if (getStyle(STYLE_EXPAND_VERTICAL).asBool())
     {
         m_maxSize.height = WIDGET_SIZE_UNLIMITED;
     }
@@ -324,14 +329,14 @@ void Frame::layout()
     int minorPos = 0;
 
     int horizontalAlign = FRONTIER_HORIZONTAL_ALIGN_LEFT;
-    if (hasStyle("align-horizontal"))
+    if (hasStyle(STYLE_ALIGN_HORIZONTAL))
     {
-        horizontalAlign = getStyle("align-horizontal").asInt();
+        horizontalAlign = getStyle(STYLE_ALIGN_HORIZONTAL).asInt();
     }
     int verticalAlign = FRONTIER_VERTICAL_ALIGN_TOP;
-    if (hasStyle("align-vertical"))
+    if (hasStyle(STYLE_ALIGN_VERTICAL))
     {
-        verticalAlign = getStyle("align-vertical").asInt();
+        verticalAlign = getStyle(STYLE_ALIGN_VERTICAL).asInt();
     }
     int majorAlign;
     int minorAlign;
@@ -385,10 +390,13 @@ void Frame::layout()
 
         if (isDirty(DIRTY_SIZE))
         {
-            child->setDirty(DIRTY_CONTENT | DIRTY_SIZE, true);
+            child->setDirty(DIRTY_CONTENT | DIRTY_SIZE, true, false);
         }
 
-        child->layout();
+        if (child->needsLayout())
+        {
+            child->layout();
+        }
     }
 }
 
@@ -400,12 +408,10 @@ Widget* Frame::handleEvent(Event* event)
         int x = mouseEvent->x;
         int y = mouseEvent->y;
 
-        for (Widget* child : m_children)
+        Widget* child = findChildAt(x, y);
+        if (child != NULL)
         {
-            if (child->intersects(x, y))
-            {
-                return child->handleEvent(event);
-            }
+            return child->handleEvent(event);
         }
         if (event->eventType == FRONTIER_EVENT_MOUSE_MOTION)
         {
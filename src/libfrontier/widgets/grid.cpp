@@ -64,7 +64,7 @@ void Grid::clearChildren()
 
 void Grid::put(int x, int y, Widget* widget)
 {
-    uint32_t colour = getStyle("background-color").asInt();
+    uint32_t colour = getStyle(STYLE_BACKGROUND_COLOR).asInt();
     put(x, y, widget, colour);
 }
 
@@ -136,17 +136,22 @@ Size Grid::getGridSize()
 
 void Grid::calculateSize()
 {
-    freeSizes();
-
     Size gridSize = getGridSize();
 #if 0
     log(DEBUG, "calculateSize: gridSize=%d,%d", gridSize.width, gridSize.height);
 #endif
 
-    m_colMinSizes = new int[gridSize.width];
-    m_colMaxSizes = new int[gridSize.width];
-    m_rowMinSizes = new int[gridSize.height];
-    m_rowMaxSizes = new int[gridSize.height];
+    // Only reallocate if the number of rows or columns has changed
+    if (m_colMinSizes == NULL || gridSize != m_sizesGridSize)
+    {
+        freeSizes();
+
+        m_colMinSizes = new int[gridSize.width];
+        m_colMaxSizes = new int[gridSize.width];
+        m_rowMinSizes = new int[gridSize.height];
+        m_rowMaxSizes = new int[gridSize.height];
+        m_sizesGridSize = gridSize;
+    }
 
     memset(m_colMinSizes, 0, sizeof(int) * gridSize.width);
     memset(m_colMaxSizes, 0, sizeof(int) * gridSize.width);
@@ -158,10 +163,7 @@ void Grid::calculateSize()
 
     for (GridItem* item : m_grid)
     {
-        if (item->widget->isDirty(DIRTY_SIZE) || item->widget->isDirty(DIRTY_STYLE))
-        {
-            item->widget->calculateSize();
-        }
+        item->widget->measure();
 
         int col = item->x;
         int row = item->y;
@@ -350,7 +352,10 @@ void Grid::layout()
                 //Size minSize = item->widget->getMinSize();
                 item->widget->setPosition(x, y);
                 item->widget->setSize(Size(colSizes[col], rowSizes[row]));
-                item->widget->layout();
+                if (item->widget->needsLayout())
+                {
+                    item->widget->layout();
+                }
             }
 
 #if 0
@@ -364,26 +369,28 @@ void Grid::layout()
 }
 
 bool Grid::draw(Geek::Gfx::Surface* surface)
+{
+    return draw(surface, Rect(0, 0, getWidth(), getHeight()));
+}
+
+bool Grid::draw(Geek::Gfx::Surface* surface, Rect visible)
 {
     bool dirtySize = isDirty(DIRTY_SIZE);
     if (dirtySize)
     {
         drawBorder(surface);
     }
+    vector<Widget*> dirtyChildren;
     for (GridItem* item : m_grid)
     {
         Widget* child = item->widget;
-        if (dirtySize || child->isDirty() || child->hasChildren())
+        Rect childRect(child->getX(), child->getY(), child->getWidth(), child->getHeight());
+        if ((dirtySize || child->isDirty()) && visible.intersects(childRect))
         {
-            SurfaceViewPort viewport(surface, child->getX(), child->getY(), child->getWidth(), child->getHeight());
-            //viewport.clear(item->background);
-            child->draw(&viewport, Rect(0, 0, child->getWidth(), child->getHeight()));
+            dirtyChildren.push_back(child);
         }
-
-#if 0
-        viewport.drawRect(0, 0, child->getWidth(), child->getHeight(), 0x00ff00);
-#endif
     }
+    drawChildren(surface, dirtyChildren, visible);
     return true;
 }
 
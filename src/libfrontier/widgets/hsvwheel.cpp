@@ -67,11 +67,14 @@ bool HSVWheel::draw(Geek::Gfx::Surface* surface)
     int drawY = boxModel.getTop();
     HighDPISurface* highDPISurface = NULL;
     if (surface->isHighDPI())
+    {
+        // Draw at full resolution, unless this is being recorded
+        highDPISurface = dynamic_cast<HighDPISurface*>(surface->getRoot());
+    }
+    if (highDPISurface != NULL)
     {
         width *= 2;
         height *= 2;
-        highDPISurface = (HighDPISurface*)surface->getRoot();
-
         Geek::Rect r = surface->absolute();
         drawX += r.x;
         drawY += r.y;
@@ -101,7 +104,7 @@ bool HSVWheel::draw(Geek::Gfx::Surface* surface)
                 hsv[0] -= 2.0 / 6.0;
                 Colour c = Colour::fromHSB(hsv[0], hsv[1], hsv[2]);
 
-                if (surface->isHighDPI())
+                if (highDPISurface != NULL)
                 {
                     highDPISurface->drawSubPixel(x + drawX, y + drawY, c.getInt32());
                 }
@@ -116,7 +116,7 @@ void Label::calculateSize()
                 lines++;
             }
 
-            int w = font->width(line);
+            int w = m_app->getTextCache()->width(font, line);
             if (w > m_minSize.width)
             {
                 m_minSize.width = w;
@@ -146,7 +146,7 @@ void Label::calculateSize()
     m_minSize.width += boxModel.getWidth();
     m_minSize.height = (m_lineHeight * lines) + boxModel.getHeight();
 
-    if (getStyle("expand-horizontal").asBool())
+    if (getStyle(STYLE_EXPAND_HORIZONTAL).asBool())
     {
         m_maxSize.width = WIDGET_SIZE_UNLIMITED;
     }
@@ -155,7 +155,7 @@ void Label::calculateSize()
         m_maxSize.width = m_minSize.width;
     }
 
-    if (getStyle("expand-vertical").asBool())
+    if (getStyle(STYLE_EXPAND_VERTICAL).asBool())
     {
         m_maxSize.height = WIDGET_SIZE_UNLIMITED;
     }
@@ -197,7 +197,7 @@ bool Label::draw(Surface* surface)
             {
                 line += text[pos];
             }
-            int w = font->width(line);
+            int w = m_app->getTextCache()->width(font, line);
             int x = 0;
 
             if (m_icon != NULL)
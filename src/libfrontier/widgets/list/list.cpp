@@ -34,6 +34,12 @@ List::List(FrontierApp* ui) : Widget(ui, L"List")
     m_selected = NULL;
     m_horizontal = false;
     m_listMutex = Thread::createMutex();
+
+    m_model = NULL;
+    m_selectedRow = -1;
+    m_firstRow = 0;
+    m_rebindRows = true;
+    m_hasVisibleArea = false;
 }
 
 List::List(FrontierApp* ui, bool horizontal) : Widget(ui, L"List")
@@ -41,6 +47,12 @@ List::List(FrontierApp* ui, bool horizontal) : Widget(ui, L"List")
     m_selected = NULL;
     m_horizontal = horizontal;
     m_listMutex = Thread::createMutex();
+
+    m_model = NULL;
+    m_selectedRow = -1;
+    m_firstRow = 0;
+    m_rebindRows = true;
+    m_hasVisibleArea = false;
 }
 
 List::~List()
@@ -54,14 +66,33 @@ void List::calculateSize()
     m_maxSize.set(0, 0);
     //m_maxSize.set(WIDGET_SIZE_UNLIMITED, WIDGET_SIZE_UNLIMITED);
 
+    if (m_model != NULL)
+    {
+        // Only the visible rows have ListItems, so the height comes from the model
+        m_listMutex->lock();
+        for (Widget* item : m_children)
+        {
+            item->measure();
+            Size itemMin = item->getMinSize();
+            m_minSize.setMaxWidth(itemMin);
+        }
+        m_listMutex->unlock();
+
+        int height = getRowOffset(m_model->getRowCount());
+        m_minSize.height = height;
+        m_maxSize.set(WIDGET_SIZE_UNLIMITED, height);
+
+        Size borderSize = getBorderSize();
+        m_minSize += borderSize;
+        m_maxSize += borderSize;
+        return;
+    }
+
     m_listMutex->lock();
 
     for (Widget* item : m_children)
     {
-        if (item->isDirty(DIRTY_SIZE))
-        {
-            item->calculateSize();
-        }
+        item->measure();
 
         Size itemMin = item->getMinSize();
         Size itemMax = item->getMaxSize();
@@ -112,6 +143,22 @@ void List::layout()
     int x = 2;
     int y = 2;
 
+    if (m_model != NULL)
+    {
+        // The visible rows are bound when drawing, just update the ones we have
+        m_listMutex->lock();
+        unsigned int row = m_firstRow;
+        for (Widget* item : m_children)
+        {
+            item->setSize(Size(m_setSize.width, m_model->getRowHeight(row)));
+            item->setPosition(x, y + getRowOffset(row));
+            item->layout();
+            row++;
+        }
+        m_listMutex->unlock();
+        return;
+    }
+
     m_listMutex->lock();
     int idx;
     vector<Widget*>::iterator it;
@@ -164,6 +211,12 @@ void List::layout()
 
 bool List::draw(Surface* surface, Rect visible)
 {
+    if (m_model != NULL)
+    {
+        // We may only be asked to draw part of what is visible
+        bindRows(m_hasVisibleArea ? m_visibleArea : visible);
+    }
+
     drawBorder(surface);
 
     m_listMutex->lock();
@@ -200,6 +253,12 @@ bool List::draw(Surface* surface, Rect visible)
     return true;
 }
 
+void List::setVisibleArea(Rect visible)
+{
+    m_visibleArea = visible;
+    m_hasVisibleArea = true;
+}
+
 Widget* List::handleEvent(Event* event)
 {
     if (event->is(FRONTIER_EVENT_MOUSE))
@@ -208,15 +267,12 @@ Widget* List::handleEvent(Event* event)
 
         m_listMutex->lock();
 
-        for (Widget* child : m_children)
+        Widget* child = findChildAt(mouseEvent->x, mouseEvent->y);
+        m_listMutex->unlock();
+        if (child != NULL)
         {
-            if (child->intersects(mouseEvent->x, mouseEvent->y))
-            {
-                m_listMutex->unlock();
-                return child->handleEvent(event);
-            }
+            return child->handleEvent(event);
         }
-        m_listMutex->unlock();
 
         if (event->eventType == FRONTIER_EVENT_MOUSE_MOTION)
         {
@@ -238,6 +294,10 @@ void List::clearItems(bool setDirty)
     m_children.clear();
     m_listMutex->unlock();
 
+    clearRecyclePool();
+    m_firstRow = 0;
+    m_rebindRows = true;
+
     m_selected = NULL;
 
     if (setDirty)
@@ -248,6 +308,12 @@ void List::clearItems(bool setDirty)
 
 void List::addItem(ListItem* item)
 {
+    if (m_model != NULL)
+    {
+        log(ERROR, "addItem: Items can't be added to a List with a model");
+        return;
+    }
+
     m_listMutex->lock();
     m_children.push_back(item);
     item->incRefCount();
@@ -265,6 +331,10 @@ void List::setSelected(ListItem* item)
         m_selected->clearSelected(false);
     }
     m_selected = item;
+    if (m_model != NULL)
+    {
+        m_selectedRow = getItemRow(item);
+    }
     setDirty(DIRTY_CONTENT);
 }
 
@@ -273,6 +343,7 @@ void List::clearSelected(ListItem* item)
     if (m_selected == item)
     {
         m_selected = NULL;
+        m_selectedRow = -1;
         if (item != NULL)
         {
             item->clearSelected(false);
@@ -281,6 +352,225 @@ void List::clearSelected(ListItem* item)
     setDirty(DIRTY_CONTENT);
 }
 
+void List::setModel(ListModel* model)
+{
+    clearItems(false);
+    m_model = model;
+    m_selectedRow = -1;
+    modelChanged();
+}
+
+void List::modelChanged()
+{
+    m_rowOffsets.clear();
+    m_rebindRows = true;
+
+    if (m_model != NULL && m_selectedRow >= (int)m_model->getRowCount())
+    {
+        m_selectedRow = -1;
+    }
+
+    setDirty(DIRTY_SIZE | DIRTY_CONTENT);
+}
+
+int List::getItemRow(ListItem* item)
+{
+    int row = -1;
+    m_listMutex->lock();
+    for (unsigned int i = 0; i < m_children.size(); i++)
+    {
+        if (m_children.at(i) == item)
+        {
+            row = i;
+            if (m_model != NULL)
+            {
+                row += m_firstRow;
+            }
+            break;
+        }
+    }
+    m_listMutex->unlock();
+    return row;
+}
+
+void List::setSelectedRow(int row)
+{
+    if (m_selected != NULL)
+    {
+        m_selected->clearSelected(false);
+        m_selected = NULL;
+    }
+    m_selectedRow = row;
+
+    // Only a visible row has a ListItem, the rest are selected when they're bound
+    if (m_model != NULL && row >= (int)m_firstRow && row < (int)(m_firstRow + m_children.size()))
+    {
+        m_selected = (ListItem*)m_children.at(row - m_firstRow);
+        m_selected->setSelected(false);
+    }
+    setDirty(DIRTY_CONTENT);
+}
+
+int List::getRowOffset(unsigned int row)
+{
+    int rowHeight = m_model->getFixedRowHeight();
+    if (rowHeight > 0)
+    {
+        return row * rowHeight;
+    }
+
+    if (m_rowOffsets.empty())
+    {
+        unsigned int rowCount = m_model->getRowCount();
+        m_rowOffsets.reserve(rowCount + 1);
+
+        int offset = 0;
+        for (unsigned int i = 0; i < rowCount; i++)
+        {
+            m_rowOffsets.push_back(offset);
+            offset += m_model->getRowHeight(i);
+        }
+        m_rowOffsets.push_back(offset);
+    }
+
+    if (row >= m_rowOffsets.size())
+    {
+        row = m_rowOffsets.size() - 1;
+    }
+    return m_rowOffsets.at(row);
+}
+
+unsigned int List::getRowAt(int y)
+{
+    unsigned int rowCount = m_model->getRowCount();
+    if (y < 0 || rowCount == 0)
+    {
+        return 0;
+    }
+
+    unsigned int row;
+    int rowHeight = m_model->getFixedRowHeight();
+    if (rowHeight > 0)
+    {
+        row = y / rowHeight;
+    }
+    else
+    {
+        getRowOffset(0);
+        auto it = upper_bound(m_rowOffsets.begin(), m_rowOffsets.end(), y);
+        row = (it - m_rowOffsets.begin()) - 1;
+    }
+
+    if (row >= rowCount)
+    {
+        row = rowCount - 1;
+    }
+    return row;
+}
+
+ListItem* List::getRecycledItem()
+{
+    if (!m_recyclePool.empty())
+    {
+        ListItem* item = m_recyclePool.back();
+        m_recyclePool.pop_back();
+        return item;
+    }
+
+    ListItem* item = m_model->createItem(this);
+    item->incRefCount();
+    item->setParent(this);
+    item->setList(this);
+    return item;
+}
+
+void List::bindRows(Rect visible)
+{
+    unsigned int rowCount = m_model->getRowCount();
+    unsigned int first = 0;
+    unsigned int last = 0;
+    if (rowCount > 0)
+    {
+        first = getRowAt(visible.y - 2);
+        last = getRowAt(visible.y + visible.height - 2) + 1;
+    }
+
+    if (!m_rebindRows && first == m_firstRow && (last - first) == m_children.size())
+    {
+        return;
+    }
+
+    m_listMutex->lock();
+
+    vector<Widget*> previous = m_children;
+    unsigned int previousFirst = m_firstRow;
+    m_children.clear();
+
+    // Recycle the ListItems of rows that are no longer visible
+    for (unsigned int i = 0; i < previous.size(); i++)
+    {
+        unsigned int row = previousFirst + i;
+        if (m_rebindRows || row < first || row >= last)
+        {
+            ListItem* item = (ListItem*)previous.at(i);
+            if (item == m_selected)
+            {
+                m_selected = NULL;
+            }
+            m_recyclePool.push_back(item);
+            previous.at(i) = NULL;
+        }
+    }
+
+    for (unsigned int row = first; row < last; row++)
+    {
+        ListItem* item = NULL;
+        if (row >= previousFirst && row < previousFirst + previous.size())
+        {
+            // Still visible, no need to bind it again
+            item = (ListItem*)previous.at(row - previousFirst);
+        }
+
+        if (item == NULL)
+        {
+            item = getRecycledItem();
+            m_model->bindItem(item, row);
+
+            if ((int)row == m_selectedRow)
+            {
+                item->setSelected(false);
+                m_selected = item;
+            }
+            else if (item->isSelected())
+            {
+                item->clearSelected(false);
+            }
+
+            item->measure();
+        }
+
+        item->setSize(Size(m_setSize.width, m_model->getRowHeight(row)));
+        item->setPosition(2, 2 + getRowOffset(row));
+        item->layout();
+
+        m_children.push_back(item);
+    }
+
+    m_firstRow = first;
+    m_rebindRows = false;
+
+    m_listMutex->unlock();
+}
+
+void List::clearRecyclePool()
+{
+    for (ListItem* item : m_recyclePool)
+    {
+        item->decRefCount();
+    }
+    m_recyclePool.clear();
+}
+
 ListItem::ListItem(FrontierApp* ui) : Widget(ui, L"ListItem")
 {
     m_selected = false;
@@ -302,7 +592,8 @@ void ListItem::setSelected(bool updateList)
     {
         m_list->setSelected(this);
     }
-    setDirty(DIRTY_CONTENT | DIRTY_STYLE);
+    setDirty(DIRTY_CONTENT);
+    setStateDirty(STYLE_STATE_SELECTED);
 }
 
 void ListItem::clearSelected(bool updateList)
@@ -313,7 +604,8 @@ void ListItem::clearSelected(bool updateList)
     {
         m_list->clearSelected(this);
     }
-    setDirty(DIRTY_CONTENT | DIRTY_STYLE);
+    setDirty(DIRTY_CONTENT);
+    setStateDirty(STYLE_STATE_SELECTED);
 }
 
 Widget* ListItem::handleEvent(Frontier::Event* event)
@@ -64,7 +64,7 @@ void TextListItem::calculateSize()
 
     m_maxSize.set(WIDGET_SIZE_UNLIMITED, WIDGET_SIZE_UNLIMITED);
 
-    m_minSize.width = 1 + font->width(m_text);
+    m_minSize.width = 1 + m_app->getTextCache()->width(font, m_text);
 
     if (m_icon != NULL)
     {
@@ -66,7 +66,7 @@ void TreeListItem::calculateSize()
         int childWidthMax = 0;
         for (Widget* item : m_children)
         {
-            item->calculateSize();
+            item->measure();
 
             Size itemMin = item->getMinSize();
             m_minSize.height += itemMin.height;
@@ -170,12 +170,10 @@ Widget* TreeListItem::handleEvent(Frontier::Event* event)
             int x = mouseEvent->x;
             int y = mouseEvent->y;
 
-            for (Widget* child : m_children)
+            Widget* child = findChildAt(x, y);
+            if (child != NULL)
             {
-                if (child->intersects(x, y))
-                {
-                    return child->handleEvent(event);
-                }
+                return child->handleEvent(event);
             }
 
         }
@@ -220,7 +220,10 @@ void ResizeableFrame::layout()
 
         majorPos += childMajor + padding;
 
-        child->layout();
+        if (child->needsLayout())
+        {
+            child->layout();
+        }
     }
 }
 
@@ -329,15 +332,13 @@ Widget* ResizeableFrame::handleEvent(Event* event)
 
         if (!m_dragging)
         {
-            for (Widget* child : m_children)
+            Widget* child = findChildAt(x, y);
+            if (child != NULL)
             {
-                if (child->intersects(x, y))
-                {
-                    return child->handleEvent(event);
-                }
+                return child->handleEvent(event);
             }
 
-            int padding = (int)getStyle("padding-left").asInt();
+            int padding = (int)getStyle(STYLE_PADDING_LEFT).asInt();
 
             // Is the mouse pointer between children?
             int pos;
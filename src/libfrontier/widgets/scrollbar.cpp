@@ -41,7 +41,7 @@ ScrollBar::~ScrollBar() = default;
 void ScrollBar::calculateSize()
 {
     Size borderSize = getBorderSize();
-    int scrollbarWidth = getStyle("scrollbar-width").asInt();
+    int scrollbarWidth = getStyle(STYLE_SCROLLBAR_WIDTH).asInt();
     m_minSize = borderSize;
     m_minSize.width += scrollbarWidth;
     m_minSize.height += scrollbarWidth;
@@ -64,8 +64,8 @@ bool ScrollBar::draw(Surface* surface)
     int pos = getControlPos(boxModel);
     int sizePix = getControlSize(boxModel);
 
-    int drawSize = getStyle("scrollbar-width").asInt();
-    uint32_t controlColor = getStyle("scrollbar-color").asInt();
+    int drawSize = getStyle(STYLE_SCROLLBAR_WIDTH).asInt();
+    uint32_t controlColor = getStyle(STYLE_SCROLLBAR_COLOR).asInt();
 
     if (m_horizontal)
     {
@@ -21,6 +21,9 @@
 #include <frontier/frontier.h>
 #include <frontier/widgets/scroller.h>
 
+#include <stdlib.h>
+#include <string.h>
+
 using namespace std;
 using namespace Frontier;
 using namespace Geek;
@@ -40,15 +43,16 @@ Scroller::Scroller(FrontierApp* ui, Widget* child) : Widget(ui, L"Scroller")
 
 Scroller::~Scroller()
 {
-    if (m_childSurface != NULL)
+    if (m_backingStore != NULL)
     {
-        delete m_childSurface;
+        delete m_backingStore;
     }
 }
 
 void Scroller::initScroller(Widget* child)
 {
-    m_childSurface = NULL;
+    m_backingStore = NULL;
+    m_backingValid = false;
 
     m_vScrollBar = new ScrollBar(m_app, false);
     m_vScrollBar->incRefCount();
@@ -69,8 +73,8 @@ void Scroller::initScroller(Widget* child)
 
 void Scroller::calculateSize()
 {
-    m_vScrollBar->calculateSize();
-    m_hScrollBar->calculateSize();
+    m_vScrollBar->measure();
+    m_hScrollBar->measure();
 
     m_minSize.width = 50;
     m_minSize.height = 50;
@@ -78,7 +82,7 @@ void Scroller::calculateSize()
 
     if (m_child != NULL)
     {
-        m_child->calculateSize();
+        m_child->measure();
 
         Size childMax = m_child->getMaxSize();
         m_minSize.setMin(childMax);
@@ -104,7 +108,10 @@ void Scroller::layout()
 
     m_child->setPosition(0, 0);
     m_child->setSize(childSize);
-    m_child->layout();
+    if (m_child->needsLayout())
+    {
+        m_child->layout();
+    }
 
     m_vScrollBar->setPosition(m_setSize.width - m_hScrollBar->getMinSize().width, 0);
     m_vScrollBar->setSize(Size(m_vScrollBar->getMinSize().width, m_drawSize.height));
@@ -115,35 +122,83 @@ void Scroller::layout()
     m_hScrollBar->set(0, childSize.width, m_drawSize.width);
 
     m_drawSize.setMin(childSize);
+
+    m_backingValid = false;
 }
 
 void Scroller::checkSurfaceSize(bool highDPI)
 {
-    int w = m_child->getWidth();
-    int h = m_child->getHeight();
+    // The backing store only needs to be big enough for the visible area
+    int w = m_drawSize.width;
+    int h = m_drawSize.height;
     if (highDPI)
     {
         w *= 2;
         h *= 2;
     }
 
-    if (m_childSurface == NULL ||
-        w != (int)m_childSurface->getWidth() ||
-        h != (int)m_childSurface->getHeight())
+    if (m_backingStore == NULL ||
+        w != (int)m_backingStore->getWidth() ||
+        h != (int)m_backingStore->getHeight())
     {
-        if (m_childSurface != NULL)
+        if (m_backingStore != NULL)
         {
-            delete m_childSurface;
+            delete m_backingStore;
         }
         if (highDPI)
         {
-            m_childSurface = new HighDPISurface(m_child->getWidth(), m_child->getHeight(), 4);
+            m_backingStore = new HighDPISurface(m_drawSize.width, m_drawSize.height, 4);
         }
         else
         {
-            m_childSurface = new Surface(m_child->getWidth(), m_child->getHeight(), 4);
+            m_backingStore = new Surface(m_drawSize.width, m_drawSize.height, 4);
+        }
+        m_backingValid = false;
+    }
+}
+
+void Scroller::scrollBackingStore(int dx, int dy)
+{
+    // Move the existing pixels, positive values move the content up and left
+    if (m_backingStore->isHighDPI())
+    {
+        dx *= 2;
+        dy *= 2;
+    }
+
+    int width = m_backingStore->getWidth();
+    int height = m_backingStore->getHeight();
+    int stride = width * 4;
+    uint8_t* data = m_backingStore->getData();
+
+    int rowBytes = (width - abs(dx)) * 4;
+    int srcX = MAX(dx, 0) * 4;
+    int destX = MAX(-dx, 0) * 4;
+    if (dy >= 0)
+    {
+        for (int y = 0; y < height - dy; y++)
+        {
+            memmove(data + (y * stride) + destX, data + ((y + dy) * stride) + srcX, rowBytes);
         }
     }
+    else
+    {
+        for (int y = height - 1; y >= -dy; y--)
+        {
+            memmove(data + (y * stride) + destX, data + ((y + dy) * stride) + srcX, rowBytes);
+        }
+    }
+}
+
+void Scroller::drawChildArea(Rect area)
+{
+    // Clip drawing to the area, and then offset so the child can draw using its own coordinates
+    SurfaceViewPort areaVP(
+        m_backingStore,
+        area.x - m_backingPos.x, area.y - m_backingPos.y,
+        area.width, area.height);
+    SurfaceViewPort childVP(&areaVP, -area.x, -area.y, m_child->getWidth(), m_child->getHeight());
+    m_child->draw(&childVP, area);
 }
 
 bool Scroller::draw(Surface* surface)
@@ -157,7 +212,7 @@ bool Scroller::draw(Surface* surface)
         surface->getHeight() - (m_hScrollBar->getHeight() + 1));
     drawBorder(&mainVP);
 
-    if (m_child != NULL)
+    if (m_child != NULL && m_drawSize.width > 0 && m_drawSize.height > 0)
     {
 #ifdef DEBUG_UI_SCROLLER
         log(DEBUG, "draw: scroller width=%d, height=%d", m_setSize.width, m_setSize.height);
@@ -167,15 +222,71 @@ bool Scroller::draw(Surface* surface)
         checkSurfaceSize(surface->isHighDPI());
         int childY = m_vScrollBar->getPos();
         int childX = m_hScrollBar->getPos();
+        int dx = childX - m_backingPos.x;
+        int dy = childY - m_backingPos.y;
+
+        m_child->setVisibleArea(Rect(childX, childY, m_drawSize.width, m_drawSize.height));
+
+        if (!m_backingValid ||
+            abs(dx) >= m_drawSize.width ||
+            abs(dy) >= m_drawSize.height ||
+            ((dx != 0 || dy != 0) && m_child->isDirty()))
+        {
+            // Nothing can be reused, redraw everything that is visible
+            m_backingStore->clear(0);
+            m_backingPos = Vector2D(childX, childY);
+            m_child->setAreaDirty(Rect(childX, childY, m_drawSize.width, m_drawSize.height));
+            drawChildArea(Rect(childX, childY, m_drawSize.width, m_drawSize.height));
+            m_backingValid = true;
+        }
+        else if (dx != 0 || dy != 0)
+        {
+            // Reuse what we have already drawn, and only draw the newly exposed strips
+            scrollBackingStore(dx, dy);
+            m_backingPos = Vector2D(childX, childY);
+
+            // Only the Widgets in the newly exposed strips need to be redrawn
+            vector<Rect> strips;
+            if (dy > 0)
+            {
+                strips.push_back(Rect(childX, childY + m_drawSize.height - dy, m_drawSize.width, dy));
+            }
+            else if (dy < 0)
+            {
+                strips.push_back(Rect(childX, childY, m_drawSize.width, -dy));
+            }
 
-        m_childSurface->clear(0);
-        m_child->draw(m_childSurface, Rect(childX, childY, m_child->getWidth(), m_drawSize.height));
+            if (dx > 0)
+            {
+                strips.push_back(Rect(childX + m_drawSize.width - dx, childY, dx, m_drawSize.height));
+            }
+            else if (dx < 0)
+            {
+                strips.push_back(Rect(childX, childY, -dx, m_drawSize.height));
+            }
+
+            for (Rect strip : strips)
+            {
+                // The strip still has the pixels that were scrolled out of it
+                SurfaceViewPort stripVP(
+                    m_backingStore,
+                    strip.x - m_backingPos.x, strip.y - m_backingPos.y,
+                    strip.width, strip.height);
+                stripVP.clear(0);
+
+                m_child->setAreaDirty(strip);
+                drawChildArea(strip);
+            }
+        }
+        else if (m_child->isDirty())
+        {
+            // Only the dirty parts of the child will be redrawn
+            drawChildArea(Rect(childX, childY, m_drawSize.width, m_drawSize.height));
+        }
 
         Size scaledDrawSize = m_drawSize;
         if (surface->isHighDPI())
         {
-            childX *= 2;
-            childY *= 2;
             scaledDrawSize.width *= 2;
             scaledDrawSize.height *= 2;
         }
@@ -183,8 +294,8 @@ bool Scroller::draw(Surface* surface)
         BoxModel boxModel = getBoxModel();
         surface->blit(
             boxModel.getLeft(), boxModel.getTop(),
-            m_childSurface,
-            childX, childY,
+            m_backingStore,
+            0, 0,
             scaledDrawSize.width, scaledDrawSize.height);
     }
 
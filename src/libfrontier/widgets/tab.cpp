@@ -20,6 +20,7 @@
 
 
 #include <frontier/frontier.h>
+#include <frontier/displaylist.h>
 #include <frontier/widgets/tabs.h>
 
 using namespace std;
@@ -69,7 +70,7 @@ Tab::~Tab()
 void Tab::calculateSize()
 {
     BoxModel boxModel = getBoxModel();
-    int maxTabSize = getStyle("max-width").asInt();
+    int maxTabSize = getStyle(STYLE_MAX_WIDTH).asInt();
 
     m_minSize.width = boxModel.getWidth();
     m_minSize.height = boxModel.getHeight();
@@ -194,17 +195,22 @@ bool Tab::draw(Geek::Gfx::Surface* surface)
         textOffsetX = ((m_setSize.width / 2) - (labelHeight / 2));
     }
 
-    int colour = getStyle("text-color").asInt();
-    font->write(
-        surface,
-        textOffsetX,
-        textOffsetY,
-        getProperty(FRONTIER_PROP_TITLE).asString().c_str(),
-        colour,
-        true,
-        NULL,
-        titleWidth,
-        rotate);
+    int colour = getStyle(STYLE_TEXT_COLOR).asInt();
+    wstring title = getProperty(FRONTIER_PROP_TITLE).asString();
+    RecordingSurface::markIncomplete(surface);
+    {
+        lock_guard<mutex> lock(m_app->getTextCache()->getFontMutex());
+        font->write(
+            surface,
+            textOffsetX,
+            textOffsetY,
+            title.c_str(),
+            colour,
+            true,
+            NULL,
+            titleWidth,
+            rotate);
+    }
 
     if (m_closeable)
     {
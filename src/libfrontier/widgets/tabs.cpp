@@ -147,17 +147,17 @@ void Tabs::calculateSize()
 {
     if (m_addButton)
     {
-        m_addButtonWidget->calculateSize();
+        m_addButtonWidget->measure();
     }
     if (m_collapsible)
     {
-        m_collapseButtonWidget->calculateSize();
+        m_collapseButtonWidget->measure();
     }
 
     m_tabsSize.set(0, 0);
     for (Tab* tab : m_tabs)
     {
-        tab->calculateSize();
+        tab->measure();
         Size tabMin = tab->getMinSize();
 
         if (isHorizontal())
@@ -223,7 +223,7 @@ void Tabs::calculateSize()
 
     if (activeWidget != NULL)
     {
-        activeWidget->calculateSize();
+        activeWidget->measure();
 
         activeMinSize = activeWidget->getMinSize();
         activeMaxSize = activeWidget->getMaxSize();
@@ -241,11 +241,11 @@ void Tabs::calculateSize()
     m_minSize += activeMinSize;
     m_maxSize += activeMaxSize;
 
-    if (getStyle("expand-horizontal").asBool())
+    if (getStyle(STYLE_EXPAND_HORIZONTAL).asBool())
     {
         m_maxSize.width = WIDGET_SIZE_UNLIMITED;
     }
-    if (getStyle("expand-vertical").asBool())
+    if (getStyle(STYLE_EXPAND_VERTICAL).asBool())
     {
         m_maxSize.height = WIDGET_SIZE_UNLIMITED;
     }
@@ -338,7 +338,10 @@ void Tabs::layout()
 
             activeWidget->setSize(Size(contentRect.width, contentRect.height));
             activeWidget->setPosition(contentRect.x, contentRect.y);
-            activeWidget->layout();
+            if (activeWidget->needsLayout())
+            {
+                activeWidget->layout();
+            }
         }
     }
 }
@@ -346,14 +349,13 @@ void Tabs::layout()
 void Tabs::clearDirty()
 {
     m_dirty = 0;
+    m_damaged = false;
     for (Tab* tab : m_tabs)
     {
-        tab->clearDirty();
-    }
-
-    if (m_activeTab != NULL)
-    {
-        m_activeTab->clearDirty();
+        if (tab->isDirty())
+        {
+            tab->clearDirty();
+        }
     }
 }
 
@@ -405,7 +407,7 @@ bool Tabs::draw(Surface* surface)
     if (!m_tabs.empty() && (!m_collapsible || !m_collapsed))
     {
         Widget* activeWidget = m_activeTab->getContent();
-        if (activeWidget != NULL && (dirtySize || activeWidget->isDirty() || activeWidget->hasChildren()))
+        if (activeWidget != NULL && (dirtySize || activeWidget->isDirty()))
         {
             SurfaceViewPort viewport(
                 surface,
@@ -413,7 +415,7 @@ bool Tabs::draw(Surface* surface)
                 activeWidget->getY(),
                 activeWidget->getWidth(),
                 activeWidget->getHeight());
-            return activeWidget->draw(&viewport, Rect(0, 0, activeWidget->getWidth(), activeWidget->getHeight()));
+            return activeWidget->drawCached(&viewport, Rect(0, 0, activeWidget->getWidth(), activeWidget->getHeight()));
         }
     }
 
@@ -851,7 +853,7 @@ Size Tabs::getTabSize()
 
     int tabMajor = major / m_tabs.size();
 
-    int maxTabSize = m_tabs.at(0)->getStyle("max-width").asInt();
+    int maxTabSize = m_tabs.at(0)->getStyle(STYLE_MAX_WIDTH).asInt();
     if (tabMajor > maxTabSize)
     {
         tabMajor = maxTabSize;
@@ -26,6 +26,7 @@
 #include <sys/time.h> 
 #include <sys/types.h> 
 #include <sys/wait.h> 
+#include <string.h>
 #include <wchar.h>
 #include <wctype.h>
 
@@ -52,6 +53,10 @@ static void hexdump(const char* pos, int len);
 Terminal::Terminal(FrontierApp* ui) : Widget(ui, L"Terminal")
 {
     m_process = NULL;
+    m_bufferMutex = Thread::createMutex();
+    m_redrawPending = false;
+
+    m_lines.resize(TERMINAL_DEFAULT_SCROLLBACK);
 
     reset();
     clear();
@@ -80,7 +85,66 @@ void Terminal::clear()
     m_offsetRow = 0;
     m_state = STATE_NORMAL;
 
-    m_buffer.clear();
+    // Keep the lines' storage so that it can be reused
+    m_firstRow = 0;
+    m_rowCount = 0;
+    m_fullRedraw = true;
+    m_drawnOffsetRow = 0;
+    m_drawnCursorRow = 0;
+}
+
+void Terminal::setScrollback(unsigned int lines)
+{
+    if (lines < 1)
+    {
+        lines = 1;
+    }
+
+    m_bufferMutex->lock();
+    m_lines.clear();
+    m_lines.resize(lines);
+    m_cells.clear();
+    clear();
+    m_bufferMutex->unlock();
+
+    setDirty(DIRTY_CONTENT);
+}
+
+TermLine* Terminal::addLine(unsigned int row)
+{
+    if (row < m_firstRow)
+    {
+        // Already scrolled out of the buffer
+        return NULL;
+    }
+
+    while (row >= m_firstRow + m_rowCount)
+    {
+        if (m_rowCount < m_lines.size())
+        {
+            m_rowCount++;
+            if (m_cells.size() < m_rowCount * TERMINAL_MAX_COLUMNS)
+            {
+                m_cells.resize(m_rowCount * TERMINAL_MAX_COLUMNS);
+            }
+        }
+        else
+        {
+            // The buffer is full, reuse the oldest line
+            m_firstRow++;
+        }
+
+        TermLine& line = getLine(m_firstRow + m_rowCount - 1);
+        line.length = 0;
+        line.dirty = true;
+    }
+
+    if (m_offsetRow < m_firstRow)
+    {
+        m_offsetRow = m_firstRow;
+    }
+
+    return &(getLine(row));
 }
 
 void Terminal::calculateSize()
@@ -88,8 +152,7 @@ void Terminal::calculateSize()
     FontHandle* font = m_app->getTheme()->getMonospaceFont(true);
     int fontHeight = m_app->getTheme()->getMonospaceHeight();
 
-    FontManager* fm = m_app->getFontManager();
-    int fontWidth = fm->width(font, L"M");
+    int fontWidth = m_app->getTextCache()->width(font, L'M');
 
     m_minSize.width = fontWidth * 20;
     m_minSize.height = fontHeight * 4;
@@ -100,21 +163,29 @@ void Terminal::calculateSize()
 
 bool Terminal::draw(Surface* surface)
 {
-    surface->clear(m_bgColour);
+    // If we're being drawn without having changed, our parent needs everything
+    bool fullRedraw = isDirty(DIRTY_SIZE) || !isDirty();
 
-    if (m_buffer.empty())
+    m_bufferMutex->lock();
+    m_redrawPending = false;
+
+    if (m_rowCount == 0)
     {
+        surface->clear(m_bgColour);
+        m_fullRedraw = false;
+        m_bufferMutex->unlock();
         return true;
     }
 
-    FontManager* fm = m_app->getFontManager();
+    TextCache* textCache = m_app->getTextCache();
 
     FontHandle* font = m_app->getTheme()->getMonospaceFont(true);
     int fontHeight = m_app->getTheme()->getMonospaceHeight();
-    int fontWidth = fm->width(font, L"M");
+    int fontWidth = textCache->width(font, L'M');
     if (fontWidth == 0)
     {
         log(ERROR, "fontWidth is NULL?");
+        m_bufferMutex->unlock();
         return false;
     }
 
@@ -130,12 +201,49 @@ bool Terminal::draw(Surface* surface)
     {
         m_offsetRow = m_row;
     }
+    if (m_offsetRow < m_firstRow)
+    {
+        m_offsetRow = m_firstRow;
+    }
+
+    if (m_fullRedraw || m_offsetRow != m_drawnOffsetRow)
+    {
+        fullRedraw = true;
+    }
+
+    if (fullRedraw)
+    {
+        surface->clear(m_bgColour);
+    }
+    else
+    {
+        // The cursor has to be removed from where it was and drawn where it is
+        if (hasLine(m_drawnCursorRow))
+        {
+            getLine(m_drawnCursorRow).dirty = true;
+        }
+        if (hasLine(m_row))
+        {
+            getLine(m_row).dirty = true;
+        }
+    }
 
     int y = 0;
     unsigned int row;
-    for (row = 0; row < visibleRows && (row + m_offsetRow) < m_buffer.size(); row++, y += fontHeight)
+    for (row = 0; row < visibleRows && (row + m_offsetRow) < m_firstRow + m_rowCount; row++, y += fontHeight)
     {
-        TermLine& line = m_buffer.at(row + m_offsetRow);
+        TermLine& line = getLine(row + m_offsetRow);
+        const TermChar* cells = getCells(row + m_offsetRow);
+        if (!fullRedraw)
+        {
+            if (!line.dirty)
+            {
+                continue;
+            }
+            surface->drawRectFilled(0, y, m_setSize.width, fontHeight, m_bgColour);
+        }
+        line.dirty = false;
+
         unsigned int col;
         int x = 0;
         for (col = 0; col < visibleColumns; col++, x += fontWidth)
@@ -143,9 +251,9 @@ bool Terminal::draw(Surface* surface)
             uint32_t fg = m_fgColour;
             uint32_t bg = m_bgColour;
             TermChar c;
-            if (col < line.chars.size())
+            if (col < line.length)
             {
-                c = line.chars.at(col);
+                c = cells[col];
                 fg = c.fg;
                 bg = c.bg;
             }
@@ -180,13 +288,18 @@ bool Terminal::draw(Surface* surface)
                 }
             }
 
-            if (col < line.chars.size())
+            if (col < line.length)
             {
-                fm->write(font, surface, x, y, wstring(1, c.c), fg, true, NULL);
+                textCache->write(surface, font, x, y, c.c, fg);
             }
         }
     }
 
+    m_fullRedraw = false;
+    m_drawnOffsetRow = m_offsetRow;
+    m_drawnCursorRow = m_row;
+    m_bufferMutex->unlock();
+
     return true;
 }
 
@@ -220,44 +333,67 @@ Widget* Terminal::handleEvent(Event* event)
 
 void Terminal::setChar(unsigned int row, unsigned int col, wchar_t c)
 {
-    if (m_buffer.size() <= row)
+    TermLine* line = addLine(row);
+    if (line == NULL || col >= TERMINAL_MAX_COLUMNS)
     {
-        m_buffer.resize(row + 1);
+        return;
     }
+    line->dirty = true;
 
-    TermChar termChar;
+    TermChar* cells = getCells(row);
+    while (line->length < col)
+    {
+        TermChar& padchar = cells[line->length++];
+        padchar.c = L' ';
+        padchar.fg = m_fgColour;
+        padchar.bg = m_bgColour;
+    }
+
+    TermChar& termChar = cells[col];
     termChar.c = c;
     termChar.fg = m_fgColour;
     termChar.bg = m_bgColour;
-
-    TermLine& line = m_buffer.at(row);
-    if (col >= line.chars.size())
+    if (col >= line->length)
     {
-        int pad = col - line.chars.size();
-        int i;
-        for (i = 0; i < pad; i++)
-        {
-            TermChar padchar;
-            padchar.c = L' ';
-            padchar.fg = m_fgColour;
-            padchar.bg = m_bgColour;
-            line.chars.push_back(padchar);
-        }
+        line->length = col + 1;
+    }
+}
 
-        line.chars.push_back(termChar);
+void Terminal::eraseChars(unsigned int row, unsigned int col, unsigned int count)
+{
+    if (!hasLine(row))
+    {
+        return;
     }
-    else
+
+    TermLine& line = getLine(row);
+    if (col >= line.length)
     {
-        line.chars[col] = termChar;
+        return;
     }
+
+    // Move the rest of the line left
+    count = MIN(count, line.length - col);
+    TermChar* cells = getCells(row);
+    memmove(cells + col, cells + col + count, (line.length - (col + count)) * sizeof(TermChar));
+    line.length -= count;
+    line.dirty = true;
 }
 
 void Terminal::receiveChar(wchar_t c)
 {
-    if (m_buffer.empty())
+    m_bufferMutex->lock();
+    processChar(c);
+    m_bufferMutex->unlock();
+
+    requestRedraw();
+}
+
+void Terminal::processChar(wchar_t c)
+{
+    if (m_rowCount == 0)
     {
-        TermLine line;
-        m_buffer.push_back(line);
+        addLine(m_row);
     }
 
     switch (m_state)
@@ -278,6 +414,7 @@ void Terminal::receiveChar(wchar_t c)
             {
                 // Line Feed
                 m_row++;
+                addLine(m_row);
             }
             else if (c == 0xd)
             {
@@ -341,9 +478,28 @@ void Terminal::receiveChar(wchar_t c)
             }
             break;
     }
+}
+
+void Terminal::requestRedraw()
+{
+    // Only the first change since the last draw needs to ask for an update
+    m_bufferMutex->lock();
+    bool pending = m_redrawPending;
+    m_redrawPending = true;
+    m_bufferMutex->unlock();
+
+    if (pending)
+    {
+        return;
+    }
 
     setDirty(DIRTY_CONTENT);
 
+    FrontierWindow* window = getWindow();
+    if (window != NULL)
+    {
+        window->requestUpdate();
+    }
 }
 
 void Terminal::handleCSI(wchar_t c)
@@ -393,7 +549,14 @@ void Terminal::handleCSI(wchar_t c)
             {
                 param1 = 1;
             }
-            m_row -= param1;
+            if (m_row - m_firstRow >= (unsigned long)param1)
+            {
+                m_row -= param1;
+            }
+            else
+            {
+                m_row = m_firstRow;
+            }
             break;
 
         case 'B':
@@ -429,7 +592,7 @@ void Terminal::handleCSI(wchar_t c)
             }
             printf("Terminal::receiveChar: : STATE_CSI: Cursor Position: row=%ld, col=%ld\n", param1, param2);
 
-            m_row = param1 - 1;
+            m_row = m_firstRow + param1 - 1;
             m_col = param2 - 1;
         } break;
 
@@ -468,14 +631,7 @@ void Terminal::handleCSI(wchar_t c)
             {
                 case 0:
                     printf("Terminal::receiveChar: STATE_CSI: Erase to Right\n");
-                    if (m_row < m_buffer.size())
-                    {
-                        TermLine& line = m_buffer.at(m_row);
-                        if (m_col < line.chars.size())
-                        {
-                            line.chars.erase(line.chars.begin() + m_col);
-                        }
-                    }
+                    eraseChars(m_row, m_col, 1);
                     break;
 
                 default:
@@ -493,19 +649,7 @@ void Terminal::handleCSI(wchar_t c)
 
             int count = param1;
             printf("Terminal::receiveChar: : STATE_CSI: Delete Characters: count=%d\n", count);
-            if (m_row < m_buffer.size())
-            {
-                TermLine& line = m_buffer.at(m_row);
-                if (m_col < line.chars.size())
-                {
-                    //line.erase(m_col, count);
-                    int i;
-                    for (i = 0; i < count; i++)
-                    {
-                        line.chars.erase(line.chars.begin() + m_col);
-                    }
-                }
-            }
+            eraseChars(m_row, m_col, count);
         } break;
 
         case 'd':
@@ -514,7 +658,7 @@ void Terminal::handleCSI(wchar_t c)
                 param1 = 1;
             }
 
-            m_row = param1 - 1;
+            m_row = m_firstRow + param1 - 1;
             break;
 
         case 'm':
@@ -551,12 +695,17 @@ void Terminal::receiveChars(char* c, int length)
 #ifdef DEBUG_TERMINAL
     hexdump(c, length);
 #endif
+    m_bufferMutex->lock();
     int i;
     for (i = 0; i < length; i++)
     {
         // TODO: Handle UTF-8
-        receiveChar(c[i]);
+        processChar(c[i]);
     }
+    m_bufferMutex->unlock();
+
+    // Only request a single update for the whole chunk
+    requestRedraw();
 
     /*
     FrontierWindow* window = getWindow();
@@ -673,8 +822,15 @@ bool TerminalProcess::main()
             log(DEBUG, "main: (Parent) Read %d bytes", res);
 #endif
 
-            buffer[res] = 0;
-            m_terminal->receiveChars(buffer, res);
+            // The Terminal belongs to the UI thread, so hand the data over
+            string data(buffer, res);
+            Terminal* terminal = m_terminal;
+            terminal->incRefCount();
+            terminal->getApp()->post([terminal, data]() mutable
+            {
+                terminal->receiveChars(&data[0], data.length());
+                terminal->decRefCount();
+            });
         }
         log(DEBUG, "main: (Parent) Child exited");
     }
@@ -150,9 +150,9 @@ bool TextInput::draw(Surface* surface)
         }
     }
 
-    if (hasStyle("background-color"))
+    if (hasStyle(STYLE_BACKGROUND_COLOR))
     {
-        uint32_t backgroundColour = getStyle("background-color").asInt();
+        uint32_t backgroundColour = getStyle(STYLE_BACKGROUND_COLOR).asInt();
         m_textSurface->clear(backgroundColour);
     }
 
@@ -166,7 +166,7 @@ bool TextInput::draw(Surface* surface)
     for (pos = 0; pos < m_text.length(); pos++)
     {
         wstring cstr = wchar2wstring(m_text.at(pos));
-        unsigned int width = font->width(cstr);
+        unsigned int width = m_app->getTextCache()->width(font, m_text.at(pos));
 
         if (hasSelection())
         {
@@ -489,7 +489,7 @@ int TextInput::getTextWidth(FontHandle* font, wstring text)
     int textWidth = 0;
     for (pos = 0; pos < m_text.length(); pos++)
     {
-        int cw = font->width(wchar2wstring(text.at(pos)));
+        int cw = m_app->getTextCache()->width(font, text.at(pos));
         textWidth += cw;
     }
     return textWidth;
@@ -22,6 +22,8 @@
 #include <frontier/frontier.h>
 #include <frontier/widgets.h>
 #include <frontier/contextmenu.h>
+#include <frontier/displaylist.h>
+#include <frontier/hitindex.h>
 
 #include <typeinfo>
 
@@ -30,6 +32,15 @@ using namespace Frontier;
 using namespace Geek;
 using namespace Geek::Gfx;
 
+// Containers with fewer children than this are just searched in order
+#define WIDGET_HIT_INDEX_MIN_CHILDREN 16
+
+// Below this many pixels, children are quicker to draw than to hand to the workers
+#define WIDGET_PARALLEL_DRAW_MIN_AREA (256 * 256)
+
+// Set while drawing children that have been checked by prepareParallelDraw()
+static thread_local bool g_parallelDraw = false;
+
 Widget::Widget(FrontierApp* ui, wstring widgetName) : Logger(L"Widget[" + widgetName + L"]")
 {
     initWidget(ui, widgetName);
@@ -43,6 +54,24 @@ Widget::~Widget()
         child->setParent(NULL);
     }
     m_children.clear();
+
+    delete m_hitIndex;
+    delete m_displayList;
+
+    if (m_computedStyle != NULL)
+    {
+        m_computedStyle->release();
+    }
+
+    if (m_hasRenderCache)
+    {
+        m_app->getRenderCache()->remove(this);
+    }
+
+    if (m_dirtyListWindow != NULL)
+    {
+        m_dirtyListWindow->removeDirtyWidget(this);
+    }
 }
 
 void Widget::initWidget(FrontierApp* app, wstring widgetName)
@@ -56,17 +85,32 @@ void Widget::initWidget(FrontierApp* app, wstring widgetName)
     m_privateData = NULL;
     m_contextMenu = NULL;
 
+    m_absolutePositionGeneration = 0;
+    m_hitIndex = NULL;
+    m_hitIndexGeneration = 0;
+    m_lastHitChild = 0;
+
     m_dirty = DIRTY_SIZE | DIRTY_CONTENT;
+    m_damaged = true;
+    m_dirtyListWindow = NULL;
+    m_layoutBoundary = false;
+    m_measureValid = false;
 
     m_minSize = Size(0, 0);
     m_maxSize = Size(0, 0);
     m_setSize = Size(0, 0);
 
     m_styleTimestamp = 0;
+    m_computedStyle = NULL;
     m_cachedBoxModelTimestamp = 0;
     m_cachedTextFont = NULL;
     m_cachedTextFontTimestamp = 0;
 
+    m_renderCacheEnabled = false;
+    m_hasRenderCache = false;
+    m_renderCacheValid = false;
+    m_displayList = NULL;
+
     //m_mouseOver = false;
     m_selected = false;
 
@@ -116,6 +160,18 @@ void Widget::calculateSize()
 {
 }
 
+void Widget::measure()
+{
+    if (m_measureValid)
+    {
+        return;
+    }
+
+    ProfileScope scope(m_app->getProfiler(), PROFILE_MEASURE, m_widgetName);
+    calculateSize();
+    m_measureValid = true;
+}
+
 void Widget::layout()
 {
 }
@@ -125,9 +181,10 @@ void Widget::setPosition(int x, int y)
     if (m_position.x != x || m_position.y != y)
     {
         // We will need to redraw the new position!
-        setDirty(DIRTY_CONTENT | DIRTY_SIZE, true);
+        setDirty(DIRTY_CONTENT | DIRTY_SIZE, true, false);
         m_position.x = x;
         m_position.y = y;
+        m_app->layoutChanged();
     }
 }
 
@@ -139,8 +196,9 @@ Size Widget::setSize(Size size)
 
     if (size != m_setSize)
     {
-        setDirty(DIRTY_SIZE);
+        setDirty(DIRTY_SIZE, false, false);
         m_setSize = size;
+        m_app->layoutChanged();
     }
 
     return size;
@@ -156,6 +214,205 @@ bool Widget::draw(Geek::Gfx::Surface* surface)
     return true;
 }
 
+bool Widget::drawCached(Surface* surface, Rect visible)
+{
+    ProfileScope scope(m_app->getProfiler(), PROFILE_DRAW, m_widgetName);
+
+    if (!isRenderCacheEnabled())
+    {
+        return draw(surface, visible);
+    }
+
+    RenderCache* renderCache = m_app->getRenderCache();
+    bool created;
+    Surface* cacheSurface = renderCache->get(this, getWidth(), getHeight(), surface->isHighDPI(), created);
+    if (cacheSurface == NULL)
+    {
+        // Too big to be cached
+        return draw(surface, visible);
+    }
+    m_hasRenderCache = true;
+
+    if (created || !m_renderCacheValid || isDirty())
+    {
+        // Cached children mustn't evict our Surface while we're drawing in to it
+        renderCache->pin(this);
+
+        if (created)
+        {
+            // Nothing has been drawn to this Surface, make sure the whole tree draws itself
+            setDirty(DIRTY_SIZE | DIRTY_CONTENT, true, false);
+        }
+        if (isDirty(DIRTY_SIZE))
+        {
+            cacheSurface->clear(0);
+        }
+
+        // Always draw everything, so the whole Surface is valid when scrolled in to view
+        bool res;
+        if (m_app->isDisplayListsEnabled())
+        {
+            res = drawRecorded(cacheSurface, created);
+        }
+        else
+        {
+            res = draw(cacheSurface, Rect(0, 0, getWidth(), getHeight()));
+        }
+        renderCache->unpin(this);
+        if (!res)
+        {
+            return false;
+        }
+        m_renderCacheValid = true;
+    }
+
+    surface->blit(0, 0, cacheSurface, true);
+    return true;
+}
+
+bool Widget::drawRecorded(Surface* surface, bool created)
+{
+    if (m_displayList != NULL && !m_displayList->isComplete() && !created && !isDirty(DIRTY_SIZE) && !isDirty(DIRTY_STYLE))
+    {
+        // Recording would mean drawing twice, and draw() may have side effects. Try
+        // recording again when everything has to be redrawn anyway
+        return draw(surface, Rect(0, 0, getWidth(), getHeight()));
+    }
+
+    DisplayList list;
+    RecordingSurface recorder(&list, surface->getWidth(), surface->getHeight(), surface->isHighDPI());
+    bool res = draw(&recorder, Rect(0, 0, getWidth(), getHeight()));
+    if (!res)
+    {
+        return false;
+    }
+
+    // The Surface still has the last list's pixels, unless it's new or has been cleared
+    bool same =
+        !created &&
+        !isDirty(DIRTY_SIZE) &&
+        !isDirty(DIRTY_STYLE) &&
+        m_displayList != NULL &&
+        list.isSame(*m_displayList);
+    if (!same)
+    {
+        if (list.isComplete())
+        {
+            list.replay(surface);
+        }
+        else
+        {
+            res = draw(surface, Rect(0, 0, getWidth(), getHeight()));
+        }
+    }
+
+    if (m_displayList == NULL)
+    {
+        m_displayList = new DisplayList();
+    }
+    swap(*m_displayList, list);
+    return res;
+}
+
+bool Widget::record(DisplayList* list, bool highDPI)
+{
+    RecordingSurface recorder(list, getWidth(), getHeight(), highDPI);
+    return draw(&recorder, Rect(0, 0, getWidth(), getHeight()));
+}
+
+static void drawChild(Surface* surface, Widget* child, Frontier::Rect visible)
+{
+    SurfaceViewPort viewport(surface, child->getX(), child->getY(), child->getWidth(), child->getHeight());
+    Frontier::Rect childVisible(visible.x - child->getX(), visible.y - child->getY(), visible.width, visible.height);
+    childVisible = childVisible.intersect(Frontier::Rect(0, 0, child->getWidth(), child->getHeight()));
+    child->drawCached(&viewport, childVisible);
+}
+
+void Widget::drawChildren(Surface* surface, const vector<Widget*>& children, Frontier::Rect visible)
+{
+    vector<Widget*> concurrent;
+    vector<Widget*> serial;
+    int area = 0;
+    // Recording isn't thread safe
+    if (m_app->isParallelDraw() && children.size() > 1 && RecordingSurface::getRecorder(surface) == NULL)
+    {
+        for (Widget* child : children)
+        {
+            if (g_parallelDraw || child->prepareParallelDraw())
+            {
+                concurrent.push_back(child);
+                area += child->getWidth() * child->getHeight();
+            }
+            else
+            {
+                serial.push_back(child);
+            }
+        }
+    }
+
+    if (concurrent.size() < 2 || area < WIDGET_PARALLEL_DRAW_MIN_AREA)
+    {
+        for (Widget* child : children)
+        {
+            drawChild(surface, child, visible);
+        }
+        return;
+    }
+
+    // Siblings don't overlap, so the order they're drawn in doesn't matter
+    for (Widget* child : serial)
+    {
+        drawChild(surface, child, visible);
+    }
+
+    bool wasParallel = g_parallelDraw;
+    g_parallelDraw = true;
+    m_app->getWorkerPool()->parallelFor(concurrent.size(), [surface, &concurrent, visible](unsigned int i)
+    {
+        bool workerWasParallel = g_parallelDraw;
+        g_parallelDraw = true;
+        drawChild(surface, concurrent.at(i), visible);
+        g_parallelDraw = workerWasParallel;
+    });
+    g_parallelDraw = wasParallel;
+}
+
+bool Widget::prepareParallelDraw()
+{
+    // Fill the caches that draw() would otherwise fill. Styles are
+    // recomputed each time they're used while they're dirty, so those
+    // Widgets have to stay on the UI thread
+    getBoxModel(getComputedStyle());
+    bool safe = isParallelDrawSafe() && !(m_dirty & DIRTY_STYLE) && !isRenderCacheEnabled();
+
+    for (Widget* child : getChildren())
+    {
+        safe = child->prepareParallelDraw() && safe;
+    }
+    return safe;
+}
+
+void Widget::setRenderCacheEnabled(bool enabled)
+{
+    m_renderCacheEnabled = enabled;
+    if (!enabled && m_hasRenderCache)
+    {
+        m_app->getRenderCache()->remove(this);
+        m_hasRenderCache = false;
+    }
+    setDirty(DIRTY_CONTENT);
+}
+
+bool Widget::isRenderCacheEnabled()
+{
+    if (m_renderCacheEnabled)
+    {
+        return true;
+    }
+    const ComputedStyle* style = getComputedStyle();
+    return style->has(STYLE_RENDER_CACHE) && style->get(STYLE_RENDER_CACHE).asBool();
+}
+
 void Widget::setProperty(std::wstring property, Value value)
 {
     m_properties.insert_or_assign(property, value);
@@ -191,13 +448,13 @@ Size Widget::getBorderSize()
 
 bool Widget::drawBorder(Surface* surface)
 {
-    auto props = getStyleProperties();
-    BoxModel boxModel = getBoxModel(props);
+    const ComputedStyle* style = getComputedStyle();
+    BoxModel boxModel = getBoxModel(style);
 
     int borderRadius = 0;
-    if (hasStyle("border-radius", props))
+    if (style->has(STYLE_BORDER_RADIUS))
     {
-        borderRadius = getStyle("border-radius", props).asInt();
+        borderRadius = style->get(STYLE_BORDER_RADIUS).asInt();
     }
 
     int surfaceWidth = surface->getWidth();
@@ -213,13 +470,13 @@ bool Widget::drawBorder(Surface* surface)
     int borderWidth = surfaceWidth - (boxModel.marginLeft + boxModel.marginRight);
     int borderHeight = surfaceHeight - (boxModel.marginTop + boxModel.marginBottom);
 
-    uint64_t backgroundColour = getStyle("background-color", props).asInt();
+    uint64_t backgroundColour = style->get(STYLE_BACKGROUND_COLOR).asInt();
     if (backgroundColour != FRONTIER_COLOUR_TRANSPARENT)
     {
-        if (hasStyle("background-image", props))
+        if (style->has(STYLE_BACKGROUND_IMAGE))
         {
             // We only support basic linear gradients for now
-            backgroundColour = getStyle("background-image", props).asInt();
+            backgroundColour = style->get(STYLE_BACKGROUND_IMAGE).asInt();
             uint32_t g1 = backgroundColour >> 32;
             uint32_t g2 = backgroundColour & 0xffffffff;
 
@@ -232,7 +489,7 @@ bool Widget::drawBorder(Surface* surface)
                 surface->drawGrad(borderX, borderY, borderWidth, borderHeight, g1, g2);
             }
         }
-        else if (hasStyle("background-color", props))
+        else if (style->has(STYLE_BACKGROUND_COLOR))
         {
             if (borderRadius > 0)
             {
@@ -248,28 +505,28 @@ bool Widget::drawBorder(Surface* surface)
     // Top
     if (boxModel.borderTopWidth > 0)
     {
-        uint32_t borderColour = getStyle("border-top-color", props).asInt();
+        uint32_t borderColour = style->get(STYLE_BORDER_TOP_COLOR).asInt();
         surface->drawLine(borderX, borderY, borderX + borderWidth - (borderRadius), borderY, 0xff000000 | borderColour);
     }
 
     // Right
     if (boxModel.borderRightWidth > 0)
     {
-        uint32_t borderColour = getStyle("border-right-color", props).asInt();
+        uint32_t borderColour = style->get(STYLE_BORDER_RIGHT_COLOR).asInt();
         surface->drawLine(borderX + borderWidth, borderY + borderRadius, borderX + borderWidth, borderY + borderHeight - (borderRadius), 0xff000000 | borderColour);
     }
 
     // Bottom
     if (boxModel.borderBottomWidth > 0)
     {
-        uint32_t borderColour = getStyle("border-bottom-color", props).asInt();
+        uint32_t borderColour = style->get(STYLE_BORDER_BOTTOM_COLOR).asInt();
         surface->drawLine(borderX + borderRadius, borderY + borderHeight , borderX + borderWidth - (borderRadius),  borderY + borderHeight , 0xff000000 | borderColour);
     }
 
     // Left
     if (boxModel.borderLeftWidth > 0)
     {
-        uint32_t borderColour = getStyle("border-left-color", props).asInt();
+        uint32_t borderColour = style->get(STYLE_BORDER_LEFT_COLOR).asInt();
         surface->drawLine(borderX, borderY + borderRadius, borderX, borderY + borderHeight - (borderRadius), 0xff000000 | borderColour);
     }
 
@@ -277,24 +534,24 @@ bool Widget::drawBorder(Surface* surface)
     {
         if (boxModel.borderTopWidth > 0 && boxModel.borderRightWidth > 0)
         {
-            uint32_t borderColour = 0xff000000 | getStyle("border-top-color", props).asInt();
+            uint32_t borderColour = 0xff000000 | style->get(STYLE_BORDER_TOP_COLOR).asInt();
             surface->drawCorner(borderX + borderWidth - borderRadius, borderY + borderRadius, TOP_RIGHT, borderRadius, borderColour);
         }
         if (boxModel.borderBottomWidth > 0 && boxModel.borderRightWidth > 0)
         {
-            uint32_t borderColour = 0xff000000 | getStyle("border-bottom-color", props).asInt();
+            uint32_t borderColour = 0xff000000 | style->get(STYLE_BORDER_BOTTOM_COLOR).asInt();
             surface->drawCorner(borderX + borderWidth, borderY + borderHeight, BOTTOM_RIGHT, borderRadius, borderColour);
         }
 
         if (boxModel.borderBottomWidth > 0 && boxModel.borderLeftWidth > 0)
         {
-            uint32_t borderColour = 0xff000000 | getStyle("border-bottom-color", props).asInt();
+            uint32_t borderColour = 0xff000000 | style->get(STYLE_BORDER_BOTTOM_COLOR).asInt();
             surface->drawCorner(borderX, borderY + borderHeight, BOTTOM_LEFT, borderRadius, borderColour);
         }
 
         if (boxModel.borderBottomWidth > 0 && boxModel.borderLeftWidth > 0)
         {
-            uint32_t borderColour = 0xff000000 | getStyle("border-top-color", props).asInt();
+            uint32_t borderColour = 0xff000000 | style->get(STYLE_BORDER_TOP_COLOR).asInt();
             surface->drawCorner(borderX, borderY, TOP_LEFT, borderRadius, borderColour);
         }
     }
@@ -304,29 +561,22 @@ bool Widget::drawBorder(Surface* surface)
 
 bool Widget::hasStyle(string style)
 {
-    auto props = getStyleProperties();
-    return hasStyle(style, props);
+    return getComputedStyle()->has(style);
 }
 
-bool Widget::hasStyle(string style, unordered_map<string, Value>& properties)
+bool Widget::hasStyle(StyleProperty style)
 {
-    return (properties.find(style) != properties.end());
+    return getComputedStyle()->has(style);
 }
 
 Value Widget::getStyle(string style)
 {
-    auto props = getStyleProperties();
-    return getStyle(style, props);
+    return getComputedStyle()->get(style);
 }
 
-Value Widget::getStyle(std::string style, unordered_map<string, Value>& properties)
+Value Widget::getStyle(StyleProperty style)
 {
-    auto it = properties.find(style);
-    if (it != properties.end())
-    {
-        return it->second;
-    }
-    return Value();
+    return getComputedStyle()->get(style);
 }
 
 
@@ -336,16 +586,22 @@ void Widget::setStyle(string style, Value value)
     setDirty(DIRTY_STYLE);
 }
 
-unordered_map<string, Value>& Widget::getStyleProperties()
+const ComputedStyle* Widget::getComputedStyle()
 {
     uint64_t styleTS = m_app->getStyleEngine()->getTimestamp();
-    if ((m_dirty & DIRTY_STYLE) || styleTS != m_styleTimestamp)
+    if (m_computedStyle == NULL || (m_dirty & DIRTY_STYLE) || styleTS != m_styleTimestamp)
     {
+        ProfileScope scope(m_app->getProfiler(), PROFILE_STYLE, m_widgetName);
+        ComputedStyle* computedStyle = m_app->getStyleEngine()->getComputedStyle(this);
+        if (m_computedStyle != NULL)
+        {
+            m_computedStyle->release();
+        }
+        m_computedStyle = computedStyle;
         m_styleTimestamp = styleTS;
-        m_cachedStyleProperties = m_app->getStyleEngine()->getProperties(this);
     }
 
-    return m_cachedStyleProperties;
+    return m_computedStyle;
 }
 
 BoxModel& Widget::getBoxModel()
@@ -353,32 +609,31 @@ BoxModel& Widget::getBoxModel()
     uint64_t styleTS = m_app->getStyleEngine()->getTimestamp();
     if ((m_dirty & DIRTY_STYLE) || styleTS != m_cachedBoxModelTimestamp)
     {
-        auto props = getStyleProperties();
-        return getBoxModel(props);
+        return getBoxModel(getComputedStyle());
     }
 
     return m_cachedBoxModel;
 }
 
-BoxModel& Widget::getBoxModel(std::unordered_map<std::string, Value>& props)
+BoxModel& Widget::getBoxModel(const ComputedStyle* style)
 {
     uint64_t styleTS = m_app->getStyleEngine()->getTimestamp();
     if ((m_dirty & DIRTY_STYLE) || styleTS != m_cachedBoxModelTimestamp)
     {
-        m_cachedBoxModel.marginTop = getStyle("margin-top", props).asInt();
-        m_cachedBoxModel.marginRight = getStyle("margin-right", props).asInt();
-        m_cachedBoxModel.marginBottom = getStyle("margin-bottom", props).asInt();
-        m_cachedBoxModel.marginLeft = getStyle("margin-left", props).asInt();
+        m_cachedBoxModel.marginTop = style->get(STYLE_MARGIN_TOP).asInt();
+        m_cachedBoxModel.marginRight = style->get(STYLE_MARGIN_RIGHT).asInt();
+        m_cachedBoxModel.marginBottom = style->get(STYLE_MARGIN_BOTTOM).asInt();
+        m_cachedBoxModel.marginLeft = style->get(STYLE_MARGIN_LEFT).asInt();
 
-        m_cachedBoxModel.paddingTop = getStyle("padding-top", props).asInt();
-        m_cachedBoxModel.paddingRight = getStyle("padding-right", props).asInt();
-        m_cachedBoxModel.paddingBottom = getStyle("padding-bottom", props).asInt();
-        m_cachedBoxModel.paddingLeft = getStyle("padding-left", props).asInt();
+        m_cachedBoxModel.paddingTop = style->get(STYLE_PADDING_TOP).asInt();
+        m_cachedBoxModel.paddingRight = style->get(STYLE_PADDING_RIGHT).asInt();
+        m_cachedBoxModel.paddingBottom = style->get(STYLE_PADDING_BOTTOM).asInt();
+        m_cachedBoxModel.paddingLeft = style->get(STYLE_PADDING_LEFT).asInt();
 
-        m_cachedBoxModel.borderTopWidth = getStyle("border-top-width", props).asInt();
-        m_cachedBoxModel.borderRightWidth = getStyle("border-right-width", props).asInt();
-        m_cachedBoxModel.borderBottomWidth = getStyle("border-bottom-width", props).asInt();
-        m_cachedBoxModel.borderLeftWidth = getStyle("border-left-width", props).asInt();
+        m_cachedBoxModel.borderTopWidth = style->get(STYLE_BORDER_TOP_WIDTH).asInt();
+        m_cachedBoxModel.borderRightWidth = style->get(STYLE_BORDER_RIGHT_WIDTH).asInt();
+        m_cachedBoxModel.borderBottomWidth = style->get(STYLE_BORDER_BOTTOM_WIDTH).asInt();
+        m_cachedBoxModel.borderLeftWidth = style->get(STYLE_BORDER_LEFT_WIDTH).asInt();
 
         m_cachedBoxModelTimestamp = m_styleTimestamp;
     }
@@ -394,8 +649,10 @@ bool Widget::hasWidgetClass(std::wstring className)
 
 void Widget::setWidgetClass(std::wstring className)
 {
-    m_widgetClasses.insert(className);
-    setDirty(DIRTY_STYLE);
+    if (m_widgetClasses.insert(className).second)
+    {
+        setClassDirty(className);
+    }
 }
 
 void Widget::clearWidgetClass(std::wstring className)
@@ -404,7 +661,7 @@ void Widget::clearWidgetClass(std::wstring className)
     if (it != m_widgetClasses.end())
     {
         m_widgetClasses.erase(it);
-        setDirty(DIRTY_STYLE);
+        setClassDirty(className);
     }
 }
 
@@ -413,21 +670,21 @@ Geek::FontHandle* Widget::getTextFont()
     uint64_t styleTS = m_app->getStyleEngine()->getTimestamp();
     if (m_cachedTextFont == NULL || (m_dirty & DIRTY_STYLE) || styleTS != m_cachedTextFontTimestamp)
     {
-        auto props = getStyleProperties();
-        if (!hasStyle("font-family", props))
+        const ComputedStyle* style = getComputedStyle();
+        if (!style->has(STYLE_FONT_FAMILY))
         {
             log(WARN, "getTextFont: No font-family specified");
             return NULL;
         }
 
-        wstring fontFamily = getStyle("font-family", props).asString();
+        wstring fontFamily = style->get(STYLE_FONT_FAMILY).asString();
         wstring fontStyle = L"Regular";
 
-        if (hasStyle("font-style"))
+        if (style->has(STYLE_FONT_STYLE))
         {
-            fontStyle = getStyle("font-style", props).asString();
+            fontStyle = style->get(STYLE_FONT_STYLE).asString();
         }
-        int fontSize = getStyle("font-size", props).asInt();
+        int fontSize = style->get(STYLE_FONT_SIZE).asInt();
         if (m_cachedTextFont != NULL)
         {
             if (Utils::compare(m_cachedTextFont->getFontFace()->getFamily()->getName(), fontFamily) &&
@@ -437,7 +694,7 @@ Geek::FontHandle* Widget::getTextFont()
                 return m_cachedTextFont;
             }
 
-            delete m_cachedTextFont;
+            m_app->getTextCache()->removeFont(m_cachedTextFont);
         }
 
         FontManager* fm = m_app->getFontManager();
@@ -445,6 +702,8 @@ Geek::FontHandle* Widget::getTextFont()
         log(DEBUG, "getTextFont: Opening fontFamily: %s, style: %s fontSize: %d", fontFamily, fontStyle, fontSize);
 #endif
 
+        lock_guard<mutex> lock(m_app->getTextCache()->getFontMutex());
+        delete m_cachedTextFont;
         m_cachedTextFont = fm->openFont(Utils::wstring2string(fontFamily), Utils::wstring2string(fontStyle), fontSize);
         m_cachedTextFontTimestamp = m_app->getStyleEngine()->getTimestamp();
     }
@@ -459,13 +718,17 @@ void Widget::drawText(Geek::Gfx::Surface* surface, int x, int y, std::wstring te
         font = getTextFont();
     }
 
-    int colour = getStyle("text-color").asInt();
-    font->write(surface, x, y, text, colour);
+    int colour = getStyle(STYLE_TEXT_COLOR).asInt();
+    m_app->getTextCache()->write(surface, font, x, y, text, colour);
 }
 
 void Widget::setParent(Widget* widget)
 {
     m_parent = widget;
+    if (m_app != NULL)
+    {
+        m_app->layoutChanged();
+    }
 
     callInit();
 }
@@ -502,14 +765,19 @@ FrontierWindow* Widget::getWindow()
 
 Geek::Vector2D Widget::getAbsolutePosition() const
 {
-    Vector2D pos = m_position;
-
-    if (m_parent != NULL)
+    // Only walk up to the parent if something has moved since we last did
+    uint64_t generation = m_app->getLayoutGeneration();
+    if (m_absolutePositionGeneration != generation)
     {
-        pos += m_parent->getAbsolutePosition();
+        m_absolutePosition = m_position;
+        if (m_parent != NULL)
+        {
+            m_absolutePosition += m_parent->getAbsolutePosition();
+        }
+        m_absolutePositionGeneration = generation;
     }
 
-    return pos;
+    return m_absolutePosition;
 }
 
 bool Widget::intersects(int x, int y) const
@@ -522,29 +790,247 @@ bool Widget::intersects(int x, int y) const
     return (x >= x1 && y >= y1 && x < x2 && y < y2);
 }
 
+Widget* Widget::findChildAt(int x, int y)
+{
+    // Consecutive mouse events usually land on the same child
+    if (m_lastHitChild < m_children.size() && m_children[m_lastHitChild]->intersects(x, y))
+    {
+        return m_children[m_lastHitChild];
+    }
+
+    int found = -1;
+    if (m_children.size() < WIDGET_HIT_INDEX_MIN_CHILDREN)
+    {
+        unsigned int i;
+        for (i = 0; i < m_children.size(); i++)
+        {
+            if (m_children[i]->intersects(x, y))
+            {
+                found = i;
+                break;
+            }
+        }
+    }
+    else
+    {
+        if (m_hitIndex == NULL)
+        {
+            m_hitIndex = new HitIndex();
+        }
+
+        uint64_t generation = m_app->getLayoutGeneration();
+        if (m_hitIndexGeneration != generation || m_hitIndex->size() != m_children.size())
+        {
+            m_hitIndex->clear();
+            for (Widget* child : m_children)
+            {
+                Vector2D pos = child->getAbsolutePosition();
+                m_hitIndex->add(Rect(pos.x, pos.y, child->getWidth(), child->getHeight()));
+            }
+            m_hitIndex->build();
+            m_hitIndexGeneration = generation;
+        }
+        found = m_hitIndex->find(x, y);
+    }
+
+    if (found < 0)
+    {
+        return NULL;
+    }
+    m_lastHitChild = found;
+    return m_children[found];
+}
+
 void Widget::setDirty()
 {
     setDirty(DIRTY_SIZE | DIRTY_CONTENT | DIRTY_STYLE, false);
 }
 
-void Widget::setDirty(unsigned int dirty, bool children)
+void Widget::setDirty(unsigned int dirty, bool children, bool remeasure)
 {
     callInit();
     m_dirty |= dirty;
+    m_renderCacheValid = false;
+
+    if (remeasure && (dirty & (DIRTY_SIZE | DIRTY_STYLE)))
+    {
+        m_measureValid = false;
+    }
+
+    if (dirty & (DIRTY_SIZE | DIRTY_CONTENT))
+    {
+        m_damaged = true;
+    }
+
+    addToDirtyList();
 
     if (children)
     {
         for (Widget* child : getChildren())
         {
-            child->setDirty(dirty, true);
+            child->setDirty(dirty, true, remeasure);
         }
     }
-    else
+
+    // Our parents must always be dirty if we are, so that updates can skip clean subtrees.
+    // A style change on its own still has to be drawn, so our parents need to visit us
+    if (m_parent != NULL && dirty != 0)
+    {
+        if (dirty & DIRTY_STYLE)
+        {
+            dirty |= DIRTY_CONTENT;
+        }
+        setParentDirty(dirty, remeasure);
+    }
+}
+
+void Widget::setAreaDirty(Rect area)
+{
+    setDirty(DIRTY_SIZE | DIRTY_CONTENT, false, false);
+
+    for (Widget* child : getChildren())
     {
-        int parentDirty = dirty & ~DIRTY_STYLE; // Dirty flags doesn't propogate upwards
-        if (m_parent != NULL && parentDirty != 0)
+        Rect childRect(child->getX(), child->getY(), child->getWidth(), child->getHeight());
+        if (area.intersects(childRect))
         {
-            m_parent->setDirty(dirty);
+            child->setAreaDirty(Rect(area.x - child->getX(), area.y - child->getY(), area.width, area.height));
+        }
+    }
+}
+
+void Widget::setParentDirty(unsigned int dirty, bool remeasure)
+{
+    if ((dirty & (DIRTY_SIZE | DIRTY_STYLE)) && isLayoutBoundary())
+    {
+        // Our parents don't need laying out unless our size changes, see layoutBoundary()
+        dirty = DIRTY_CONTENT;
+        remeasure = false;
+    }
+    m_parent->setChildDirty(dirty, remeasure);
+}
+
+void Widget::setChildDirty(unsigned int dirty, bool remeasure)
+{
+    // Like setDirty, but only our children need redrawing
+    callInit();
+    m_renderCacheValid = false;
+
+    remeasure = remeasure && (dirty & (DIRTY_SIZE | DIRTY_STYLE));
+    if ((m_dirty & dirty) == dirty && m_dirtyListWindow != NULL && (!remeasure || !m_measureValid))
+    {
+        // Our parents have already been told
+        return;
+    }
+    m_dirty |= dirty;
+    if (remeasure)
+    {
+        m_measureValid = false;
+    }
+
+    addToDirtyList();
+
+    if (m_parent != NULL)
+    {
+        setParentDirty(dirty, remeasure);
+    }
+}
+
+bool Widget::isLayoutBoundary() const
+{
+    if (m_layoutBoundary)
+    {
+        return true;
+    }
+
+    if (m_parent == NULL)
+    {
+        return false;
+    }
+
+    if (m_setSize.width > 0 && m_minSize == m_maxSize)
+    {
+        // Fixed size, once we've been laid out
+        return true;
+    }
+
+    // Don't compute styles while marking things dirty, use whatever we had last
+    return m_computedStyle != NULL &&
+        m_computedStyle->has(STYLE_CONTAIN) &&
+        m_computedStyle->get(STYLE_CONTAIN).asString() == L"size";
+}
+
+bool Widget::layoutBoundary()
+{
+    Size minSize = m_minSize;
+    Size maxSize = m_maxSize;
+
+    measure();
+
+    if (m_minSize != minSize || m_maxSize != maxSize)
+    {
+        // Our parent will have to lay us out
+        if (m_parent != NULL)
+        {
+            m_parent->setChildDirty(DIRTY_SIZE, true);
+        }
+        return false;
+    }
+
+    ProfileScope scope(m_app->getProfiler(), PROFILE_LAYOUT, m_widgetName);
+    layout();
+    return true;
+}
+
+void Widget::addToDirtyList()
+{
+    if (m_dirtyListWindow != NULL)
+    {
+        return;
+    }
+
+    FrontierWindow* window = getWindow();
+    if (window != NULL)
+    {
+        m_dirtyListWindow = window;
+        window->addDirtyWidget(this);
+    }
+}
+
+void Widget::setStateDirty(unsigned int states)
+{
+    StyleEngine* styleEngine = m_app->getStyleEngine();
+    if (styleEngine == NULL)
+    {
+        setDirty(DIRTY_CONTENT | DIRTY_STYLE);
+        return;
+    }
+    setStyleDirty(styleEngine->getStateInvalidation(this, states));
+}
+
+void Widget::setClassDirty(const wstring& className)
+{
+    StyleEngine* styleEngine = m_app->getStyleEngine();
+    if (styleEngine == NULL)
+    {
+        setDirty(DIRTY_STYLE);
+        return;
+    }
+    setStyleDirty(styleEngine->getClassInvalidation(className));
+}
+
+void Widget::setStyleDirty(unsigned int invalidation)
+{
+    if (invalidation & STYLE_INVALIDATE_SELF)
+    {
+        setDirty(DIRTY_CONTENT | DIRTY_STYLE);
+    }
+
+    if (invalidation & STYLE_INVALIDATE_DESCENDANTS)
+    {
+        setDirty(DIRTY_CONTENT | DIRTY_STYLE);
+        for (Widget* child : getChildren())
+        {
+            child->setDirty(DIRTY_CONTENT | DIRTY_STYLE, true);
         }
     }
 }
@@ -552,17 +1038,22 @@ void Widget::setDirty(unsigned int dirty, bool children)
 void Widget::clearDirty()
 {
     m_dirty = 0;
+    m_damaged = false;
 
+    // Dirty flags always propagate upwards, so clean children have no dirty descendants
     for (Widget* child : m_children)
     {
-        child->clearDirty();
+        if (child->isDirty())
+        {
+            child->clearDirty();
+        }
     }
 }
 
 void Widget::setActive()
 {
     getWindow()->setActiveWidget(this);
-    setDirty(DIRTY_CONTENT | DIRTY_STYLE);
+    setDirty(DIRTY_CONTENT);
 }
 
 bool Widget::isActive()
@@ -639,14 +1130,14 @@ void Widget::onMouseEnter()
 {
     //m_mouseOver = true;
     m_mouseEnterSignal.emit(true);
-    setDirty(DIRTY_CONTENT | DIRTY_STYLE);
+    setStateDirty(STYLE_STATE_HOVER);
 }
 
 void Widget::onMouseLeave()
 {
     //m_mouseOver = false;
     m_mouseEnterSignal.emit(false);
-    setDirty(DIRTY_CONTENT | DIRTY_STYLE);
+    setStateDirty(STYLE_STATE_HOVER);
 }
 
 bool Widget::isMouseOver()
@@ -52,9 +52,9 @@ FrontierWindow::FrontierWindow(FrontierApp* app, std::wstring title, int flags)
     m_dragWidget = NULL;
     m_dragSurface = NULL;
 
-    m_updateTimestamp = 0;
     m_drawMutex = Geek::Thread::createMutex();
     m_updating = false;
+    m_dirtyMutex = Geek::Thread::createMutex();
     m_compositeSurface = false;
     m_windowSurface = NULL;
 
@@ -82,6 +82,19 @@ FrontierWindow::FrontierWindow(FrontierApp* app, std::wstring title, int flags)
 
 FrontierWindow::~FrontierWindow()
 {
+    m_app->getFrameScheduler()->cancelFrame(this);
+
+    if (m_app->getProfiler()->isEnabled() && m_frameHistogram.getCount() > 0)
+    {
+        log(INFO, "~FrontierWindow: Frame times: %s", m_frameHistogram.toString().c_str());
+    }
+
+    for (Widget* widget : m_dirtyWidgets)
+    {
+        widget->setDirtyListWindow(NULL);
+    }
+    m_dirtyWidgets.clear();
+
     for (Layer* layer : m_layers)
     {
         layer->decRefCount();
@@ -196,7 +209,9 @@ void FrontierWindow::setActiveWidget(Widget* widget)
 
     if (m_activeWidget != NULL)
     {
-        m_activeWidget->setDirty(DIRTY_STYLE);
+        // Widgets may draw differently when active, whether or not their style does
+        m_activeWidget->setDirty(DIRTY_CONTENT);
+        m_activeWidget->setStateDirty(STYLE_STATE_ACTIVE);
         m_activeWidget->signalInactive().emit();
         m_activeWidget->decRefCount();
     }
@@ -207,7 +222,8 @@ void FrontierWindow::setActiveWidget(Widget* widget)
     {
         log(DEBUG, "setActiveWidget: Active: %s (%p)", typeid(*widget).name(), widget);
         m_activeWidget->incRefCount();
-        m_activeWidget->setDirty(DIRTY_STYLE);
+        m_activeWidget->setDirty(DIRTY_CONTENT);
+        m_activeWidget->setStateDirty(STYLE_STATE_ACTIVE);
         m_activeWidget->signalActive().emit();
     }
     else
@@ -246,14 +262,12 @@ void FrontierWindow::setMouseOver(Widget* widget)
         {
             m_mouseOverWidget->onMouseLeave();
             m_mouseOverWidget->decRefCount();
-            m_mouseOverWidget->setDirty(DIRTY_CONTENT | DIRTY_STYLE);
         }
 
         m_mouseOverWidget = widget;
         if (m_mouseOverWidget != NULL)
         {
             m_mouseOverWidget->onMouseEnter();
-            m_mouseOverWidget->setDirty(DIRTY_CONTENT | DIRTY_STYLE);
         }
     }
 }
@@ -307,10 +321,17 @@ Widget* FrontierWindow::dragOver(Vector2D position, Widget* current, bool droppe
         return current;
     }
 
+    // Siblings don't overlap, so only the child under the pointer needs checking
+    Widget* hit = current->findChildAt(position.x, position.y);
+    if (hit != NULL)
+    {
+        return dragOver(position, hit, dropped);
+    }
+
+    // Some widgets report children that they don't keep in m_children
     vector<Widget*> children = current->getChildren();
     for (Widget* child : children)
     {
-
         if (child->intersects(position.x, position.y))
         {
             Widget* accepted = dragOver(position, child, dropped);
@@ -388,16 +409,8 @@ void FrontierWindow::update(bool force)
     }
     m_updating = true;
 
-    uint64_t now = m_app->getTimestamp();
-    if (force)
-    {
-        if ((now - m_updateTimestamp) < 10)
-        {
-            log(INFO, "update: Rate limiting forced updates!");
-            force = false;
-        }
-    }
-    m_updateTimestamp = now;
+    Profiler* profiler = m_app->getProfiler();
+    uint64_t frameStart = Profiler::getTime();
 
     initInternal();
 
@@ -421,6 +434,8 @@ void FrontierWindow::update(bool force)
         updated |= layer->update();
     }
 
+    clearDirtyWidgets();
+
     if (m_layers.size() > 1)
     {
         if (!m_compositeSurface)
@@ -443,6 +458,10 @@ void FrontierWindow::update(bool force)
 
     if (updated || force)
     {
+        Rect rootRect = m_rootLayer->getRect();
+        Rect windowRect(0, 0, rootRect.width, rootRect.height);
+        bool fullDamage = force || (m_dragSurface != NULL);
+
         if (m_compositeSurface)
         {
             Surface* surface = Surface::updateSurface(
@@ -454,10 +473,10 @@ void FrontierWindow::update(bool force)
             if (surface != m_windowSurface)
             {
                 m_windowSurface = surface;
+                fullDamage = true;
             }
         }
 
-        Rect rootRect = m_rootLayer->getRect();
         for (Layer* layer : m_layers)
         {
             Rect layerRect = layer->getRect();
@@ -486,23 +505,91 @@ void FrontierWindow::update(bool force)
                     layerRect.y = rootRect.height - layerRect.height;
                     break;
             }
+            if (!(layerRect == layer->getRect()))
+            {
+                // The Layer has moved
+                fullDamage = true;
+            }
             layer->setRect(layerRect);
 
-            if (m_compositeSurface)
+            if (m_compositeSurface && layer->isModal())
             {
-                if (layer->isModal())
+                // Darkening affects everything below
+                fullDamage = true;
+            }
+
+            m_damage.add(layer->getDamage(), layerRect.x, layerRect.y);
+            layer->clearDamage();
+        }
+
+        if (fullDamage)
+        {
+            m_damage.clear();
+            m_damage.add(windowRect);
+        }
+        m_damage.clip(windowRect);
+
+        if (m_compositeSurface)
+        {
+            ProfileScope compositeScope(profiler, PROFILE_COMPOSITE, "FrontierWindow::composite");
+            if (m_damage.covers(windowRect))
+            {
+                for (Layer* layer : m_layers)
                 {
-                    m_windowSurface->darken();
+                    if (layer->isModal())
+                    {
+                        m_windowSurface->darken();
+                    }
+                    Rect layerRect = layer->getRect();
+                    m_windowSurface->blit(layerRect.x, layerRect.y, layer->getSurface(), false);
                 }
-                m_windowSurface->blit(layerRect.x, layerRect.y, layer->getSurface(), false);
             }
             else
             {
-                m_windowSurface = layer->getSurface();
+                // Only composite the areas that have changed
+                float scale = getScaleFactor();
+                for (const Rect& rect : m_damage.getRects())
+                {
+                    for (Layer* layer : m_layers)
+                    {
+                        Rect layerRect = layer->getRect();
+                        Rect area = rect.intersect(layerRect);
+                        if (area.isEmpty())
+                        {
+                            continue;
+                        }
+
+                        int srcX = area.x - layerRect.x;
+                        int srcY = area.y - layerRect.y;
+                        int srcWidth = area.width;
+                        int srcHeight = area.height;
+                        if (layer->getSurface()->isHighDPI())
+                        {
+                            srcX *= scale;
+                            srcY *= scale;
+                            srcWidth *= scale;
+                            srcHeight *= scale;
+                        }
+                        m_windowSurface->blit(area.x, area.y, layer->getSurface(), srcX, srcY, srcWidth, srcHeight);
+                    }
+                }
             }
         }
+        else
+        {
+            m_windowSurface = m_rootLayer->getSurface();
+        }
+
+        m_presentDamage = m_damage;
+        m_presentDamage.scale(getScaleFactor());
+        m_damage.clear();
+
+        {
+            ProfileScope presentScope(profiler, PROFILE_PRESENT, "FrontierEngineWindow::update");
+            m_engineWindow->update();
+        }
 
-        m_engineWindow->update();
+        m_presentDamage.clear();
     }
 
     if (m_dragSurface != NULL)
@@ -510,13 +597,80 @@ void FrontierWindow::update(bool force)
         m_windowSurface->blit(m_dragPosition.x, m_dragPosition.y, m_dragSurface);
     }
 
+    if (updated || force)
+    {
+        uint64_t frameEnd = Profiler::getTime();
+        m_frameHistogram.add(frameEnd - frameStart);
+        if (profiler->isEnabled())
+        {
+            profiler->record(PROFILE_FRAME, "FrontierWindow::update", frameStart, frameEnd);
+        }
+    }
+
     m_updating = false;
     m_drawMutex->unlock();
+}
+
+void FrontierWindow::addDirtyWidget(Widget* widget)
+{
+    m_dirtyMutex->lock();
+    m_dirtyWidgets.push_back(widget);
+    m_dirtyMutex->unlock();
+
+    // Anything made dirty while updating is handled by this update
+    if (!m_updating)
+    {
+        m_app->getFrameScheduler()->requestFrame(this);
+    }
+}
+
+void FrontierWindow::removeDirtyWidget(Widget* widget)
+{
+    m_dirtyMutex->lock();
+    vector<Widget*>::iterator it;
+    for (it = m_dirtyWidgets.begin(); it != m_dirtyWidgets.end(); ++it)
+    {
+        if (*it == widget)
+        {
+            m_dirtyWidgets.erase(it);
+            break;
+        }
+    }
+    m_dirtyMutex->unlock();
+}
 
+bool FrontierWindow::hasDirtyWidgets()
+{
+    m_dirtyMutex->lock();
+    bool dirty = !m_dirtyWidgets.empty();
+    m_dirtyMutex->unlock();
+    return dirty;
+}
+
+void FrontierWindow::clearDirtyWidgets()
+{
+    m_dirtyMutex->lock();
+    vector<Widget*> widgets;
+    widgets.swap(m_dirtyWidgets);
+    m_dirtyMutex->unlock();
+
+    // The Layers have cleared everything they drew, this catches any
+    // Widgets that weren't drawn, such as those in hidden Tabs
+    for (Widget* widget : widgets)
+    {
+        widget->setDirtyListWindow(NULL);
+        if (widget->isDirty())
+        {
+            widget->clearDirty();
+        }
+    }
 }
 
 void FrontierWindow::requestUpdate()
 {
+    m_app->getFrameScheduler()->requestFrame(this);
+
+    // Make sure the engine wakes up to produce the frame
     if (m_engineWindow != NULL)
     {
         m_engineWindow->requestUpdate();
@@ -576,6 +730,37 @@ void FrontierWindow::openContextMenu(Geek::Vector2D pos, Menu* menu)
 
 void FrontierWindow::postEvent(Event* event)
 {
+    EventValue value;
+    switch (event->eventType)
+    {
+        case FRONTIER_EVENT_KEY:
+            value = *(KeyEvent*)event;
+            break;
+
+        case FRONTIER_EVENT_MOUSE_BUTTON:
+            value = *(MouseButtonEvent*)event;
+            break;
+
+        case FRONTIER_EVENT_MOUSE_MOTION:
+            value = *(MouseMotionEvent*)event;
+            break;
+
+        case FRONTIER_EVENT_MOUSE_SCROLL:
+            value = *(MouseScrollEvent*)event;
+            break;
+
+        default:
+            log(ERROR, "postEvent: Unknown event type: %d", event->eventType);
+            return;
+    }
+
+    // Keep the Window around until the Event has been handled
+    incRefCount();
+    m_app->post([this, value]() mutable
+    {
+        handleEvent(getEvent(value));
+        decRefCount();
+    });
 }
 
 bool FrontierWindow::handleEvent(Event* event)
@@ -720,13 +905,15 @@ bool FrontierWindow::handleEvent(Event* event)
 
         if (updateRequired || forceUpdate)
         {
-            update();
+            m_app->getFrameScheduler()->requestFrame(this);
         }
     }
 
-    delete event;
-
-    m_app->update();
+    if (!m_app->isInEventBatch())
+    {
+        // Not delivered by an engine's batch, so nothing else will produce the frame
+        m_app->getFrameScheduler()->runFrames(true);
+    }
 
     return true;
 }
@@ -0,0 +1,180 @@
+
+#include "testCommon.h"
+
+#include <frontier/async.h>
+
+#include <chrono>
+
+using namespace Frontier;
+using namespace std;
+
+class AsyncOwner : public FrontierObject
+{
+};
+
+// Run the UI loop until the condition is met, or give up after a few seconds
+template <typename Condition>
+static bool waitFor(FrontierApp* app, Condition condition)
+{
+    int i;
+    for (i = 0; i < 5000 && !condition(); i++)
+    {
+        app->getEngine()->checkEvents();
+        this_thread::sleep_for(chrono::milliseconds(1));
+    }
+    return condition();
+}
+
+TEST(AsyncTest, result)
+{
+    FrontierApp* app = new TestApp();
+    app->init();
+
+    // Work runs in the background, the result is delivered on the UI thread
+    thread::id uiThread = this_thread::get_id();
+    thread::id workThread = uiThread;
+    thread::id doneThread;
+    int result = 0;
+    app->async(NULL,
+        [&workThread]()
+        {
+            workThread = this_thread::get_id();
+            return 42;
+        },
+        [&result, &doneThread](int value)
+        {
+            result = value;
+            doneThread = this_thread::get_id();
+        });
+    EXPECT_TRUE(waitFor(app, [&result]() { return result != 0; }));
+    EXPECT_EQ(42, result);
+    EXPECT_NE(uiThread, workThread);
+    EXPECT_EQ(uiThread, doneThread);
+
+    // Work with no result
+    bool done = false;
+    app->async(NULL, []() {}, [&done]() { done = true; });
+    EXPECT_TRUE(waitFor(app, [&done]() { return done; }));
+
+    delete app;
+}
+
+TEST(AsyncTest, cancel)
+{
+    FrontierApp* app = new TestApp();
+    app->init();
+
+    atomic<bool> started(false);
+    atomic<bool> go(false);
+    atomic<bool> worked(false);
+    bool done = false;
+    AsyncOwner owner;
+    owner.incRefCount();
+
+    // Cancelled by the handle
+    AsyncHandle handle = app->async(&owner,
+        [&started, &go, &worked]()
+        {
+            started = true;
+            while (!go)
+            {
+                this_thread::yield();
+            }
+            worked = true;
+        },
+        [&done]() { done = true; });
+    EXPECT_EQ(2, owner.getRefCount());
+    while (!started)
+    {
+        this_thread::yield();
+    }
+    handle.cancel();
+    go = true;
+    EXPECT_TRUE(waitFor(app, [&owner]() { return owner.getRefCount() == 1; }));
+    EXPECT_TRUE(worked);
+    EXPECT_FALSE(done);
+
+    // Nothing else wants the owner any more
+    started = false;
+    go = false;
+    worked = false;
+    app->async(&owner,
+        [&started, &go, &worked]()
+        {
+            started = true;
+            while (!go)
+            {
+                this_thread::yield();
+            }
+            worked = true;
+        },
+        [&done]() { done = true; });
+    owner.decRefCount();
+    go = true;
+    EXPECT_TRUE(waitFor(app, [&owner]() { return owner.getRefCount() == 0; }));
+    EXPECT_TRUE(worked);
+    EXPECT_FALSE(done);
+
+    delete app;
+}
+
+TEST(AsyncTest, shutdown)
+{
+    FrontierApp* app = new TestApp();
+    app->init();
+
+    AsyncOwner owner;
+    owner.incRefCount();
+
+    // Keep every worker busy, so the rest are still queued when the app goes away
+    atomic<bool> go(false);
+    atomic<int> worked(0);
+    int done = 0;
+    unsigned int count = app->getWorkerPool()->getThreadCount() + 10;
+    unsigned int i;
+    for (i = 0; i < count; i++)
+    {
+        app->async(&owner,
+            [&go, &worked]()
+            {
+                while (!go)
+                {
+                    this_thread::yield();
+                }
+                worked++;
+            },
+            [&done]() { done++; });
+    }
+    EXPECT_EQ((int)count + 1, owner.getRefCount());
+
+    go = true;
+    delete app;
+
+    // Every reference has been released, but no results were delivered
+    EXPECT_EQ(1, owner.getRefCount());
+    EXPECT_EQ(0, done);
+    EXPECT_GE((int)count, worked.load());
+}
+
+TEST(AsyncTest, parallelFor)
+{
+    WorkerPool pool(4);
+
+    // Every index is visited exactly once
+    vector<atomic<int>> visits(1000);
+    pool.parallelFor(visits.size(), [&visits](unsigned int i) { visits[i]++; });
+    for (atomic<int>& count : visits)
+    {
+        EXPECT_EQ(1, count);
+    }
+
+    // Nesting doesn't wait for workers that are already busy
+    atomic<int> total(0);
+    pool.parallelFor(8, [&pool, &total](unsigned int)
+    {
+        pool.parallelFor(8, [&total](unsigned int) { total++; });
+    });
+    EXPECT_EQ(64, total);
+
+    pool.parallelFor(0, [](unsigned int) { FAIL(); });
+}
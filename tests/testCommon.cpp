@@ -3,6 +3,7 @@
 
 using namespace std;
 using namespace Frontier;
+using namespace Geek::Gfx;
 
 TestApp::TestApp() : FrontierApp(L"Test App")
 {
@@ -13,3 +14,60 @@ TestApp::TestApp() : FrontierApp(L"Test App")
 TestApp::~TestApp()
 {
 }
+
+OffscreenApp::OffscreenApp() : FrontierApp(L"Offscreen Test")
+{
+    m_offscreenEngine = new OffscreenEngine(this);
+    setEngine(m_offscreenEngine);
+}
+
+OffscreenApp::~OffscreenApp()
+{
+}
+
+TestWidget::TestWidget(FrontierApp* app, Size size, uint32_t colour) : TestWidget(app, size, size, colour)
+{
+}
+
+TestWidget::TestWidget(FrontierApp* app, Size min, Size max, uint32_t colour) : Widget(app, L"TestWidget")
+{
+    m_min = min;
+    m_max = max;
+    m_colour = colour;
+    m_measureCount = 0;
+    m_layoutCount = 0;
+    m_drawCount = 0;
+}
+
+void TestWidget::calculateSize()
+{
+    m_measureCount++;
+    m_minSize = m_min;
+    m_maxSize = m_max;
+}
+
+void TestWidget::layout()
+{
+    m_layoutCount++;
+}
+
+bool TestWidget::draw(Surface* surface)
+{
+    return draw(surface, Rect(0, 0, getWidth(), getHeight()));
+}
+
+bool TestWidget::draw(Surface* surface, Rect visible)
+{
+    m_drawCount++;
+    m_drawn.push_back(visible);
+    if (m_colour != 0)
+    {
+        surface->drawRectFilled(0, 0, getWidth(), getHeight(), m_colour);
+    }
+    return true;
+}
+
+uint32_t getSurfacePixel(Surface* surface, int x, int y)
+{
+    return ((uint32_t*)surface->getData())[(y * surface->getWidth()) + x];
+}
@@ -2,6 +2,8 @@
 #define __FRONTIER_TESTS_TEST_COMMON_H_
 
 #include <frontier/frontier.h>
+#include <frontier/widgets.h>
+#include <frontier/engines/offscreen.h>
 #include "engines/test/test_engine.h"
 
 #include <gtest/gtest.h>
@@ -13,5 +15,45 @@ class TestApp : public Frontier::FrontierApp
     virtual ~TestApp();
 };
 
+/// An app that renders through the OffscreenEngine, so frames can be inspected
+class OffscreenApp : public Frontier::FrontierApp
+{
+ public:
+    Frontier::OffscreenEngine* m_offscreenEngine;
+
+    OffscreenApp();
+    virtual ~OffscreenApp();
+};
+
+/**
+ * A Widget with a fixed size range that counts how often it is measured,
+ * laid out and drawn. If m_colour isn't 0, it fills itself with it.
+ */
+class TestWidget : public Frontier::Widget
+{
+ public:
+    Frontier::Size m_min;
+    Frontier::Size m_max;
+    uint32_t m_colour;
+
+    int m_measureCount;
+    int m_layoutCount;
+    int m_drawCount;
+
+    /// The visible area passed to each draw
+    std::vector<Frontier::Rect> m_drawn;
+
+    TestWidget(Frontier::FrontierApp* app, Frontier::Size size, uint32_t colour = 0);
+    TestWidget(Frontier::FrontierApp* app, Frontier::Size min, Frontier::Size max, uint32_t colour = 0);
+
+    void calculateSize() override;
+    void layout() override;
+    bool draw(Geek::Gfx::Surface* surface) override;
+    bool draw(Geek::Gfx::Surface* surface, Frontier::Rect visible) override;
+};
+
+/// Return a pixel from a 32 bit Surface
+uint32_t getSurfacePixel(Geek::Gfx::Surface* surface, int x, int y);
+
 
 #endif
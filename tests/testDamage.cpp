@@ -0,0 +1,117 @@
+
+#include "testCommon.h"
+
+#include <frontier/damage.h>
+#include <frontier/widgets/frame.h>
+
+using namespace Frontier;
+using namespace Geek::Gfx;
+using namespace std;
+
+TEST(DamageRegionTest, merge)
+{
+    DamageRegion damage;
+    EXPECT_TRUE(damage.isEmpty());
+
+    damage.add(Rect(0, 0, 10, 10));
+    damage.add(Rect(100, 100, 10, 10));
+    EXPECT_EQ(2, damage.getRects().size());
+
+    // Overlaps the first
+    damage.add(Rect(5, 5, 10, 10));
+    EXPECT_EQ(2, damage.getRects().size());
+    EXPECT_TRUE(damage.covers(Rect(0, 0, 15, 15)));
+
+    // Already covered
+    damage.add(Rect(2, 2, 2, 2));
+    EXPECT_EQ(2, damage.getRects().size());
+
+    // Empty Rects are ignored
+    damage.add(Rect(50, 50, 0, 10));
+    EXPECT_EQ(2, damage.getRects().size());
+
+    // Joins everything together
+    damage.add(Rect(10, 10, 95, 95));
+    EXPECT_EQ(1, damage.getRects().size());
+    EXPECT_TRUE(damage.getBounds() == Rect(0, 0, 110, 110));
+
+    damage.clear();
+    EXPECT_TRUE(damage.isEmpty());
+}
+
+TEST(DamageRegionTest, collapse)
+{
+    DamageRegion damage;
+    for (int i = 0; i < 100; i++)
+    {
+        damage.add(Rect(i * 20, 0, 10, 10));
+    }
+
+    EXPECT_GE(16, damage.getRects().size());
+    EXPECT_TRUE(damage.getBounds() == Rect(0, 0, 1990, 10));
+}
+
+TEST(DamageRegionTest, clipAndScale)
+{
+    DamageRegion damage;
+    damage.add(Rect(-10, -10, 20, 20));
+    damage.add(Rect(90, 90, 20, 20));
+    damage.clip(Rect(0, 0, 100, 100));
+
+    ASSERT_EQ(2, damage.getRects().size());
+    EXPECT_TRUE(damage.getRects().at(0) == Rect(0, 0, 10, 10));
+    EXPECT_TRUE(damage.getRects().at(1) == Rect(90, 90, 10, 10));
+
+    damage.scale(1.5f);
+    EXPECT_TRUE(damage.getRects().at(0) == Rect(0, 0, 15, 15));
+    EXPECT_TRUE(damage.getRects().at(1) == Rect(135, 135, 15, 15));
+
+    DamageRegion window;
+    window.add(damage, 5, 5);
+    EXPECT_TRUE(window.getBounds() == Rect(5, 5, 150, 150));
+}
+
+TEST(DamageRegionTest, present)
+{
+    OffscreenApp* app = new OffscreenApp();
+    ASSERT_TRUE(app->init());
+
+    FrontierWindow* window = new FrontierWindow(app, L"Damage", WINDOW_NORMAL);
+    Frame* root = new Frame(app, true);
+    TestWidget* first = new TestWidget(app, Size(50, 20), 0xffff0000);
+    TestWidget* second = new TestWidget(app, Size(50, 20), 0xffff0000);
+    root->add(first);
+    root->add(second);
+    window->setContent(root);
+    window->show();
+    app->m_offscreenEngine->checkEvents();
+
+    OffscreenWindow* ow = app->m_offscreenEngine->getWindow(window);
+    ASSERT_NE(nullptr, ow);
+    Surface* frame = ow->getFrame();
+    ASSERT_NE(nullptr, frame);
+
+    Geek::Vector2D firstPos = first->getAbsolutePosition();
+    Geek::Vector2D secondPos = second->getAbsolutePosition();
+    Rect firstRect(firstPos.x, firstPos.y, first->getWidth(), first->getHeight());
+    Rect secondRect(secondPos.x, secondPos.y, second->getWidth(), second->getHeight());
+    EXPECT_EQ(0xffff0000, getSurfacePixel(frame, firstPos.x + 1, firstPos.y + 1));
+
+    // Anything outside the damage isn't presented again
+    frame->drawRectFilled(secondPos.x, secondPos.y, 1, 1, 0xff00ff00);
+
+    first->m_colour = 0xff0000ff;
+    first->setDirty(DIRTY_CONTENT);
+    window->requestUpdate();
+    app->m_offscreenEngine->checkEvents();
+
+    const vector<Rect>& rects = ow->getPresentedRects();
+    ASSERT_EQ(1u, rects.size());
+    EXPECT_TRUE(rects.at(0).contains(firstRect));
+    EXPECT_FALSE(rects.at(0).intersects(secondRect));
+
+    frame = ow->getFrame();
+    EXPECT_EQ(0xff0000ff, getSurfacePixel(frame, firstPos.x + 1, firstPos.y + 1));
+    EXPECT_EQ(0xff00ff00, getSurfacePixel(frame, secondPos.x, secondPos.y));
+    EXPECT_EQ(0xffff0000, getSurfacePixel(frame, secondPos.x + 1, secondPos.y + 1));
+}
@@ -0,0 +1,149 @@
+#include "testCommon.h"
+
+#include <frontier/displaylist.h>
+#include <frontier/widgets.h>
+
+#include <cstring>
+
+using namespace Frontier;
+using namespace Geek::Gfx;
+using namespace std;
+
+class UnrecordedWidget : public TestWidget
+{
+ public:
+    explicit UnrecordedWidget(FrontierApp* app) : TestWidget(app, Size(20, 20), 0xffff0000) {}
+
+    bool draw(Surface* surface, Rect visible) override
+    {
+        RecordingSurface::markIncomplete(surface);
+        return TestWidget::draw(surface, visible);
+    }
+};
+
+static void drawShapes(Surface* surface)
+{
+    surface->clear(0xff000000);
+    surface->drawRectFilled(2, 2, 10, 10, 0xffff0000);
+    surface->drawRect(4, 14, 12, 8, 0xff00ff00);
+    surface->drawLine(0, 31, 31, 0, 0xffffffff);
+    surface->drawGrad(16, 2, 12, 10, 0xff0000ff, 0xff00ffff);
+}
+
+TEST(DisplayListTest, replay)
+{
+    Surface* direct = new Surface(32, 32, 4);
+    drawShapes(direct);
+
+    DisplayList list;
+    RecordingSurface recorder(&list, 32, 32, false);
+    drawShapes(&recorder);
+    EXPECT_EQ(5u, list.size());
+    EXPECT_TRUE(list.isComplete());
+
+    Surface* replayed = new Surface(32, 32, 4);
+    list.replay(replayed);
+    EXPECT_EQ(0, memcmp(direct->getData(), replayed->getData(), 32 * 32 * 4));
+
+    delete direct;
+    delete replayed;
+}
+
+TEST(DisplayListTest, isSame)
+{
+    DisplayList a;
+    DisplayList b;
+    RecordingSurface recorderA(&a, 32, 32, false);
+    RecordingSurface recorderB(&b, 32, 32, false);
+
+    drawShapes(&recorderA);
+    drawShapes(&recorderB);
+    EXPECT_TRUE(a.isSame(b));
+
+    recorderB.drawPixel(1, 1, 0xffffffff);
+    EXPECT_FALSE(a.isSame(b));
+
+    // Blitted Surfaces may have changed since they were recorded
+    b.clear();
+    drawShapes(&recorderB);
+    EXPECT_TRUE(a.isSame(b));
+    Surface* surface = new Surface(4, 4, 4);
+    recorderA.blit(0, 0, surface);
+    recorderB.blit(0, 0, surface);
+    EXPECT_FALSE(a.isSame(b));
+    delete surface;
+
+    // As may anything that wasn't recorded
+    a.clear();
+    b.clear();
+    RecordingSurface::markIncomplete(&recorderB);
+    EXPECT_FALSE(b.isComplete());
+    EXPECT_FALSE(a.isSame(b));
+}
+
+TEST(DisplayListTest, drawCached)
+{
+    FrontierApp* app = new TestApp();
+    app->init();
+    app->setDisplayListsEnabled(true);
+
+    TestWidget* widget = new TestWidget(app, Size(20, 20), 0xffff0000);
+    widget->setRenderCacheEnabled(true);
+    widget->calculateSize();
+    widget->setSize(Size(20, 20));
+
+    Surface* surface = new Surface(20, 20, 4);
+    widget->drawCached(surface, Rect(0, 0, 20, 20));
+    EXPECT_EQ(0xffff0000, ((uint32_t*)surface->getData())[0]);
+    widget->clearDirty();
+
+    // Mark the cached Surface, so we can tell whether it's rasterized again
+    bool created;
+    Surface* cached = app->getRenderCache()->get(widget, 20, 20, false, created);
+    ASSERT_FALSE(created);
+    cached->drawRectFilled(0, 0, 1, 1, 0xff00ff00);
+
+    // Redrawn, but nothing changed
+    widget->setDirty(DIRTY_CONTENT);
+    widget->drawCached(surface, Rect(0, 0, 20, 20));
+    EXPECT_EQ(2, widget->m_drawCount);
+    EXPECT_EQ(0xff00ff00, ((uint32_t*)surface->getData())[0]);
+    widget->clearDirty();
+
+    widget->m_colour = 0xff0000ff;
+    widget->setDirty(DIRTY_CONTENT);
+    widget->drawCached(surface, Rect(0, 0, 20, 20));
+    EXPECT_EQ(0xff0000ff, ((uint32_t*)surface->getData())[0]);
+    widget->clearDirty();
+
+    delete surface;
+}
+
+TEST(DisplayListTest, drawIncomplete)
+{
+    FrontierApp* app = new TestApp();
+    app->init();
+    app->setDisplayListsEnabled(true);
+
+    UnrecordedWidget* widget = new UnrecordedWidget(app);
+    widget->setRenderCacheEnabled(true);
+    widget->calculateSize();
+    widget->setSize(Size(20, 20));
+
+    // Recorded, and then drawn again because the list can't be replayed
+    Surface* surface = new Surface(20, 20, 4);
+    widget->drawCached(surface, Rect(0, 0, 20, 20));
+    EXPECT_EQ(2, widget->m_drawCount);
+    EXPECT_EQ(0xffff0000, ((uint32_t*)surface->getData())[0]);
+    widget->clearDirty();
+
+    // Not recorded again, so only drawn once
+    widget->m_colour = 0xff0000ff;
+    widget->setDirty(DIRTY_CONTENT);
+    widget->drawCached(surface, Rect(0, 0, 20, 20));
+    EXPECT_EQ(3, widget->m_drawCount);
+    EXPECT_EQ(0xff0000ff, ((uint32_t*)surface->getData())[0]);
+    widget->clearDirty();
+
+    delete surface;
+}
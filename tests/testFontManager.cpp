@@ -1,6 +1,8 @@
 
 #include "testCommon.h"
 
+#include <cstring>
+
 using namespace Frontier;
 using namespace Geek;
 
@@ -33,3 +35,83 @@ TEST(FontManagerTest, multipleOpens)
     
 }
 
+
+TEST(FontManagerTest, textCache)
+{
+    FrontierApp* app = new TestApp();
+    bool res = app->init();
+    EXPECT_EQ(true, res);
+
+    FontManager* fm = app->getFontManager();
+    FontHandle* handle = fm->openFont(
+        "Hack",
+        "Regular",
+        10);
+    ASSERT_TRUE(handle != NULL);
+
+    TextCache* textCache = app->getTextCache();
+    EXPECT_EQ(fm->width(handle, L"h"), textCache->width(handle, L'h'));
+
+    // The text and each of its characters are measured once
+    int width = textCache->width(handle, L"hello");
+    EXPECT_EQ(5u, textCache->getWidthCount());
+    EXPECT_EQ(width, textCache->width(handle, L"hello"));
+    EXPECT_EQ(5u, textCache->getWidthCount());
+
+    Gfx::Surface* surface = new Gfx::Surface(100, 20, 4);
+    textCache->write(surface, handle, 0, 0, L"hello", 0xffffffff);
+    EXPECT_EQ(1u, textCache->getPageCount());
+
+    // Each character is only rendered once
+    unsigned int glyphCount = textCache->getGlyphCount();
+    EXPECT_EQ(4u, glyphCount);
+    textCache->write(surface, handle, 0, 0, L"hello", 0xffffffff);
+    EXPECT_EQ(glyphCount, textCache->getGlyphCount());
+
+    // A new colour reuses the rendered coverage
+    textCache->write(surface, handle, 0, 0, L"he", 0xffff0000);
+    EXPECT_EQ(glyphCount + 2, textCache->getGlyphCount());
+
+    textCache->removeFont(handle);
+    EXPECT_EQ(0u, textCache->getGlyphCount());
+    EXPECT_EQ(0u, textCache->getWidthCount());
+
+    delete surface;
+}
+
+TEST(FontManagerTest, textCacheWidth)
+{
+    FrontierApp* app = new TestApp();
+    ASSERT_TRUE(app->init());
+
+    FontManager* fm = app->getFontManager();
+    FontHandle* handle = fm->openFont(
+        "Hack",
+        "Regular",
+        10);
+    ASSERT_TRUE(handle != NULL);
+    TextCache* textCache = app->getTextCache();
+
+    Gfx::Surface* whole = new Gfx::Surface(100, 20, 4);
+    Gfx::Surface* parts = new Gfx::Surface(100, 20, 4);
+
+    // The measured width is how far drawing the text advances
+    int width = textCache->width(handle, L"hello");
+    int x = 0;
+    for (wchar_t c : std::wstring(L"hello"))
+    {
+        x += textCache->write(parts, handle, x, 0, c, 0xffffffff);
+    }
+    EXPECT_EQ(width, x);
+
+    // Drawing text in two parts, using the measured width, matches drawing it all at once
+    whole->clear(0xff000000);
+    parts->clear(0xff000000);
+    textCache->write(whole, handle, 0, 0, L"hello world", 0xffffffff);
+    textCache->write(parts, handle, 0, 0, L"hello", 0xffffffff);
+    textCache->write(parts, handle, textCache->width(handle, L"hello"), 0, L" world", 0xffffffff);
+    EXPECT_EQ(0, memcmp(whole->getData(), parts->getData(), 100 * 20 * 4));
+
+    delete whole;
+    delete parts;
+}
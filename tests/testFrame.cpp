@@ -0,0 +1,215 @@
+
+#include "testCommon.h"
+
+#include <frontier/widgets/frame.h>
+
+using namespace Frontier;
+using namespace Geek::Gfx;
+using namespace std;
+
+TEST(FrameTest, dirtySubtree)
+{
+    FrontierApp* app = new TestApp();
+    app->init();
+
+    Frame* root = new Frame(app, false);
+    Frame* left = new Frame(app, true);
+    Frame* right = new Frame(app, true);
+    TestWidget* leftLeaf = new TestWidget(app, Size(10, 10), Size(100, 10));
+    TestWidget* rightLeaf = new TestWidget(app, Size(10, 10), Size(100, 10));
+    left->add(leftLeaf);
+    right->add(rightLeaf);
+    root->add(left);
+    root->add(right);
+
+    root->calculateSize();
+    root->setSize(root->getMinSize());
+    root->layout();
+
+    Surface* surface = new Surface(100, 100, 4);
+    root->draw(surface);
+    root->clearDirty();
+    EXPECT_FALSE(leftLeaf->isDirty());
+    EXPECT_FALSE(rightLeaf->isDirty());
+    EXPECT_EQ(1, leftLeaf->m_drawCount);
+    EXPECT_EQ(1, rightLeaf->m_drawCount);
+
+    // Marking a leaf dirty marks its parents, but not its siblings
+    leftLeaf->setDirty(DIRTY_CONTENT);
+    EXPECT_TRUE(left->isDirty());
+    EXPECT_TRUE(root->isDirty());
+    EXPECT_FALSE(right->isDirty());
+    EXPECT_FALSE(root->needsLayout());
+
+    // Only the dirty subtree is visited
+    root->draw(surface);
+    root->clearDirty();
+    EXPECT_EQ(2, leftLeaf->m_drawCount);
+    EXPECT_EQ(1, rightLeaf->m_drawCount);
+    EXPECT_FALSE(leftLeaf->isDirty());
+
+    // Marking children dirty also reaches the parents
+    right->setDirty(DIRTY_CONTENT, true);
+    EXPECT_TRUE(rightLeaf->isDirty());
+    EXPECT_TRUE(root->isDirty());
+    EXPECT_FALSE(left->isDirty());
+
+    root->draw(surface);
+    root->clearDirty();
+    EXPECT_EQ(2, leftLeaf->m_drawCount);
+    EXPECT_EQ(2, rightLeaf->m_drawCount);
+
+    delete surface;
+}
+
+class StyledWidget : public TestWidget
+{
+ public:
+    explicit StyledWidget(FrontierApp* app) : TestWidget(app, Size(50, 20)) {}
+
+    bool draw(Surface* surface, Rect visible) override
+    {
+        TestWidget::draw(surface, visible);
+        return drawBorder(surface);
+    }
+};
+
+TEST(FrameTest, setStyle)
+{
+    OffscreenApp* app = new OffscreenApp();
+    ASSERT_TRUE(app->init());
+
+    FrontierWindow* window = new FrontierWindow(app, L"Style", WINDOW_NORMAL);
+    Frame* root = new Frame(app, true);
+    StyledWidget* leaf = new StyledWidget(app);
+    root->add(leaf);
+    root->add(new TestWidget(app, Size(50, 20)));
+    window->setContent(root);
+    window->show();
+    window->update();
+    EXPECT_FALSE(root->isDirty());
+
+    // A style change on its own reaches the root, so the leaf is redrawn with it
+    int drawCount = leaf->m_drawCount;
+    leaf->setStyle("background-color", Value((int64_t)0xff0000ff));
+    EXPECT_TRUE(root->isDirty());
+    window->update();
+    EXPECT_EQ(drawCount + 1, leaf->m_drawCount);
+    EXPECT_FALSE(leaf->isDirty());
+
+    OffscreenWindow* ow = app->m_offscreenEngine->getWindow(window);
+    ASSERT_NE(nullptr, ow);
+    ASSERT_NE(nullptr, ow->getFrame());
+    Geek::Vector2D pos = leaf->getAbsolutePosition();
+    EXPECT_EQ(0xff0000ff, getSurfacePixel(ow->getFrame(), pos.x + (leaf->getWidth() / 2), pos.y + (leaf->getHeight() / 2)));
+
+    window->hide();
+    window->decRefCount();
+    delete app;
+}
+
+TEST(FrameTest, layoutBoundary)
+{
+    FrontierApp* app = new TestApp();
+    app->init();
+
+    Frame* root = new Frame(app, false);
+    Frame* boundary = new Frame(app, true);
+    TestWidget* leaf = new TestWidget(app, Size(10, 10), Size(100, 10));
+    boundary->add(leaf);
+    root->add(boundary);
+
+    root->calculateSize();
+    root->setSize(root->getMinSize());
+    root->layout();
+    root->clearDirty();
+
+    // A size change within a boundary doesn't reach the root
+    boundary->setLayoutBoundary(true);
+    leaf->setDirty(DIRTY_SIZE);
+    EXPECT_TRUE(boundary->needsLayout());
+    EXPECT_TRUE(root->isDirty());
+    EXPECT_FALSE(root->needsLayout());
+
+    // The boundary's size hasn't changed, so it can be laid out on its own
+    int layoutCount = leaf->m_layoutCount;
+    EXPECT_TRUE(boundary->layoutBoundary());
+    EXPECT_EQ(layoutCount + 1, leaf->m_layoutCount);
+    EXPECT_FALSE(root->needsLayout());
+    root->clearDirty();
+
+    // If it has, the parent has to be laid out after all
+    leaf->m_min.width = 20;
+    leaf->setDirty(DIRTY_SIZE);
+    EXPECT_FALSE(root->needsLayout());
+    EXPECT_FALSE(boundary->layoutBoundary());
+    EXPECT_TRUE(root->needsLayout());
+}
+
+TEST(FrameTest, measureCache)
+{
+    FrontierApp* app = new TestApp();
+    app->init();
+
+    Frame* root = new Frame(app, false);
+    TestWidget* leaf1 = new TestWidget(app, Size(10, 10), Size(100, 10));
+    TestWidget* leaf2 = new TestWidget(app, Size(10, 10), Size(100, 10));
+    root->add(leaf1);
+    root->add(leaf2);
+
+    root->measure();
+    EXPECT_EQ(1, leaf1->m_measureCount);
+    EXPECT_EQ(1, leaf2->m_measureCount);
+
+    // Nothing has changed
+    root->measure();
+    EXPECT_EQ(1, leaf1->m_measureCount);
+
+    // Laying out doesn't change what was measured
+    root->setSize(root->getMinSize());
+    root->layout();
+    root->measure();
+    EXPECT_EQ(1, leaf1->m_measureCount);
+    EXPECT_EQ(1, leaf2->m_measureCount);
+
+    // Only the changed child is measured again
+    leaf1->setDirty(DIRTY_SIZE);
+    root->measure();
+    EXPECT_EQ(2, leaf1->m_measureCount);
+    EXPECT_EQ(1, leaf2->m_measureCount);
+}
+
+TEST(FrameTest, hitTest)
+{
+    FrontierApp* app = new TestApp();
+    app->init();
+
+    // Enough children to use a hit index
+    Frame* root = new Frame(app, false);
+    vector<TestWidget*> leaves;
+    int i;
+    for (i = 0; i < 40; i++)
+    {
+        TestWidget* leaf = new TestWidget(app, Size(10, 10), Size(100, 10));
+        root->add(leaf);
+        leaves.push_back(leaf);
+    }
+    root->measure();
+    root->setSize(root->getMinSize());
+    root->layout();
+
+    for (TestWidget* leaf : leaves)
+    {
+        Geek::Vector2D pos = leaf->getAbsolutePosition();
+        EXPECT_EQ(leaf, root->findChildAt(pos.x + 1, pos.y + 1));
+    }
+    EXPECT_EQ(nullptr, root->findChildAt(-1, -1));
+
+    // Moving the parent moves the cached positions of its children
+    Geek::Vector2D before = leaves[20]->getAbsolutePosition();
+    root->setPosition(5, 7);
+    Geek::Vector2D after = leaves[20]->getAbsolutePosition();
+    EXPECT_EQ(before.x + 5, after.x);
+    EXPECT_EQ(before.y + 7, after.y);
+    EXPECT_EQ(leaves[20], root->findChildAt(after.x + 1, after.y + 1));
+}
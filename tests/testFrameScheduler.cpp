@@ -0,0 +1,57 @@
+
+#include "testCommon.h"
+
+#include <frontier/framescheduler.h>
+#include <frontier/widgets/button.h>
+
+using namespace Frontier;
+using namespace std;
+
+TEST(FrameSchedulerTest, pacing)
+{
+    OffscreenApp* app = new OffscreenApp();
+    ASSERT_TRUE(app->init());
+
+    FrameScheduler* scheduler = app->getFrameScheduler();
+    scheduler->setFrameInterval(1000000000);
+
+    FrontierWindow* window = new FrontierWindow(app, L"Scheduler", WINDOW_NORMAL);
+    Button* button = new Button(app, L"Button");
+    window->setContent(button);
+    window->show();
+
+    OffscreenWindow* ow = app->m_offscreenEngine->getWindow(window);
+    ASSERT_NE(nullptr, ow);
+
+    // Making a Widget dirty asks for a frame, but doesn't produce one
+    scheduler->runFrames(true);
+    unsigned int frames = ow->getFrameCount();
+    EXPECT_FALSE(scheduler->hasPendingFrames());
+    EXPECT_EQ(-1, scheduler->getTimeout());
+
+    button->setText(L"Changed");
+    EXPECT_TRUE(scheduler->hasPendingFrames());
+    EXPECT_EQ(frames, ow->getFrameCount());
+
+    // The last frame was too recent
+    EXPECT_FALSE(scheduler->runFrames());
+    EXPECT_LT(0, scheduler->getTimeout());
+    EXPECT_EQ(frames, ow->getFrameCount());
+
+    // Once due, every change so far is handled by a single frame
+    button->setText(L"Changed again");
+    scheduler->setFrameInterval(0);
+    EXPECT_EQ(0, scheduler->getTimeout());
+    EXPECT_TRUE(scheduler->runFrames());
+    EXPECT_EQ(frames + 1, ow->getFrameCount());
+    EXPECT_FALSE(scheduler->hasPendingFrames());
+    EXPECT_FALSE(button->isDirty());
+
+    // Nothing is produced when nothing has changed
+    EXPECT_FALSE(scheduler->runFrames());
+    EXPECT_EQ(frames + 1, ow->getFrameCount());
+
+    window->hide();
+    window->decRefCount();
+    delete app;
+}
@@ -69,3 +69,32 @@ TEST(FrontierAppTest, gc)
 
 
 
+
+TEST(FrontierAppTest, gcReleaseQueue)
+{
+    FrontierApp* app = new TestApp();
+
+    // Objects that are never referenced are freed
+    FrontierObject* unreferenced = new FrontierObject();
+    app->registerObject(unreferenced);
+    EXPECT_EQ(1u, app->getObjectCount());
+    app->gc();
+    EXPECT_EQ(0u, app->getObjectCount());
+
+    // An object that gains a reference again before gc is kept
+    FrontierObject* obj = new FrontierObject();
+    obj->incRefCount();
+    app->registerObject(obj);
+    obj->decRefCount();
+    obj->incRefCount();
+    app->gc();
+    EXPECT_EQ(1u, app->getObjectCount());
+    EXPECT_EQ(1, obj->getRefCount());
+
+    // Releasing it more than once only frees it once
+    obj->decRefCount();
+    obj->incRefCount();
+    obj->decRefCount();
+    app->gc();
+    EXPECT_EQ(0u, app->getObjectCount());
+}
@@ -0,0 +1,60 @@
+#include "testCommon.h"
+
+#include <frontier/hitindex.h>
+
+using namespace Frontier;
+using namespace std;
+
+TEST(HitIndexTest, find)
+{
+    HitIndex index;
+    EXPECT_EQ(-1, index.find(0, 0));
+
+    // A vertical list
+    int i;
+    for (i = 0; i < 100; i++)
+    {
+        index.add(Rect(0, i * 20, 200, 20));
+    }
+    index.build();
+    EXPECT_EQ(100, index.size());
+    EXPECT_EQ(0, index.find(0, 0));
+    EXPECT_EQ(0, index.find(199, 19));
+    EXPECT_EQ(1, index.find(10, 20));
+    EXPECT_EQ(99, index.find(10, 1999));
+    EXPECT_EQ(-1, index.find(200, 10));
+    EXPECT_EQ(-1, index.find(10, 2000));
+    EXPECT_EQ(-1, index.find(-1, 10));
+
+    // A grid of icons with gaps between them
+    index.clear();
+    for (i = 0; i < 100; i++)
+    {
+        index.add(Rect((i % 10) * 40, (i / 10) * 40, 32, 32));
+    }
+    index.build();
+    EXPECT_EQ(0, index.find(0, 0));
+    EXPECT_EQ(11, index.find(45, 45));
+    EXPECT_EQ(99, index.find(391, 391));
+    EXPECT_EQ(-1, index.find(35, 5));
+}
+
+TEST(HitIndexTest, overlap)
+{
+    HitIndex index;
+
+    // The first Rect added wins, and empty Rects are never found
+    index.add(Rect(10, 10, 0, 0));
+    index.add(Rect(0, 0, 100, 100));
+    index.add(Rect(20, 20, 10, 10));
+    index.build();
+    EXPECT_EQ(1, index.find(10, 10));
+    EXPECT_EQ(1, index.find(25, 25));
+
+    index.clear();
+    index.add(Rect(20, 20, 10, 10));
+    index.add(Rect(0, 0, 100, 100));
+    index.build();
+    EXPECT_EQ(0, index.find(25, 25));
+    EXPECT_EQ(1, index.find(50, 50));
+}
@@ -0,0 +1,105 @@
+
+#include "testCommon.h"
+
+#include <frontier/widgets/list.h>
+
+using namespace Frontier;
+using namespace Geek::Gfx;
+using namespace std;
+
+class TestRowItem : public ListItem
+{
+ public:
+    unsigned int m_row = 0;
+
+    explicit TestRowItem(FrontierApp* app) : ListItem(app) {}
+};
+
+class TestListModel : public ListModel
+{
+ public:
+    unsigned int m_rowCount;
+    int m_created = 0;
+    int m_bound = 0;
+
+    explicit TestListModel(unsigned int rowCount) : m_rowCount(rowCount) {}
+
+    unsigned int getRowCount() override { return m_rowCount; }
+    int getFixedRowHeight() override { return 10; }
+
+    ListItem* createItem(List* list) override
+    {
+        m_created++;
+        return new TestRowItem(list->getApp());
+    }
+
+    void bindItem(ListItem* item, unsigned int row) override
+    {
+        m_bound++;
+        ((TestRowItem*)item)->m_row = row;
+    }
+};
+
+TEST(ListTest, virtualSize)
+{
+    FrontierApp* app = new TestApp();
+    app->init();
+
+    TestListModel model(1000000);
+    List* list = new List(app);
+    list->setModel(&model);
+    list->calculateSize();
+
+    // No items are needed to size the List
+    EXPECT_EQ(0, model.m_created);
+    EXPECT_LE(10000000, list->getMinSize().height);
+}
+
+TEST(ListTest, virtualRecycle)
+{
+    FrontierApp* app = new TestApp();
+    app->init();
+
+    TestListModel model(1000);
+    List* list = new List(app);
+    list->setModel(&model);
+    list->calculateSize();
+    list->setSize(Size(50, list->getMinSize().height));
+    list->layout();
+
+    Surface* surface = new Surface(50, list->getHeight(), 4);
+
+    list->draw(surface, Rect(0, 5000, 50, 100));
+    EXPECT_EQ(11, model.m_created);
+    EXPECT_EQ(11, model.m_bound);
+    ASSERT_EQ(11u, list->getChildren().size());
+    EXPECT_EQ(499u, ((TestRowItem*)list->getItem(0))->m_row);
+    EXPECT_EQ(499, list->getItemRow(list->getItem(0)));
+
+    // Scrolling reuses the rows that are still visible and recycles the rest
+    list->draw(surface, Rect(0, 5050, 50, 100));
+    EXPECT_EQ(11, model.m_created);
+    EXPECT_EQ(16, model.m_bound);
+    EXPECT_EQ(504u, ((TestRowItem*)list->getItem(0))->m_row);
+    EXPECT_EQ(5042, list->getItem(0)->getY());
+
+    // Selection follows the row, not the ListItem
+    list->setSelectedRow(505);
+    EXPECT_TRUE(list->getItem(1)->isSelected());
+    list->draw(surface, Rect(0, 0, 50, 100));
+    EXPECT_EQ(11, model.m_created);
+    EXPECT_EQ(-1, list->getItemRow(list->getSelected()));
+    EXPECT_EQ(505, list->getSelectedRow());
+    for (Widget* item : list->getChildren())
+    {
+        EXPECT_FALSE(item->isSelected());
+    }
+
+    model.m_rowCount = 5;
+    list->modelChanged();
+    list->draw(surface, Rect(0, 0, 50, 100));
+    EXPECT_EQ(5u, list->getChildren().size());
+    EXPECT_EQ(-1, list->getSelectedRow());
+
+    delete surface;
+}
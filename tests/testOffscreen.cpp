@@ -0,0 +1,263 @@
+
+#include "testCommon.h"
+
+#include <frontier/widgets/button.h>
+#include <frontier/widgets/frame.h>
+#include <frontier/widgets/label.h>
+
+#include <cstring>
+#include <thread>
+
+using namespace Frontier;
+using namespace Geek::Gfx;
+using namespace std;
+
+static int g_clicks = 0;
+
+static void onClick(Widget* widget)
+{
+    g_clicks++;
+}
+
+TEST(OffscreenEngineTest, renderAndInject)
+{
+    OffscreenApp* app = new OffscreenApp();
+    ASSERT_TRUE(app->init());
+
+    FrontierWindow* window = new FrontierWindow(app, L"Offscreen", WINDOW_NORMAL);
+    Button* button = new Button(app, L"Click Me");
+    button->clickSignal().connect(sigc::ptr_fun(onClick));
+    window->setContent(button);
+    window->show();
+
+    OffscreenWindow* ow = app->m_offscreenEngine->getWindow(window);
+    ASSERT_NE(nullptr, ow);
+    EXPECT_LE(1u, ow->getFrameCount());
+    ASSERT_NE(nullptr, ow->getFrame());
+    EXPECT_EQ(window->getSize().width, ow->getFrame()->getWidth());
+    EXPECT_EQ(window->getSize().height, ow->getFrame()->getHeight());
+
+    // Injected input is only delivered by checkEvents
+    Geek::Vector2D pos = button->getAbsolutePosition();
+    app->m_offscreenEngine->injectClick(window, pos.x + (button->getWidth() / 2), pos.y + (button->getHeight() / 2));
+    EXPECT_TRUE(app->m_offscreenEngine->hasPendingEvents());
+    EXPECT_EQ(0, g_clicks);
+
+    EXPECT_TRUE(app->m_offscreenEngine->checkEvents());
+    EXPECT_FALSE(app->m_offscreenEngine->hasPendingEvents());
+    EXPECT_EQ(1, g_clicks);
+
+    // Updates that are requested are made by the next checkEvents
+    unsigned int frames = ow->getFrameCount();
+    button->setDirty(DIRTY_CONTENT);
+    window->requestUpdate();
+    app->m_offscreenEngine->checkEvents();
+    EXPECT_EQ(frames + 1, ow->getFrameCount());
+
+    EXPECT_TRUE(ow->saveFrame("/tmp/frontier-offscreen-test.png"));
+}
+
+TEST(OffscreenEngineTest, coalesceEvents)
+{
+    OffscreenApp* app = new OffscreenApp();
+    ASSERT_TRUE(app->init());
+
+    FrontierWindow* window = new FrontierWindow(app, L"Offscreen", WINDOW_NORMAL);
+    Button* button = new Button(app, L"Click Me");
+    button->clickSignal().connect(sigc::ptr_fun(onClick));
+    window->setContent(button);
+    window->show();
+
+    OffscreenWindow* ow = app->m_offscreenEngine->getWindow(window);
+    ASSERT_NE(nullptr, ow);
+    unsigned int frames = ow->getFrameCount();
+
+    // A burst of motion is handled as one event, with one update
+    Geek::Vector2D pos = button->getAbsolutePosition();
+    int i;
+    for (i = 0; i < 50; i++)
+    {
+        app->m_offscreenEngine->injectMouseMotion(window, pos.x + (i % button->getWidth()), pos.y + (button->getHeight() / 2));
+    }
+    EXPECT_TRUE(app->m_offscreenEngine->checkEvents());
+    EXPECT_TRUE(button->isMouseOver());
+    EXPECT_GE(frames + 1, ow->getFrameCount());
+
+    // Clicks are never merged, even with motion between them
+    g_clicks = 0;
+    frames = ow->getFrameCount();
+    for (i = 0; i < 3; i++)
+    {
+        app->m_offscreenEngine->injectMouseMotion(window, pos.x + 1, pos.y + 1);
+        app->m_offscreenEngine->injectMouseMotion(window, pos.x + 2, pos.y + 2);
+        app->m_offscreenEngine->injectClick(window, pos.x + 2, pos.y + 2);
+    }
+    EXPECT_TRUE(app->m_offscreenEngine->checkEvents());
+    EXPECT_EQ(3, g_clicks);
+    EXPECT_GE(frames + 1, ow->getFrameCount());
+}
+
+TEST(OffscreenEngineTest, reuseEvent)
+{
+    OffscreenApp* app = new OffscreenApp();
+    ASSERT_TRUE(app->init());
+
+    FrontierWindow* window = new FrontierWindow(app, L"Offscreen", WINDOW_NORMAL);
+    Button* button = new Button(app, L"Click Me");
+    button->clickSignal().connect(sigc::ptr_fun(onClick));
+    window->setContent(button);
+    window->show();
+    app->m_offscreenEngine->checkEvents();
+
+    // The window doesn't take ownership, so one event can be delivered repeatedly
+    Geek::Vector2D pos = button->getAbsolutePosition();
+    MouseButtonEvent event;
+    event.eventType = FRONTIER_EVENT_MOUSE_BUTTON;
+    event.window = window;
+    event.buttons = BUTTON_LEFT;
+    event.doubleClick = false;
+    event.x = pos.x + 2;
+    event.y = pos.y + 2;
+
+    g_clicks = 0;
+    int i;
+    for (i = 0; i < 2; i++)
+    {
+        event.direction = true;
+        window->handleEvent(&event);
+        event.direction = false;
+        window->handleEvent(&event);
+    }
+    EXPECT_EQ(2, g_clicks);
+}
+
+TEST(OffscreenEngineTest, postEvent)
+{
+    OffscreenApp* app = new OffscreenApp();
+    ASSERT_TRUE(app->init());
+
+    FrontierWindow* window = new FrontierWindow(app, L"Offscreen", WINDOW_NORMAL);
+    Button* button = new Button(app, L"Click Me");
+    button->clickSignal().connect(sigc::ptr_fun(onClick));
+    window->setContent(button);
+    window->show();
+    app->m_offscreenEngine->checkEvents();
+
+    // Events and Tasks from another thread wait for the UI thread
+    Geek::Vector2D pos = button->getAbsolutePosition();
+    bool taskRun = false;
+    g_clicks = 0;
+    thread producer([app, window, pos, &taskRun]()
+    {
+        MouseButtonEvent event;
+        event.eventType = FRONTIER_EVENT_MOUSE_BUTTON;
+        event.buttons = BUTTON_LEFT;
+        event.doubleClick = false;
+        event.x = pos.x + 2;
+        event.y = pos.y + 2;
+        event.direction = true;
+        window->postEvent(&event);
+        event.direction = false;
+        window->postEvent(&event);
+
+        app->post([&taskRun]() { taskRun = true; });
+    });
+    producer.join();
+    EXPECT_EQ(0, g_clicks);
+    EXPECT_FALSE(taskRun);
+
+    EXPECT_TRUE(app->m_offscreenEngine->checkEvents());
+    EXPECT_EQ(1, g_clicks);
+    EXPECT_TRUE(taskRun);
+}
+
+TEST(OffscreenEngineTest, parallelDraw)
+{
+    OffscreenApp* app = new OffscreenApp();
+    ASSERT_TRUE(app->init());
+
+    FrontierWindow* window = new FrontierWindow(app, L"Offscreen", WINDOW_NORMAL);
+    Frame* root = new Frame(app, true);
+    int i;
+    for (i = 0; i < 4; i++)
+    {
+        Frame* column = new Frame(app, false);
+        column->add(new Label(app, L"Label " + to_wstring(i)));
+        column->add(new Button(app, L"Button " + to_wstring(i)));
+        root->add(column);
+    }
+    window->setContent(root);
+    window->show();
+    window->setSize(Size(640, 480));
+    app->m_offscreenEngine->checkEvents();
+
+    OffscreenWindow* ow = app->m_offscreenEngine->getWindow(window);
+    ASSERT_NE(nullptr, ow);
+    Surface* frame = ow->getFrame();
+    ASSERT_NE(nullptr, frame);
+    vector<uint8_t> serial(frame->getData(), frame->getData() + (frame->getHeight() * frame->getStride()));
+
+    // Drawing the columns at the same time gives the same result
+    app->setParallelDraw(true);
+    root->setDirty(DIRTY_SIZE | DIRTY_CONTENT, true);
+    window->requestUpdate();
+    app->m_offscreenEngine->checkEvents();
+    frame = ow->getFrame();
+    ASSERT_EQ(serial.size(), (size_t)(frame->getHeight() * frame->getStride()));
+    EXPECT_EQ(0, memcmp(serial.data(), frame->getData(), serial.size()));
+}
+
+TEST(OffscreenEngineTest, displayLists)
+{
+    OffscreenApp* app = new OffscreenApp();
+    ASSERT_TRUE(app->init());
+
+    FrontierWindow* window = new FrontierWindow(app, L"Offscreen", WINDOW_NORMAL);
+    Frame* root = new Frame(app, false);
+    root->add(new Label(app, L"Recorded"));
+    root->add(new Button(app, L"Replayed"));
+    root->setRenderCacheEnabled(true);
+    window->setContent(root);
+    window->show();
+    app->m_offscreenEngine->checkEvents();
+
+    OffscreenWindow* ow = app->m_offscreenEngine->getWindow(window);
+    ASSERT_NE(nullptr, ow);
+    Surface* frame = ow->getFrame();
+    ASSERT_NE(nullptr, frame);
+    vector<uint8_t> direct(frame->getData(), frame->getData() + (frame->getHeight() * frame->getStride()));
+
+    // Replaying what was recorded gives the same result as drawing directly
+    app->setDisplayListsEnabled(true);
+    root->setDirty(DIRTY_SIZE | DIRTY_CONTENT, true);
+    window->requestUpdate();
+    app->m_offscreenEngine->checkEvents();
+    frame = ow->getFrame();
+    ASSERT_EQ(direct.size(), (size_t)(frame->getHeight() * frame->getStride()));
+    EXPECT_EQ(0, memcmp(direct.data(), frame->getData(), direct.size()));
+}
+
+TEST(OffscreenEngineTest, activeWidget)
+{
+    OffscreenApp* app = new OffscreenApp();
+    ASSERT_TRUE(app->init());
+
+    FrontierWindow* window = new FrontierWindow(app, L"Offscreen", WINDOW_NORMAL);
+    Frame* root = new Frame(app, true);
+    Button* first = new Button(app, L"First");
+    Button* second = new Button(app, L"Second");
+    root->add(first);
+    root->add(second);
+    window->setContent(root);
+    window->show();
+    window->setActiveWidget(first);
+    window->requestUpdate();
+    app->m_offscreenEngine->checkEvents();
+    EXPECT_FALSE(first->isDirty());
+    EXPECT_FALSE(second->isDirty());
+
+    // Both Widgets are redrawn when focus moves, even if no style depends on it
+    window->setActiveWidget(second);
+    EXPECT_TRUE(first->isDirty(DIRTY_CONTENT));
+    EXPECT_TRUE(second->isDirty(DIRTY_CONTENT));
+}
@@ -0,0 +1,131 @@
+
+#include "testCommon.h"
+
+#include <frontier/profiler.h>
+#include <frontier/widgets/button.h>
+
+#include <fstream>
+#include <sstream>
+#include <thread>
+
+using namespace Frontier;
+using namespace std;
+
+TEST(ProfilerTest, frameHistogram)
+{
+    FrameHistogram histogram;
+    EXPECT_EQ(0u, histogram.getCount());
+    EXPECT_EQ(0u, histogram.getPercentile(50));
+
+    int i;
+    for (i = 1; i <= 100; i++)
+    {
+        histogram.add(i * 1000000);
+    }
+    EXPECT_EQ(100u, histogram.getCount());
+    EXPECT_EQ(100000000u, histogram.getMax());
+    EXPECT_EQ(50500000u, histogram.getAverage());
+    EXPECT_EQ(51000000u, histogram.getPercentile(50));
+    EXPECT_EQ(100000000u, histogram.getPercentile(100));
+
+    // 1-3ms, 4-7ms, 8-16ms
+    EXPECT_EQ(3u, histogram.getBucket(0));
+    EXPECT_EQ(4u, histogram.getBucket(1));
+    EXPECT_EQ(9u, histogram.getBucket(2));
+
+    unsigned int total = 0;
+    unsigned int bucket;
+    for (bucket = 0; bucket < FRONTIER_FRAME_BUCKETS; bucket++)
+    {
+        total += histogram.getBucket(bucket);
+    }
+    EXPECT_EQ(100u, total);
+
+    // Only the most recent frames are kept
+    for (i = 0; i < FRONTIER_FRAME_HISTORY; i++)
+    {
+        histogram.add(1000000);
+    }
+    EXPECT_EQ((unsigned int)FRONTIER_FRAME_HISTORY, histogram.getCount());
+    EXPECT_EQ(1000000u, histogram.getMax());
+}
+
+TEST(ProfilerTest, trace)
+{
+    OffscreenApp* app = new OffscreenApp();
+    ASSERT_TRUE(app->init());
+
+    Profiler* profiler = app->getProfiler();
+
+    // Nothing is recorded until the Profiler is started
+    FrontierWindow* window = new FrontierWindow(app, L"Profiler", WINDOW_NORMAL);
+    Button* button = new Button(app, L"Button");
+    window->setContent(button);
+    window->show();
+    EXPECT_EQ(0u, profiler->getEventCount());
+    EXPECT_LE(1u, window->getFrameHistogram().getCount());
+
+    profiler->start();
+    button->setText(L"Profiled");
+    window->update();
+    profiler->stop();
+    EXPECT_LT(0u, profiler->getEventCount());
+
+    string path = "frontier_test_trace.json";
+    ASSERT_TRUE(profiler->writeTrace(path));
+
+    ifstream file(path);
+    stringstream buffer;
+    buffer << file.rdbuf();
+    string trace = buffer.str();
+    remove(path.c_str());
+
+    EXPECT_EQ(0u, trace.find("{\"traceEvents\":["));
+    EXPECT_NE(string::npos, trace.find("\"cat\":\"frame\""));
+    EXPECT_NE(string::npos, trace.find("\"cat\":\"measure\""));
+    EXPECT_NE(string::npos, trace.find("\"cat\":\"draw\""));
+    EXPECT_NE(string::npos, trace.find("\"cat\":\"present\""));
+    EXPECT_NE(string::npos, trace.find("\"name\":\"Button\""));
+
+    window->hide();
+    window->decRefCount();
+    delete app;
+}
+
+TEST(ProfilerTest, threads)
+{
+    Profiler profiler;
+    profiler.start();
+
+    // Each thread records in to its own buffer
+    vector<thread> threads;
+    vector<const char*> names(4);
+    int i;
+    for (i = 0; i < 4; i++)
+    {
+        threads.emplace_back([&profiler, &names, i]()
+        {
+            names[i] = profiler.getName(L"Worker");
+            int j;
+            for (j = 0; j < 100; j++)
+            {
+                ProfileScope scope(&profiler, PROFILE_DRAW, wstring(L"Worker"));
+            }
+        });
+    }
+    for (thread& t : threads)
+    {
+        t.join();
+    }
+    profiler.stop();
+    EXPECT_EQ(400u, profiler.getEventCount());
+
+    // Names are shared between threads
+    for (const char* name : names)
+    {
+        EXPECT_EQ(profiler.getName(L"Worker"), name);
+    }
+
+    profiler.clear();
+    EXPECT_EQ(0u, profiler.getEventCount());
+}
@@ -0,0 +1,120 @@
+
+#include "testCommon.h"
+
+#include <frontier/widgets.h>
+#include <frontier/widgets/frame.h>
+
+using namespace Frontier;
+using namespace Geek::Gfx;
+using namespace std;
+
+TEST(RenderCacheTest, lru)
+{
+    FrontierApp* app = new TestApp();
+    RenderCache* cache = app->getRenderCache();
+
+    Widget* a = new Widget(app, L"WidgetA");
+    Widget* b = new Widget(app, L"WidgetB");
+    Widget* c = new Widget(app, L"WidgetC");
+
+    // Room for two 10x10 Surfaces
+    cache->setBudget(10 * 10 * 4 * 2);
+
+    bool created;
+    Surface* surfaceA = cache->get(a, 10, 10, false, created);
+    EXPECT_NE(nullptr, surfaceA);
+    EXPECT_TRUE(created);
+    EXPECT_EQ(surfaceA, cache->get(a, 10, 10, false, created));
+    EXPECT_FALSE(created);
+
+    cache->get(b, 10, 10, false, created);
+    EXPECT_EQ(2u, cache->getCount());
+
+    // Using A makes B the least recently used
+    cache->get(a, 10, 10, false, created);
+    cache->get(c, 10, 10, false, created);
+    EXPECT_EQ(2u, cache->getCount());
+    EXPECT_EQ(10u * 10u * 4u * 2u, cache->getUsed());
+
+    cache->get(a, 10, 10, false, created);
+    EXPECT_FALSE(created);
+    cache->get(b, 10, 10, false, created);
+    EXPECT_TRUE(created);
+
+    // Too big to ever fit
+    EXPECT_EQ(nullptr, cache->get(c, 100, 100, false, created));
+
+    cache->remove(a);
+    cache->remove(b);
+    EXPECT_EQ(0u, cache->getCount());
+    EXPECT_EQ(0u, cache->getUsed());
+}
+
+TEST(RenderCacheTest, drawCached)
+{
+    FrontierApp* app = new TestApp();
+    app->init();
+
+    TestWidget* widget = new TestWidget(app, Size(20, 20));
+    widget->setRenderCacheEnabled(true);
+    widget->calculateSize();
+    widget->setSize(Size(20, 20));
+
+    Surface* surface = new Surface(20, 20, 4);
+
+    widget->drawCached(surface, Rect(0, 0, 20, 20));
+    EXPECT_EQ(1, widget->m_drawCount);
+    widget->clearDirty();
+
+    // Nothing has changed, so the cached Surface is used
+    widget->drawCached(surface, Rect(0, 0, 20, 20));
+    EXPECT_EQ(1, widget->m_drawCount);
+
+    widget->setDirty(DIRTY_CONTENT);
+    widget->drawCached(surface, Rect(0, 0, 20, 20));
+    EXPECT_EQ(2, widget->m_drawCount);
+    widget->clearDirty();
+
+    widget->setRenderCacheEnabled(false);
+    widget->clearDirty();
+    EXPECT_EQ(0u, app->getRenderCache()->getCount());
+    widget->drawCached(surface, Rect(0, 0, 20, 20));
+    EXPECT_EQ(3, widget->m_drawCount);
+
+    delete surface;
+}
+
+TEST(RenderCacheTest, nested)
+{
+    FrontierApp* app = new TestApp();
+    app->init();
+
+    Frame* parent = new Frame(app, true);
+    TestWidget* child = new TestWidget(app, Size(20, 20), 0xffff0000);
+    parent->add(child);
+    parent->setRenderCacheEnabled(true);
+    child->setRenderCacheEnabled(true);
+    parent->calculateSize();
+    parent->setSize(parent->getMinSize());
+    parent->layout();
+
+    // Either fits on its own, but not both together
+    RenderCache* cache = app->getRenderCache();
+    unsigned int parentSize = parent->getWidth() * parent->getHeight() * 4;
+    cache->setBudget(parentSize + (20 * 20 * 4) - 4);
+
+    // The child can't evict the parent while it's drawing, so it's drawn without caching
+    Surface* surface = new Surface(parent->getWidth(), parent->getHeight(), 4);
+    EXPECT_TRUE(parent->drawCached(surface, Rect(0, 0, parent->getWidth(), parent->getHeight())));
+    EXPECT_EQ(1, child->m_drawCount);
+    EXPECT_EQ(1u, cache->getCount());
+
+    Geek::Vector2D pos = child->getAbsolutePosition();
+    EXPECT_EQ(0xffff0000, getSurfacePixel(surface, pos.x + 1, pos.y + 1));
+
+    bool created;
+    cache->get(parent, parent->getWidth(), parent->getHeight(), false, created);
+    EXPECT_FALSE(created);
+
+    delete surface;
+}
@@ -0,0 +1,158 @@
+
+#include "testCommon.h"
+
+#include <frontier/widgets/scroller.h>
+#include <frontier/widgets/frame.h>
+
+#include <algorithm>
+
+using namespace Frontier;
+using namespace Geek::Gfx;
+using namespace std;
+
+TEST(ScrollerTest, blitScrolling)
+{
+    FrontierApp* app = new TestApp();
+    app->init();
+
+    TestWidget* child = new TestWidget(app, Size(80, 1000));
+    Scroller* scroller = new Scroller(app, child);
+    scroller->calculateSize();
+    scroller->setSize(Size(100, 100));
+    scroller->layout();
+
+    Surface* surface = new Surface(100, 100, 4);
+
+    scroller->draw(surface);
+    ASSERT_EQ(1u, child->m_drawn.size());
+    Rect visible = child->m_drawn.back();
+    EXPECT_EQ(0, visible.x);
+    EXPECT_EQ(0, visible.y);
+    EXPECT_LT(0, visible.height);
+    int height = visible.height;
+    scroller->clearDirty();
+
+    // Nothing has changed
+    scroller->draw(surface);
+    EXPECT_EQ(1u, child->m_drawn.size());
+
+    // Only the newly exposed strip is drawn
+    scroller->setPos(10);
+    scroller->draw(surface);
+    ASSERT_EQ(2u, child->m_drawn.size());
+    EXPECT_TRUE(child->m_drawn.back() == Rect(0, height, visible.width, 10));
+    scroller->clearDirty();
+
+    scroller->setPos(5);
+    scroller->draw(surface);
+    ASSERT_EQ(3u, child->m_drawn.size());
+    EXPECT_TRUE(child->m_drawn.back() == Rect(0, 5, visible.width, 5));
+    scroller->clearDirty();
+
+    // Scrolling further than the visible area redraws it all
+    scroller->setPos(500);
+    scroller->draw(surface);
+    ASSERT_EQ(4u, child->m_drawn.size());
+    EXPECT_TRUE(child->m_drawn.back() == Rect(0, 500, visible.width, height));
+    scroller->clearDirty();
+
+    delete surface;
+}
+
+TEST(ScrollerTest, scrollingFrame)
+{
+    FrontierApp* app = new TestApp();
+    app->init();
+
+    Frame* frame = new Frame(app, false);
+    vector<TestWidget*> rows;
+    for (int i = 0; i < 100; i++)
+    {
+        TestWidget* row = new TestWidget(app, Size(10, 10), Size(80, 10));
+        frame->add(row);
+        rows.push_back(row);
+    }
+
+    Scroller* scroller = new Scroller(app, frame);
+    scroller->calculateSize();
+    scroller->setSize(Size(100, 100));
+    scroller->layout();
+
+    Surface* surface = new Surface(100, 100, 4);
+
+    // Only the rows in view are drawn
+    scroller->draw(surface);
+    int drawn = 0;
+    for (TestWidget* row : rows)
+    {
+        drawn += row->m_drawCount;
+    }
+    EXPECT_LT(0, drawn);
+    EXPECT_GT(20, drawn);
+    EXPECT_EQ(0, rows.back()->m_drawCount);
+    scroller->clearDirty();
+
+    for (TestWidget* row : rows)
+    {
+        row->m_drawCount = 0;
+    }
+
+    // Only the rows in the newly exposed strip are drawn
+    scroller->setPos(10);
+    scroller->draw(surface);
+    drawn = 0;
+    for (TestWidget* row : rows)
+    {
+        drawn += row->m_drawCount;
+    }
+    EXPECT_LT(0, drawn);
+    EXPECT_GE(3, drawn);
+    EXPECT_EQ(0, rows.front()->m_drawCount);
+    EXPECT_EQ(0, rows.back()->m_drawCount);
+    scroller->clearDirty();
+
+    delete surface;
+}
+
+TEST(ScrollerTest, clearStrips)
+{
+    FrontierApp* app = new TestApp();
+    app->init();
+
+    TestWidget* child = new TestWidget(app, Size(80, 1000), 0xffff0000);
+    Scroller* scroller = new Scroller(app, child);
+    scroller->calculateSize();
+    scroller->setSize(Size(100, 100));
+    scroller->layout();
+
+    Surface* surface = new Surface(100, 100, 4);
+    scroller->draw(surface);
+    scroller->clearDirty();
+    ASSERT_EQ(1u, child->m_drawn.size());
+    Rect visible = child->m_drawn.back();
+    int redWidth = min(child->getWidth(), visible.width);
+
+    // The child doesn't draw anything in the newly exposed strip, so it must be empty
+    child->m_colour = 0;
+    scroller->setPos(10);
+    surface->clear(0xff00ff00);
+    scroller->draw(surface);
+    scroller->clearDirty();
+
+    int red = 0;
+    int x;
+    int y;
+    for (y = 0; y < 100; y++)
+    {
+        for (x = 0; x < 100; x++)
+        {
+            if (getSurfacePixel(surface, x, y) == 0xffff0000)
+            {
+                red++;
+            }
+        }
+    }
+    EXPECT_EQ(redWidth * (visible.height - 10), red);
+
+    delete surface;
+}
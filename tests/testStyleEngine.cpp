@@ -186,3 +186,167 @@ TEST(StyleEngineTest, wildcard)
     EXPECT_EQ(0xffff0000, it->second.asInt());
 }
 
+
+TEST(StyleEngineTest, indexedBuckets)
+{
+    bool res;
+    StyleEngine* se = new StyleEngine();
+    res = se->parseString(
+        "WidgetA { margin-top: 1px; }\n"
+        ".big { margin-top: 2px; }\n"
+        "#special { margin-top: 3px; }\n"
+        "WidgetB { margin-top: 4px; }\n");
+    EXPECT_EQ(true, res);
+    EXPECT_EQ(4u, se->getRuleCount());
+
+    FrontierApp* app = new TestApp();
+
+    Widget* a = new Widget(app, L"WidgetA");
+    EXPECT_EQ(1, se->getProperties(a).at("margin-top").asInt());
+
+    a->setWidgetClass(L"big");
+    EXPECT_EQ(2, se->getProperties(a).at("margin-top").asInt());
+
+    a->setWidgetId(L"special");
+    EXPECT_EQ(3, se->getProperties(a).at("margin-top").asInt());
+
+    Widget* c = new Widget(app, L"WidgetC");
+    EXPECT_EQ(0, se->getProperties(c).size());
+}
+
+TEST(StyleEngineTest, indexedCascadeOrder)
+{
+    bool res;
+    StyleEngine* se = new StyleEngine();
+
+    // The more specific rule must win even though it is in a different bucket and declared first
+    res = se->parseString(
+        "WidgetA { background-color: #00ff00; }\n"
+        "* { background-color: #ff0000; }\n");
+    EXPECT_EQ(true, res);
+
+    FrontierApp* app = new TestApp();
+
+    Widget* a = new Widget(app, L"WidgetA");
+    unordered_map<string, Value> props = se->getProperties(a);
+    EXPECT_EQ(1, props.size());
+    EXPECT_EQ(0xff00ff00, props.at("background-color").asInt());
+
+    a->setStyle("background-color", Value((int64_t)0xff0000ff));
+    props = se->getProperties(a);
+    EXPECT_EQ(0xff0000ff, props.at("background-color").asInt());
+}
+
+TEST(StyleEngineTest, sharedComputedStyle)
+{
+    bool res;
+    StyleEngine* se = new StyleEngine();
+    res = se->parseString(
+        ".group1 WidgetA { margin-top: 1px; }\n"
+        ".big { margin-left: 2px; }\n");
+    EXPECT_EQ(true, res);
+
+    FrontierApp* app = new TestApp();
+
+    Widget* group1 = new Widget(app, L"Group");
+    group1->setWidgetClass(L"group1");
+
+    Widget* a1 = new Widget(app, L"WidgetA");
+    a1->setParent(group1);
+    Widget* a2 = new Widget(app, L"WidgetA");
+    a2->setParent(group1);
+
+    // Identical Widgets share the same style
+    ComputedStyle* style1 = se->getComputedStyle(a1);
+    ComputedStyle* style2 = se->getComputedStyle(a2);
+    EXPECT_EQ(style1, style2);
+    EXPECT_EQ(1, style1->get(STYLE_MARGIN_TOP).asInt());
+    EXPECT_EQ(1u, se->getStyleCacheSize());
+
+    // Ancestors are part of the signature
+    Widget* a3 = new Widget(app, L"WidgetA");
+    ComputedStyle* style3 = se->getComputedStyle(a3);
+    EXPECT_NE(style1, style3);
+    EXPECT_EQ(0, style3->size());
+
+    // As are classes
+    a2->setWidgetClass(L"big");
+    ComputedStyle* style4 = se->getComputedStyle(a2);
+    EXPECT_NE(style1, style4);
+    EXPECT_EQ(2, style4->get(STYLE_MARGIN_LEFT).asInt());
+
+    // Styles set directly on a Widget are never shared
+    a1->setStyle("margin-top", Value(5));
+    ComputedStyle* style5 = se->getComputedStyle(a1);
+    EXPECT_NE(style1, style5);
+    EXPECT_EQ(5, style5->get(STYLE_MARGIN_TOP).asInt());
+
+    style1->release();
+    style2->release();
+    style3->release();
+    style4->release();
+    style5->release();
+}
+
+TEST(StyleEngineTest, internedProperties)
+{
+    EXPECT_EQ(STYLE_MARGIN_TOP, findStyleProperty("margin-top"));
+    EXPECT_STREQ("margin-top", getStylePropertyName(STYLE_MARGIN_TOP));
+    EXPECT_EQ(STYLE_PROPERTY_UNKNOWN, findStyleProperty("not-a-property"));
+
+    // Everything the shortcut properties expand to must have an id
+    StyleRule rule;
+    rule.applyProperty("border", Value(1));
+    rule.applyProperty("border-color", Value(5));
+    rule.applyProperty("margin", Value(2));
+    rule.applyProperty("padding", Value(3));
+    EXPECT_EQ(16, rule.getProperties().size());
+    for (const auto& prop : rule.getProperties())
+    {
+        EXPECT_NE(STYLE_PROPERTY_UNKNOWN, findStyleProperty(prop.first)) << prop.first;
+    }
+
+    // Unknown properties are still available
+    rule.setProperty("not-a-property", Value(4));
+    ComputedStyle* style = new ComputedStyle(rule.getProperties());
+    style->incRefCount();
+    EXPECT_TRUE(style->has(STYLE_BORDER_LEFT_COLOR));
+    EXPECT_EQ(2, style->get(STYLE_MARGIN_LEFT).asInt());
+    EXPECT_EQ(3, style->get("padding-bottom").asInt());
+    EXPECT_TRUE(style->has("not-a-property"));
+    EXPECT_EQ(4, style->get("not-a-property").asInt());
+    EXPECT_FALSE(style->has(STYLE_FONT_SIZE));
+    EXPECT_EQ(17, style->size());
+    style->release();
+}
+
+TEST(StyleEngineTest, stateInvalidation)
+{
+    bool res;
+    StyleEngine* se = new StyleEngine();
+    res = se->parseString(
+        "WidgetA:hover { margin-top: 1px; }\n"
+        ".group1:active WidgetB { margin-top: 2px; }\n"
+        ".big { margin-top: 3px; }\n");
+    EXPECT_EQ(true, res);
+
+    FrontierApp* app = new TestApp();
+
+    Widget* a = new Widget(app, L"WidgetA");
+    Widget* b = new Widget(app, L"WidgetB");
+    Widget* group1 = new Widget(app, L"Group");
+    group1->setWidgetClass(L"group1");
+
+    // Only rules that could match the Widget matter
+    EXPECT_EQ(STYLE_INVALIDATE_SELF, se->getStateInvalidation(a, STYLE_STATE_HOVER));
+    EXPECT_EQ(STYLE_INVALIDATE_NONE, se->getStateInvalidation(a, STYLE_STATE_ACTIVE | STYLE_STATE_SELECTED));
+    EXPECT_EQ(STYLE_INVALIDATE_NONE, se->getStateInvalidation(b, STYLE_STATE_HOVER));
+
+    // A state on an ancestor selector affects the descendants
+    EXPECT_EQ(STYLE_INVALIDATE_DESCENDANTS, se->getStateInvalidation(group1, STYLE_STATE_ACTIVE));
+    EXPECT_EQ(STYLE_INVALIDATE_NONE, se->getStateInvalidation(group1, STYLE_STATE_HOVER));
+
+    EXPECT_EQ(STYLE_INVALIDATE_SELF, se->getClassInvalidation(L"big"));
+    EXPECT_EQ(STYLE_INVALIDATE_DESCENDANTS, se->getClassInvalidation(L"group1"));
+    EXPECT_EQ(STYLE_INVALIDATE_NONE, se->getClassInvalidation(L"unused"));
+}
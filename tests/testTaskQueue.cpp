@@ -0,0 +1,91 @@
+
+#include "testCommon.h"
+
+#include <frontier/taskqueue.h>
+
+#include <thread>
+
+using namespace Frontier;
+using namespace std;
+
+TEST(TaskQueueTest, order)
+{
+    TaskQueue queue;
+    EXPECT_TRUE(queue.isEmpty());
+
+    vector<int> results;
+    EXPECT_TRUE(queue.post([&results]() { results.push_back(1); }));
+    EXPECT_FALSE(queue.post([&results]() { results.push_back(2); }));
+
+    // A batch keeps its order, and goes after what was already posted
+    vector<Task> batch;
+    batch.push_back([&results]() { results.push_back(3); });
+    batch.push_back([&results]() { results.push_back(4); });
+    EXPECT_FALSE(queue.post(batch));
+    EXPECT_TRUE(batch.empty());
+
+    EXPECT_EQ(4, queue.run());
+    EXPECT_TRUE(queue.isEmpty());
+    ASSERT_EQ(4, results.size());
+    EXPECT_EQ(1, results[0]);
+    EXPECT_EQ(2, results[1]);
+    EXPECT_EQ(3, results[2]);
+    EXPECT_EQ(4, results[3]);
+
+    // Tasks posted while running are left for the next run
+    results.clear();
+    queue.post([&queue, &results]()
+    {
+        results.push_back(5);
+        queue.post([&results]() { results.push_back(6); });
+    });
+    EXPECT_EQ(1, queue.run());
+    EXPECT_EQ(1, queue.run());
+    ASSERT_EQ(2, results.size());
+    EXPECT_EQ(6, results[1]);
+}
+
+TEST(TaskQueueTest, producers)
+{
+    TaskQueue queue;
+
+    const int producerCount = 4;
+    const int taskCount = 10000;
+    vector<int> last(producerCount, -1);
+    int outOfOrder = 0;
+    int total = 0;
+
+    vector<thread> producers;
+    int p;
+    for (p = 0; p < producerCount; p++)
+    {
+        producers.emplace_back([&queue, &last, &outOfOrder, p, taskCount]()
+        {
+            int i;
+            for (i = 0; i < taskCount; i++)
+            {
+                queue.post([&last, &outOfOrder, p, i]()
+                {
+                    if (last[p] != i - 1)
+                    {
+                        outOfOrder++;
+                    }
+                    last[p] = i;
+                });
+            }
+        });
+    }
+
+    while (total < producerCount * taskCount)
+    {
+        total += queue.run();
+    }
+    for (thread& producer : producers)
+    {
+        producer.join();
+    }
+
+    EXPECT_EQ(producerCount * taskCount, total);
+    EXPECT_EQ(0, outOfOrder);
+    EXPECT_TRUE(queue.isEmpty());
+}
@@ -0,0 +1,124 @@
+#include "testCommon.h"
+
+#include <frontier/widgets/terminal.h>
+#include <frontier/engines/offscreen.h>
+
+#include <string.h>
+
+using namespace Frontier;
+using namespace Geek::Gfx;
+using namespace std;
+
+TEST(TerminalTest, scrollback)
+{
+    FrontierApp* app = new TestApp();
+    app->init();
+
+    Terminal* terminal = new Terminal(app);
+    EXPECT_EQ((unsigned int)TERMINAL_DEFAULT_SCROLLBACK, terminal->getScrollback());
+    EXPECT_EQ(0u, terminal->getLineCount());
+
+    terminal->setScrollback(10);
+    EXPECT_EQ(10u, terminal->getScrollback());
+
+    char line[] = "hello\r\n";
+    int i;
+    for (i = 0; i < 5; i++)
+    {
+        terminal->receiveChars(line, strlen(line));
+    }
+    EXPECT_EQ(6u, terminal->getLineCount());
+
+    // Old lines are dropped once the limit has been reached
+    for (i = 0; i < 100; i++)
+    {
+        terminal->receiveChars(line, strlen(line));
+    }
+    EXPECT_EQ(10u, terminal->getLineCount());
+
+    // Characters past the last column are dropped
+    string longLine(TERMINAL_MAX_COLUMNS + 50, 'a');
+    longLine += "\r\n";
+    terminal->receiveChars(&longLine[0], longLine.length());
+    EXPECT_EQ(10u, terminal->getLineCount());
+
+    terminal->calculateSize();
+    terminal->setSize(Size(200, 100));
+    Surface* surface = new Surface(200, 100, 4);
+    EXPECT_TRUE(terminal->draw(surface));
+
+    delete surface;
+    delete terminal;
+    delete app;
+}
+
+TEST(TerminalTest, dirtyRows)
+{
+    FrontierApp* app = new TestApp();
+    app->init();
+
+    Terminal* terminal = new Terminal(app);
+    char lines[] = "one\r\ntwo\r\nthree\r\n";
+    terminal->receiveChars(lines, strlen(lines));
+
+    terminal->calculateSize();
+    terminal->setSize(Size(200, 200));
+    Surface* surface = new Surface(200, 200, 4);
+    EXPECT_TRUE(terminal->draw(surface));
+    terminal->clearDirty();
+
+    // Mark an unchanged row and the row that is about to change
+    int fontHeight = app->getTheme()->getMonospaceHeight();
+    uint32_t* pixels = (uint32_t*)surface->getData();
+    uint32_t marker = 0xff123456;
+    pixels[199] = marker;
+    pixels[(3 * fontHeight) * 200 + 199] = marker;
+
+    // Only the changed row is redrawn
+    char c[] = "x";
+    terminal->receiveChars(c, strlen(c));
+    EXPECT_TRUE(terminal->draw(surface));
+    EXPECT_EQ(marker, pixels[199]);
+    EXPECT_NE(marker, pixels[(3 * fontHeight) * 200 + 199]);
+
+    delete surface;
+    delete terminal;
+    delete app;
+}
+
+TEST(TerminalTest, coalesceUpdates)
+{
+    OffscreenApp* app = new OffscreenApp();
+    ASSERT_TRUE(app->init());
+
+    FrontierWindow* window = new FrontierWindow(app, L"Terminal", WINDOW_NORMAL);
+    Terminal* terminal = new Terminal(app);
+    window->setContent(terminal);
+    window->show();
+
+    OffscreenWindow* ow = app->m_offscreenEngine->getWindow(window);
+    ASSERT_NE(nullptr, ow);
+    ow->takeUpdateRequest();
+
+    // A burst of output asks for one update
+    char line[] = "hello\r\n";
+    int i;
+    for (i = 0; i < 50; i++)
+    {
+        terminal->receiveChars(line, strlen(line));
+    }
+    EXPECT_TRUE(ow->takeUpdateRequest());
+
+    // More output before the Terminal has been drawn doesn't ask again
+    terminal->receiveChars(line, strlen(line));
+    EXPECT_FALSE(ow->takeUpdateRequest());
+
+    // Once it has been drawn, the next output does
+    window->update();
+    terminal->receiveChars(line, strlen(line));
+    EXPECT_TRUE(ow->takeUpdateRequest());
+
+    window->hide();
+    window->decRefCount();
+    delete app;
+}